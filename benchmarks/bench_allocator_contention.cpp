@@ -0,0 +1,374 @@
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <benchmark/benchmark.h>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/typed_memory_arena.hpp>
+#include "bench_support.hpp"
+
+// Multithreaded allocator workloads, run at 1-64 threads:
+//
+//   ThreadLocalChurn  - each thread allocates a batch of mixed-size blocks from its own
+//                       allocator and frees them all (an arena resets instead).
+//   SharedArena       - the same churn, but every thread uses one shared allocator.
+//                       Batches end at a barrier, after which one thread calls
+//                       end_batch, so an arena is only reset once no block is live.
+//   ProducerConsumer  - even threads allocate and hand blocks to their odd neighbour,
+//                       which frees them: every free is a cross-thread free.
+//
+// Each run reports items_per_second (allocations, or frees for consumers), p99_ns
+// (per-thread p99 of single allocate/free calls, timed with op_clock like the
+// latency benchmarks and averaged over threads) and the process RSS after the run.
+
+static constexpr std::size_t BATCH_SIZE     = 256;
+static constexpr std::size_t MIN_BLOCK_SIZE = 16;
+static constexpr std::size_t SAMPLE_EVERY   = 8; // time the calls of one batch in SAMPLE_EVERY
+
+// skewed towards small blocks, like typical message and node allocations
+static std::vector<std::size_t> make_sizes(std::uint64_t seed)
+{
+    std::mt19937_64          rng(seed);
+    std::vector<std::size_t> sizes(BATCH_SIZE);
+    for (auto& size : sizes) {
+        std::size_t shift = rng() % 6; // 16..512
+        size              = (MIN_BLOCK_SIZE << shift) - rng() % (MIN_BLOCK_SIZE << shift) / 2;
+    }
+    return sizes;
+}
+
+// ---------------------------------------------------------------------------------
+// allocators: allocate(size), deallocate(ptr, size) and end_batch()
+//
+// allocate() writes to the block itself, as a caller would.
+
+static void* touch(void* p)
+{
+    static_cast<volatile std::byte*>(p)[0] = std::byte{1};
+    return p;
+}
+
+struct new_delete_allocator
+{
+    void* allocate(std::size_t size) { return touch(::operator new(size)); }
+    void  deallocate(void* p, std::size_t size) { ::operator delete(p, size); }
+    void  end_batch() {}
+};
+
+template <typename Resource>
+struct pmr_allocator
+{
+    void* allocate(std::size_t size) { return touch(resource.allocate(size, alignof(std::max_align_t))); }
+    void  deallocate(void* p, std::size_t size) { resource.deallocate(p, size, alignof(std::max_align_t)); }
+    void  end_batch() {}
+
+    Resource resource;
+};
+
+// bump allocation; the whole batch is released by one reset
+struct paged_arena_allocator
+{
+    void* allocate(std::size_t size) { return touch(arena.allocate(size)); }
+    void  deallocate(void*, std::size_t) {}
+    void  end_batch() { arena.reset(); }
+
+    apus::paged_memory_arena<64 * 1024> arena;
+};
+
+// size-class pool over typed_memory_arena free lists (16, 32, ... 512 bytes)
+class size_class_pool
+{
+    template <std::size_t Size>
+    struct slot
+    {
+        std::size_t                           index; // typed_memory_arena index, to free by pointer
+        alignas(std::max_align_t) std::byte data[Size];
+    };
+
+    template <std::size_t Size>
+    struct size_class
+    {
+        void* allocate()
+        {
+            auto result       = arena.allocate();
+            result.ptr->index = result.index;
+            return touch(result.ptr->data);
+        }
+
+        void deallocate(void* p)
+        {
+            auto* s = reinterpret_cast<slot<Size>*>(static_cast<std::byte*>(p) - offsetof(slot<Size>, data));
+            arena.deallocate(s->index);
+        }
+
+        apus::typed_memory_arena<slot<Size>, 1024> arena;
+    };
+
+public:
+    void* allocate(std::size_t size)
+    {
+        if (size <= 16) return c16_.allocate();
+        if (size <= 32) return c32_.allocate();
+        if (size <= 64) return c64_.allocate();
+        if (size <= 128) return c128_.allocate();
+        if (size <= 256) return c256_.allocate();
+        return c512_.allocate();
+    }
+
+    void deallocate(void* p, std::size_t size)
+    {
+        if (size <= 16) return c16_.deallocate(p);
+        if (size <= 32) return c32_.deallocate(p);
+        if (size <= 64) return c64_.deallocate(p);
+        if (size <= 128) return c128_.deallocate(p);
+        if (size <= 256) return c256_.deallocate(p);
+        c512_.deallocate(p);
+    }
+
+    void end_batch() {}
+
+private:
+    size_class<16>  c16_;
+    size_class<32>  c32_;
+    size_class<64>  c64_;
+    size_class<128> c128_;
+    size_class<256> c256_;
+    size_class<512> c512_;
+};
+
+// serializes a single-threaded allocator for sharing
+template <typename Allocator>
+struct locked_allocator
+{
+    void* allocate(std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return inner.allocate(size);
+    }
+
+    void deallocate(void* p, std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        inner.deallocate(p, size);
+    }
+
+    void end_batch()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        inner.end_batch();
+    }
+
+    std::mutex mutex;
+    Allocator  inner;
+};
+
+// where each thread gets its allocator from
+template <typename Allocator>
+struct thread_local_instance
+{
+    static constexpr bool shared = false;
+
+    static Allocator& get()
+    {
+        thread_local Allocator allocator;
+        return allocator;
+    }
+};
+
+template <typename Allocator>
+struct shared_instance
+{
+    static constexpr bool shared = true;
+
+    static Allocator& get()
+    {
+        static Allocator allocator;
+        return allocator;
+    }
+};
+
+// reusable barrier; every benchmark thread runs the same number of iterations
+class batch_barrier
+{
+public:
+    void wait(std::size_t threads)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::uint64_t                generation = generation_;
+        if (++arrived_ == threads) {
+            arrived_ = 0;
+            ++generation_;
+            cv_.notify_all();
+        } else {
+            cv_.wait(lock, [&] { return generation_ != generation; });
+        }
+    }
+
+private:
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    std::size_t             arrived_    = 0;
+    std::uint64_t           generation_ = 0;
+};
+
+static void report(benchmark::State& state, const apus_bench::latency_histogram& latencies, std::size_t ops)
+{
+    state.SetItemsProcessed(static_cast<std::int64_t>(ops));
+    state.counters["p99_ns"] = benchmark::Counter(apus_bench::op_clock::to_ns(latencies.percentile(99)), benchmark::Counter::kAvgThreads);
+    if (state.thread_index() == 0) {
+        state.counters["rss_mb"]      = static_cast<double>(apus_bench::current_rss_bytes()) / (1 << 20);
+        state.counters["peak_rss_mb"] = static_cast<double>(apus_bench::peak_rss_bytes()) / (1 << 20);
+    }
+}
+
+// ---------------------------------------------------------------------------------
+// ThreadLocalChurn / SharedArena
+
+template <typename Instance>
+static void BM_Churn(benchmark::State& state)
+{
+    auto&                         allocator = Instance::get();
+    auto                          sizes     = make_sizes(static_cast<std::uint64_t>(state.thread_index()) + 1);
+    std::array<void*, BATCH_SIZE> blocks;
+    apus_bench::latency_histogram latencies;
+    std::size_t                   batch = 0;
+
+    for (auto _ : state) {
+        bool sample = ++batch % SAMPLE_EVERY == 0;
+        for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+            if (sample) {
+                std::uint64_t start = apus_bench::op_clock::now();
+                blocks[i]           = allocator.allocate(sizes[i]);
+                latencies.record(apus_bench::op_clock::now() - start);
+            } else {
+                blocks[i] = allocator.allocate(sizes[i]);
+            }
+        }
+        for (std::size_t i = BATCH_SIZE; i-- > 0;) {
+            allocator.deallocate(blocks[i], sizes[i]);
+        }
+        if constexpr (Instance::shared) {
+            // the shared allocator ends a batch only when every thread has released its blocks
+            static batch_barrier barrier;
+            auto                 threads = static_cast<std::size_t>(state.threads());
+            barrier.wait(threads);
+            if (state.thread_index() == 0) allocator.end_batch();
+            barrier.wait(threads);
+        } else {
+            allocator.end_batch();
+        }
+    }
+    report(state, latencies, state.iterations() * BATCH_SIZE);
+}
+
+using sync_pool = pmr_allocator<std::pmr::synchronized_pool_resource>;
+
+BENCHMARK_TEMPLATE(BM_Churn, thread_local_instance<new_delete_allocator>)
+    ->Name("ThreadLocalChurn/NewDelete")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, thread_local_instance<pmr_allocator<std::pmr::unsynchronized_pool_resource>>)
+    ->Name("ThreadLocalChurn/PmrUnsynchronizedPool")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, thread_local_instance<paged_arena_allocator>)
+    ->Name("ThreadLocalChurn/ApusPagedArena")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, thread_local_instance<size_class_pool>)
+    ->Name("ThreadLocalChurn/ApusSizeClassPool")->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Churn, shared_instance<new_delete_allocator>)
+    ->Name("SharedArena/NewDelete")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, shared_instance<sync_pool>)
+    ->Name("SharedArena/PmrSynchronizedPool")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, shared_instance<locked_allocator<paged_arena_allocator>>)
+    ->Name("SharedArena/ApusPagedArenaLocked")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Churn, shared_instance<locked_allocator<size_class_pool>>)
+    ->Name("SharedArena/ApusSizeClassPoolLocked")->ThreadRange(1, 64)->UseRealTime();
+
+// ---------------------------------------------------------------------------------
+// ProducerConsumer
+
+struct block_ref
+{
+    void*       ptr;
+    std::size_t size;
+};
+
+struct channel
+{
+    std::mutex             mutex;
+    std::vector<block_ref> blocks;
+};
+
+static constexpr std::size_t CHANNEL_LIMIT = 1 << 16; // producers free their own blocks past this backlog
+
+template <typename Instance>
+static void BM_ProducerConsumer(benchmark::State& state)
+{
+    static std::array<channel, 64> channels;
+
+    auto&                         allocator = Instance::get();
+    auto                          sizes     = make_sizes(static_cast<std::uint64_t>(state.thread_index()) + 1);
+    int                           index     = state.thread_index();
+    bool                          paired    = (index | 1) < state.threads();
+    bool                          producer  = !paired || index % 2 == 0;
+    channel&                      chan      = channels[static_cast<std::size_t>(index / 2)];
+    std::vector<block_ref>        batch;
+    apus_bench::latency_histogram latencies;
+    std::size_t                   ops       = 0;
+    std::size_t                   round     = 0;
+
+    batch.reserve(CHANNEL_LIMIT);
+    for (auto _ : state) {
+        bool sample = ++round % SAMPLE_EVERY == 0;
+        if (producer) {
+            batch.clear();
+            for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+                std::uint64_t start = sample ? apus_bench::op_clock::now() : 0;
+                void*         p     = allocator.allocate(sizes[i]);
+                if (sample) latencies.record(apus_bench::op_clock::now() - start);
+                batch.push_back({p, sizes[i]});
+            }
+            ops += BATCH_SIZE;
+
+            bool handed_off = false;
+            if (paired) {
+                std::lock_guard<std::mutex> lock(chan.mutex);
+                if (chan.blocks.size() < CHANNEL_LIMIT) {
+                    chan.blocks.insert(chan.blocks.end(), batch.begin(), batch.end());
+                    handed_off = true;
+                }
+            }
+            if (!handed_off) {
+                for (auto& block : batch) allocator.deallocate(block.ptr, block.size);
+            }
+        } else {
+            batch.clear();
+            {
+                std::lock_guard<std::mutex> lock(chan.mutex);
+                batch.swap(chan.blocks);
+            }
+            for (auto& block : batch) {
+                std::uint64_t start = sample ? apus_bench::op_clock::now() : 0;
+                allocator.deallocate(block.ptr, block.size);
+                if (sample) latencies.record(apus_bench::op_clock::now() - start);
+            }
+            ops += batch.size();
+        }
+    }
+
+    // whoever finishes last frees the backlog
+    {
+        std::lock_guard<std::mutex> lock(chan.mutex);
+        for (auto& block : chan.blocks) allocator.deallocate(block.ptr, block.size);
+        chan.blocks.clear();
+    }
+    report(state, latencies, ops);
+}
+
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, shared_instance<new_delete_allocator>)
+    ->Name("ProducerConsumer/NewDelete")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, shared_instance<sync_pool>)
+    ->Name("ProducerConsumer/PmrSynchronizedPool")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, shared_instance<locked_allocator<size_class_pool>>)
+    ->Name("ProducerConsumer/ApusSizeClassPoolLocked")->ThreadRange(1, 64)->UseRealTime();
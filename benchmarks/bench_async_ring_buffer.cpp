@@ -0,0 +1,119 @@
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <condition_variable>
+#include <benchmark/benchmark.h>
+#include <apus/ring_buffer.hpp>
+#include <apus/async_ring_buffer.hpp>
+
+// Moves 1024 items through each of range(0) producer -> consumer pipelines, with a
+// queue capacity of 16: coroutines on one coroutine_executor versus a thread pair
+// per pipeline blocking on a condition variable around ring_buffer.
+
+static constexpr int PIPELINE_ITEMS    = 1024;
+static constexpr int PIPELINE_CAPACITY = 16;
+
+static apus::detached_task produce(apus::async_ring_buffer<std::uint64_t>& queue)
+{
+    for (int i = 0; i < PIPELINE_ITEMS; ++i) {
+        co_await queue.push(static_cast<std::uint64_t>(i));
+    }
+    queue.close();
+}
+
+static apus::detached_task consume(apus::async_ring_buffer<std::uint64_t>& queue, std::uint64_t& sum)
+{
+    while (std::optional<std::uint64_t> value = co_await queue.pop()) {
+        sum += *value;
+    }
+}
+
+static void BM_AsyncRingBuffer_Pipelines(benchmark::State& state)
+{
+    const auto pipelines = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        apus::coroutine_executor                                             executor(2 * pipelines);
+        std::vector<std::unique_ptr<apus::async_ring_buffer<std::uint64_t>>> queues;
+        std::vector<std::uint64_t>                                           sums(pipelines, 0);
+        for (std::size_t p = 0; p < pipelines; ++p) {
+            queues.push_back(std::make_unique<apus::async_ring_buffer<std::uint64_t>>(PIPELINE_CAPACITY));
+            executor.spawn(produce(*queues.back()));
+            executor.spawn(consume(*queues.back(), sums[p]));
+        }
+        executor.run();
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.SetItemsProcessed(state.iterations() * pipelines * PIPELINE_ITEMS);
+}
+BENCHMARK(BM_AsyncRingBuffer_Pipelines)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+namespace
+{
+    // the blocking queue async_ring_buffer replaces
+    class blocking_queue
+    {
+    public:
+        explicit blocking_queue(std::size_t capacity) : buffer_(capacity) {}
+
+        void push(std::uint64_t value)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [&] { return !buffer_.full(); });
+            buffer_.push_back(value);
+            not_empty_.notify_one();
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+        std::optional<std::uint64_t> pop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [&] { return !buffer_.empty() || closed_; });
+            if (buffer_.empty()) return std::nullopt;
+            std::uint64_t value = buffer_.front();
+            buffer_.pop_front();
+            not_full_.notify_one();
+            return value;
+        }
+
+    private:
+        apus::ring_buffer<std::uint64_t> buffer_;
+        std::mutex                       mutex_;
+        std::condition_variable          not_full_;
+        std::condition_variable          not_empty_;
+        bool                             closed_ = false;
+    };
+} // namespace
+
+static void BM_BlockingRingBuffer_Pipelines(benchmark::State& state)
+{
+    const auto pipelines = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<blocking_queue>> queues;
+        std::vector<std::uint64_t>                   sums(pipelines, 0);
+        std::vector<std::thread>                     threads;
+        for (std::size_t p = 0; p < pipelines; ++p) {
+            queues.push_back(std::make_unique<blocking_queue>(PIPELINE_CAPACITY));
+            blocking_queue& queue = *queues.back();
+            threads.emplace_back([&queue] {
+                for (int i = 0; i < PIPELINE_ITEMS; ++i) queue.push(static_cast<std::uint64_t>(i));
+                queue.close();
+            });
+            threads.emplace_back([&queue, &sum = sums[p]] {
+                while (std::optional<std::uint64_t> value = queue.pop()) sum += *value;
+            });
+        }
+        for (auto& t : threads) t.join();
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.SetItemsProcessed(state.iterations() * pipelines * PIPELINE_ITEMS);
+}
+BENCHMARK(BM_BlockingRingBuffer_Pipelines)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
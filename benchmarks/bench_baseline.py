@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""Records named benchmark baselines and checks new runs against them.
+
+    bench_baseline.py record NAME --binary build/apus_benchmarks [--repetitions 10] [--filter RE]
+    bench_baseline.py compare BASELINE CONTENDER [--threshold 5] [--alpha 0.05]
+    bench_baseline.py check BASELINE --binary build/apus_benchmarks [--threshold 5]
+    bench_baseline.py list
+
+A baseline is the Google Benchmark JSON output of a run with repetitions, with machine
+metadata added to its "context", stored as <dir>/<NAME>.json (--dir, default
+build/baselines). BASELINE and CONTENDER are stored names or paths to JSON files.
+
+For every benchmark present in both runs, the per-repetition times are compared with
+a two-sided Mann-Whitney U test. A benchmark regresses when its median time grew by
+more than --threshold percent and the difference is significant at --alpha; compare
+and check then exit with status 1. Everything runs offline on local files, using only
+the Python standard library.
+"""
+
+import argparse
+import datetime
+import json
+import math
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def machine_metadata():
+    """Metadata Google Benchmark does not record itself."""
+    meta = {
+        "apus_recorded_at": datetime.datetime.now(datetime.timezone.utc).isoformat(timespec="seconds"),
+        "apus_platform": platform.platform(),
+        "apus_machine": platform.machine(),
+        "apus_python": platform.python_version(),
+    }
+    try:
+        with open("/proc/cpuinfo") as cpuinfo:
+            for line in cpuinfo:
+                if line.startswith("model name"):
+                    meta["apus_cpu_model"] = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+    try:
+        revision = subprocess.run(["git", "rev-parse", "HEAD"], capture_output=True, text=True,
+                                  cwd=os.path.dirname(os.path.abspath(__file__)), check=True)
+        meta["apus_git_revision"] = revision.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        pass
+    return meta
+
+
+def run_benchmarks(binary, repetitions, bench_filter, min_time):
+    """Runs a benchmark binary and returns its JSON output with metadata added."""
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, "run.json")
+        command = [binary,
+                   "--benchmark_out=" + out,
+                   "--benchmark_out_format=json",
+                   "--benchmark_repetitions=%d" % repetitions,
+                   "--benchmark_filter=" + bench_filter]
+        if min_time:
+            command.append("--benchmark_min_time=" + min_time)
+        subprocess.run(command, check=True)
+        with open(out) as f:
+            result = json.load(f)
+    result.setdefault("context", {}).update(machine_metadata())
+    return result
+
+
+def baseline_path(directory, name):
+    if name.endswith(".json") or os.sep in name:
+        return name
+    return os.path.join(directory, name + ".json")
+
+
+def load(directory, name):
+    path = baseline_path(directory, name)
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except FileNotFoundError:
+        sys.exit("bench_baseline: no baseline '%s' (looked for %s)" % (name, path))
+
+
+def save(directory, name, result):
+    path = baseline_path(directory, name)
+    os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(result, f, indent=2)
+    return path
+
+
+def samples(result, metric):
+    """Maps each benchmark name to its per-repetition times in nanoseconds."""
+    times = {}
+    for bench in result.get("benchmarks", []):
+        if bench.get("run_type", "iteration") != "iteration" or metric not in bench:
+            continue
+        name = bench.get("run_name", bench["name"])
+        scale = TIME_UNIT_NS.get(bench.get("time_unit", "ns"), 1.0)
+        times.setdefault(name, []).append(bench[metric] * scale)
+    return times
+
+
+def mann_whitney_u(xs, ys):
+    """Two-sided Mann-Whitney U test; returns (U of xs, p-value).
+
+    The p-value is exact for small samples without ties and otherwise uses the normal
+    approximation with tie and continuity corrections.
+    """
+    n1, n2 = len(xs), len(ys)
+    ranked = sorted([(v, 0) for v in xs] + [(v, 1) for v in ys])
+    ranks = [0.0] * len(ranked)
+    tie_term = 0.0
+    i = 0
+    while i < len(ranked):
+        j = i
+        while j + 1 < len(ranked) and ranked[j + 1][0] == ranked[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        tie_term += (j - i + 1) ** 3 - (j - i + 1)
+        i = j + 1
+    r1 = sum(rank for rank, (_, group) in zip(ranks, ranked) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    u = min(u1, n1 * n2 - u1)
+
+    if tie_term == 0 and n1 <= 20 and n2 <= 20:
+        # counts[k]: number of arrangements with U == k, built up one element at a time
+        counts = _u_distribution(n1, n2)
+        total = sum(counts)
+        p = 2.0 * sum(counts[: int(u) + 1]) / total
+        return u1, min(p, 1.0)
+
+    n = n1 + n2
+    sigma = math.sqrt(n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1))))
+    if sigma == 0:
+        return u1, 1.0
+    z = (abs(u1 - n1 * n2 / 2.0) - 0.5) / sigma
+    return u1, min(math.erfc(max(z, 0.0) / math.sqrt(2.0)), 1.0)
+
+
+def _u_distribution(n1, n2):
+    # f[i][j][k]: arrangements of i xs and j ys with U == k
+    f = [[None] * (n2 + 1) for _ in range(n1 + 1)]
+    for i in range(n1 + 1):
+        for j in range(n2 + 1):
+            if i == 0 or j == 0:
+                f[i][j] = [1]
+                continue
+            # the largest value is either an x (beating all j ys) or a y
+            with_x, with_y = f[i - 1][j], f[i][j - 1]
+            dist = [0] * (i * j + 1)
+            for k, c in enumerate(with_x):
+                dist[k + j] += c
+            for k, c in enumerate(with_y):
+                dist[k] += c
+            f[i][j] = dist
+    return f[n1][n2]
+
+
+def compare(baseline, contender, metric, threshold, alpha):
+    """Prints a comparison table; returns the number of regressions."""
+    base, cont = samples(baseline, metric), samples(contender, metric)
+    common = [name for name in base if name in cont]
+    width = max([len(name) for name in common] + [9])
+
+    print("%-*s %14s %14s %9s %9s  %s" % (width, "benchmark", "baseline ns", "contender ns", "change", "p", "verdict"))
+    regressions = 0
+    for name in common:
+        xs, ys = base[name], cont[name]
+        before, after = statistics.median(xs), statistics.median(ys)
+        change = (after - before) / before * 100.0 if before else 0.0
+        if len(xs) < 2 or len(ys) < 2:
+            p, significant = float("nan"), False
+            verdict = "no repetitions"
+        else:
+            _, p = mann_whitney_u(xs, ys)
+            significant = p < alpha
+            verdict = "~"
+        if significant and change > threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif significant and change < -threshold:
+            verdict = "improved"
+        print("%-*s %14.1f %14.1f %+8.1f%% %9.4f  %s" % (width, name, before, after, change, p, verdict))
+
+    for name in base:
+        if name not in cont:
+            print("%-*s  missing from the contender" % (width, name))
+    for name in cont:
+        if name not in base:
+            print("%-*s  new in the contender" % (width, name))
+
+    print("\n%d of %d benchmarks regressed by more than %.1f%% (alpha %.3g)"
+          % (regressions, len(common), threshold, alpha))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--dir", default=os.path.join("build", "baselines"), help="baseline directory")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    def add_run_options(sub):
+        sub.add_argument("--binary", required=True, help="benchmark executable")
+        sub.add_argument("--repetitions", type=int, default=10)
+        sub.add_argument("--filter", default=".", help="--benchmark_filter regex")
+        sub.add_argument("--min-time", default="", help="--benchmark_min_time value")
+
+    def add_compare_options(sub):
+        sub.add_argument("--threshold", type=float, default=5.0, help="regression threshold in percent")
+        sub.add_argument("--alpha", type=float, default=0.05, help="significance level")
+        sub.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+
+    record = commands.add_parser("record", help="run the benchmarks and store a named baseline")
+    record.add_argument("name")
+    add_run_options(record)
+
+    comp = commands.add_parser("compare", help="compare two stored runs or JSON files")
+    comp.add_argument("baseline")
+    comp.add_argument("contender")
+    add_compare_options(comp)
+
+    check = commands.add_parser("check", help="run the benchmarks and compare them with a baseline")
+    check.add_argument("baseline")
+    check.add_argument("--save-as", default="", help="also store this run under a name")
+    add_run_options(check)
+    add_compare_options(check)
+
+    commands.add_parser("list", help="list stored baselines")
+
+    args = parser.parse_args()
+
+    if args.command == "record":
+        result = run_benchmarks(args.binary, args.repetitions, args.filter, args.min_time)
+        print("stored baseline '%s' in %s" % (args.name, save(args.dir, args.name, result)))
+        return 0
+
+    if args.command == "compare":
+        baseline, contender = load(args.dir, args.baseline), load(args.dir, args.contender)
+        return 1 if compare(baseline, contender, args.metric, args.threshold, args.alpha) else 0
+
+    if args.command == "check":
+        baseline = load(args.dir, args.baseline)
+        contender = run_benchmarks(args.binary, args.repetitions, args.filter, args.min_time)
+        if args.save_as:
+            save(args.dir, args.save_as, contender)
+        return 1 if compare(baseline, contender, args.metric, args.threshold, args.alpha) else 0
+
+    if args.command == "list":
+        if os.path.isdir(args.dir):
+            for entry in sorted(os.listdir(args.dir)):
+                if entry.endswith(".json"):
+                    with open(os.path.join(args.dir, entry)) as f:
+                        context = json.load(f).get("context", {})
+                    print("%-24s %s  %s" % (entry[:-5], context.get("apus_recorded_at", "?"),
+                                            context.get("apus_git_revision", "")[:12]))
+        return 0
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,119 @@
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <apus/csr_graph.hpp>
+#include <apus/small_vector.hpp>
+
+// Read-only traversals of the same random graph (0-9 out-edges per node, so about a
+// third of the rows spill past the inline buffer) held as a std::vector of
+// small_vector<uint32_t, 4> rows and frozen into a csr_graph. "bytes" is each
+// representation's footprint.
+
+using adjacency = std::vector<apus::small_vector<std::uint32_t, 4>>;
+
+static adjacency make_adjacency(std::size_t nodes)
+{
+    std::mt19937 rng(42);
+    adjacency    rows(nodes);
+    for (auto& row : rows) {
+        std::size_t degree = rng() % 10;
+        for (std::size_t e = 0; e < degree; ++e) row.push_back(static_cast<std::uint32_t>(rng() % nodes));
+    }
+    return rows;
+}
+
+static std::size_t adjacency_bytes(const adjacency& rows)
+{
+    std::size_t bytes = rows.capacity() * sizeof(rows[0]);
+    for (const auto& row : rows) {
+        if (row.capacity() > 4) bytes += row.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+// sums the neighbour ids of every node, row by row
+template <typename Graph>
+static std::uint64_t sweep(const Graph& graph, std::size_t nodes)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t n = 0; n < nodes; ++n) {
+        for (std::uint32_t to : graph[n]) sum += to;
+    }
+    return sum;
+}
+
+// breadth-first search from node 0, returning the number of nodes reached
+template <typename Graph>
+static std::size_t bfs(const Graph& graph, std::size_t nodes)
+{
+    std::vector<std::uint8_t>  seen(nodes, 0);
+    std::vector<std::uint32_t> frontier{0};
+    seen[0] = 1;
+    for (std::size_t head = 0; head < frontier.size(); ++head) {
+        for (std::uint32_t to : graph[frontier[head]]) {
+            if (!seen[to]) {
+                seen[to] = 1;
+                frontier.push_back(to);
+            }
+        }
+    }
+    return frontier.size();
+}
+
+static void BM_SmallVectorRows_Sweep(benchmark::State& state)
+{
+    const auto nodes = static_cast<std::size_t>(state.range(0));
+    adjacency  rows  = make_adjacency(nodes);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sweep(rows, nodes));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+    state.counters["bytes"] = static_cast<double>(adjacency_bytes(rows));
+}
+BENCHMARK(BM_SmallVectorRows_Sweep)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_CsrGraph_Sweep(benchmark::State& state)
+{
+    const auto        nodes = static_cast<std::size_t>(state.range(0));
+    apus::csr_graph<> graph = apus::csr_graph<>::from_rows(make_adjacency(nodes));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sweep(graph, nodes));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+    state.counters["bytes"] = static_cast<double>(graph.memory_bytes());
+}
+BENCHMARK(BM_CsrGraph_Sweep)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_SmallVectorRows_Bfs(benchmark::State& state)
+{
+    const auto nodes = static_cast<std::size_t>(state.range(0));
+    adjacency  rows  = make_adjacency(nodes);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bfs(rows, nodes));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+}
+BENCHMARK(BM_SmallVectorRows_Bfs)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_CsrGraph_Bfs(benchmark::State& state)
+{
+    const auto        nodes = static_cast<std::size_t>(state.range(0));
+    apus::csr_graph<> graph = apus::csr_graph<>::from_rows(make_adjacency(nodes));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bfs(graph, nodes));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+}
+BENCHMARK(BM_CsrGraph_Bfs)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_CsrBuilder_Freeze(benchmark::State& state)
+{
+    const auto nodes = static_cast<std::size_t>(state.range(0));
+    adjacency  rows  = make_adjacency(nodes);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(apus::csr_graph<>::from_rows(rows).edge_count());
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+}
+BENCHMARK(BM_CsrBuilder_Freeze)->Arg(1 << 12)->Arg(1 << 20);
@@ -0,0 +1,347 @@
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <boost/container/stable_vector.hpp>
+#include <apus/slot_map.hpp>
+#include "bench_support.hpp"
+
+// A steady-state ECS workload: entities are spawned and despawned every tick,
+// reference each other through handles that go stale, and are updated by systems
+// that walk several component storages. Unlike bench_slot_map.cpp, the storages
+// are fragmented by a full population turnover before anything is measured.
+
+struct position
+{
+    float x, y, z;
+};
+
+struct velocity
+{
+    float x, y, z;
+};
+
+struct health
+{
+    std::int32_t hp;
+    std::int32_t regen;
+};
+
+// ---------------------------------------------------------------------------
+// storages compared, all with the same interface:
+//   handle insert(const T&), void erase(handle), T* find(handle), for_each(fn(T&))
+//
+// Each is wrapped in a family that also names its handle type without instantiating
+// the storage, since entities hold handles to other entities.
+// ---------------------------------------------------------------------------
+
+template <typename T>
+class slot_map_storage
+{
+public:
+    using handle = apus::slot_map_handle<T>;
+
+    handle insert(const T& value) { return map_.add(value); }
+    void   erase(handle h) { map_.remove(h); }
+    T*     find(handle h) { return map_.find(h); }
+
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for (auto& value : map_) fn(value);
+    }
+
+private:
+    apus::slot_map<T> map_;
+};
+
+// ids are never reused, so a stale id simply misses
+template <typename T>
+class unordered_map_storage
+{
+public:
+    using handle = std::uint64_t;
+
+    handle insert(const T& value)
+    {
+        map_.emplace(next_id_, value);
+        return next_id_++;
+    }
+    void erase(handle h) { map_.erase(h); }
+
+    T* find(handle h)
+    {
+        auto it = map_.find(h);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for (auto& [id, value] : map_) fn(value);
+    }
+
+private:
+    std::unordered_map<std::uint64_t, T> map_;
+    std::uint64_t                        next_id_ = 0;
+};
+
+// the hand-rolled alternative: slots with a generation counter plus a free list of
+// indices, over either std::vector or boost::stable_vector (stable addresses, but
+// one extra indirection per access)
+struct free_list_handle
+{
+    std::uint32_t index;
+    std::uint32_t generation;
+};
+
+template <typename T, template <typename...> class Vector>
+class free_list_storage
+{
+public:
+    using handle = free_list_handle;
+
+    handle insert(const T& value)
+    {
+        std::uint32_t index;
+        if (free_.empty()) {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(slot{value, 0, true});
+        } else {
+            index = free_.back();
+            free_.pop_back();
+            slots_[index].value = value;
+            slots_[index].alive = true;
+        }
+        return handle{index, slots_[index].generation};
+    }
+
+    void erase(handle h)
+    {
+        slot& s = slots_[h.index];
+        s.alive = false;
+        ++s.generation;
+        free_.push_back(h.index);
+    }
+
+    T* find(handle h)
+    {
+        if (h.index >= slots_.size()) return nullptr;
+        slot& s = slots_[h.index];
+        return s.generation == h.generation && s.alive ? &s.value : nullptr;
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for (auto& s : slots_) {
+            if (s.alive) fn(s.value);
+        }
+    }
+
+private:
+    struct slot
+    {
+        T             value;
+        std::uint32_t generation;
+        bool          alive;
+    };
+
+    Vector<slot>               slots_;
+    std::vector<std::uint32_t> free_;
+};
+
+struct slot_map_family
+{
+    template <typename T> using storage = slot_map_storage<T>;
+    template <typename T> using handle  = apus::slot_map_handle<T>;
+};
+
+struct unordered_map_family
+{
+    template <typename T> using storage = unordered_map_storage<T>;
+    template <typename T> using handle  = std::uint64_t;
+};
+
+struct vector_family
+{
+    template <typename T> using storage = free_list_storage<T, std::vector>;
+    template <typename T> using handle  = free_list_handle;
+};
+
+struct stable_vector_family
+{
+    template <typename T> using storage = free_list_storage<T, boost::container::stable_vector>;
+    template <typename T> using handle  = free_list_handle;
+};
+
+// ---------------------------------------------------------------------------
+// the simulated world
+// ---------------------------------------------------------------------------
+
+template <typename Family>
+class world
+{
+    template <typename T> using storage = typename Family::template storage<T>;
+    template <typename T> using handle  = typename Family::template handle<T>;
+
+    struct entity;
+
+public:
+    using entity_handle = handle<entity>;
+
+    world(std::size_t population, std::size_t churn_per_tick)
+        : churn_per_tick_(churn_per_tick), rng_(42)
+    {
+        live_.reserve(population);
+        for (std::size_t i = 0; i < population; ++i) spawn();
+        for (auto& h : live_) retarget(*entities_.find(h));
+    }
+
+    /**
+     * @brief Despawns and respawns the whole population once, leaving every storage
+     * as fragmented as it would be after running for a long time.
+     */
+    void turn_over()
+    {
+        for (std::size_t i = 0, n = live_.size(); i < n; ++i) {
+            despawn_random();
+            spawn();
+        }
+    }
+
+    void tick()
+    {
+        churn();
+        movement_system();
+        combat_system();
+        regen_system();
+    }
+
+    std::size_t population() const noexcept { return live_.size(); }
+
+private:
+    struct entity
+    {
+        handle<position> pos;
+        handle<velocity> vel;
+        handle<health>   hp;
+        entity_handle    target;
+        bool             moving;
+    };
+
+    void spawn()
+    {
+        entity e{};
+        e.pos    = positions_.insert(position{0, 0, 0});
+        e.hp     = healths_.insert(health{100, 1});
+        e.moving = (rng_() & 3) != 0; // three quarters of entities move
+        if (e.moving) e.vel = velocities_.insert(velocity{1, 0.5f, 0.25f});
+        if (!live_.empty()) e.target = live_[rng_() % live_.size()];
+        live_.push_back(entities_.insert(e));
+    }
+
+    void despawn_random()
+    {
+        std::size_t i = rng_() % live_.size();
+        entity*     e = entities_.find(live_[i]);
+        positions_.erase(e->pos);
+        healths_.erase(e->hp);
+        if (e->moving) velocities_.erase(e->vel);
+        entities_.erase(live_[i]);
+        live_[i] = live_.back();
+        live_.pop_back();
+    }
+
+    void retarget(entity& e) { e.target = live_[rng_() % live_.size()]; }
+
+    void churn()
+    {
+        for (std::size_t i = 0; i < churn_per_tick_; ++i) {
+            despawn_random();
+            spawn();
+        }
+    }
+
+    // joins entities with two component storages through their handles
+    void movement_system()
+    {
+        entities_.for_each([this](entity& e) {
+            if (!e.moving) return;
+            position*       p = positions_.find(e.pos);
+            const velocity* v = velocities_.find(e.vel);
+            p->x += v->x;
+            p->y += v->y;
+            p->z += v->z;
+        });
+    }
+
+    // resolves inter-entity references at random; stale targets must be detected
+    void combat_system()
+    {
+        entities_.for_each([this](entity& e) {
+            entity* target = entities_.find(e.target);
+            if (target == nullptr) {
+                retarget(e);
+                return;
+            }
+            healths_.find(target->hp)->hp -= 1;
+        });
+    }
+
+    // a single dense storage walk
+    void regen_system()
+    {
+        healths_.for_each([](health& h) {
+            h.hp = std::min<std::int32_t>(h.hp + h.regen, 100);
+        });
+    }
+
+    storage<entity>            entities_;
+    storage<position>          positions_;
+    storage<velocity>          velocities_;
+    storage<health>            healths_;
+    std::vector<entity_handle> live_;
+    std::size_t                churn_per_tick_;
+    std::mt19937               rng_;
+};
+
+// range(0): population, range(1): entities despawned and respawned per tick, per mille
+template <typename Family>
+static void BM_EcsSimulation(benchmark::State& state)
+{
+    std::size_t population = state.range(0);
+    std::size_t churn      = population * state.range(1) / 1000;
+    std::size_t rss_before = apus_bench::current_rss_bytes();
+
+    world<Family> w(population, churn);
+    w.turn_over();
+
+    for (auto _ : state) {
+        w.tick();
+    }
+    benchmark::ClobberMemory();
+
+    std::size_t rss_after  = apus_bench::current_rss_bytes();
+    state.SetItemsProcessed(state.iterations() * population);
+    state.counters["ticks"]       = static_cast<double>(state.iterations());
+    state.counters["rss_mb"]      = rss_after > rss_before ? (rss_after - rss_before) / 1048576.0 : 0.0;
+    state.counters["peak_rss_mb"] = apus_bench::peak_rss_bytes() / 1048576.0;
+}
+
+static void ecs_args(benchmark::internal::Benchmark* b)
+{
+    for (int population : {10000, 100000}) {
+        for (int churn : {10, 100}) {
+            b->Args({population, churn});
+        }
+    }
+    b->Iterations(2000)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(BM_EcsSimulation, slot_map_family)->Name("ECS/SlotMap")->Apply(ecs_args);
+BENCHMARK_TEMPLATE(BM_EcsSimulation, unordered_map_family)->Name("ECS/UnorderedMap")->Apply(ecs_args);
+BENCHMARK_TEMPLATE(BM_EcsSimulation, vector_family)->Name("ECS/VectorFreeList")->Apply(ecs_args);
+BENCHMARK_TEMPLATE(BM_EcsSimulation, stable_vector_family)->Name("ECS/StableVector")->Apply(ecs_args);
@@ -0,0 +1,244 @@
+#ifndef APUS_BENCH_FIXTURES_HPP
+#define APUS_BENCH_FIXTURES_HPP
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <unistd.h>
+#include <benchmark/benchmark.h>
+
+namespace apus_bench
+{
+
+    /**
+     * @brief A benchmark element of exactly Size bytes (at least 4) carrying a 32-bit key.
+     *
+     * With Trivial = false the element has user-provided copy/move operations and a
+     * destructor, so containers cannot relocate it with memcpy, while keeping the same
+     * size and layout as the trivial one.
+     */
+    template <std::size_t Size, bool Trivial>
+    struct element
+    {
+        static_assert(Size >= sizeof(std::uint32_t), "element must hold its key");
+
+        element() = default;
+        explicit element(std::uint32_t k) : key(k), payload{} {}
+
+        std::uint32_t                                          key;
+        std::array<unsigned char, Size - sizeof(std::uint32_t)> payload;
+    };
+
+    // a zero-length std::array still takes a byte, so the key-only element has no payload
+    template <>
+    struct element<sizeof(std::uint32_t), true>
+    {
+        element() = default;
+        explicit element(std::uint32_t k) : key(k) {}
+
+        std::uint32_t key;
+    };
+
+    template <std::size_t Size>
+    struct element<Size, false> : element<Size, true>
+    {
+        using element<Size, true>::element;
+
+        element() = default;
+        element(const element& other) : element<Size, true>(other) {}
+        element(element&& other) noexcept : element<Size, true>(other) {}
+        element& operator=(const element& other)
+        {
+            element<Size, true>::operator=(other);
+            return *this;
+        }
+        element& operator=(element&& other) noexcept
+        {
+            element<Size, true>::operator=(other);
+            return *this;
+        }
+        ~element() {}
+    };
+
+    /**
+     * @brief The order in which a benchmark visits the elements of a container.
+     */
+    enum class access_pattern
+    {
+        sequential, // 0, 1, 2, ...
+        uniform,    // uniformly random
+        zipfian,    // Zipf distribution (s = 0.99) over randomly placed ranks
+        hot_cold,   // 90% of accesses go to a random 10% of the elements
+    };
+
+    inline const char* to_string(access_pattern pattern)
+    {
+        switch (pattern) {
+            case access_pattern::sequential: return "sequential";
+            case access_pattern::uniform:    return "uniform";
+            case access_pattern::zipfian:    return "zipfian";
+            case access_pattern::hot_cold:   return "hot_cold";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Generates `count` indices into [0, n) following an access pattern.
+     *
+     * The sequence is precomputed so that generating it stays out of the timed loop.
+     */
+    inline std::vector<std::uint32_t> make_access_sequence(access_pattern pattern, std::size_t n, std::size_t count,
+                                                           std::uint32_t seed = 42)
+    {
+        std::mt19937               rng(seed);
+        std::vector<std::uint32_t> sequence(count);
+
+        // a random placement of ranks, so that hot elements are not neighbours in memory
+        std::vector<std::uint32_t> placement(n);
+        std::iota(placement.begin(), placement.end(), 0);
+        std::shuffle(placement.begin(), placement.end(), rng);
+
+        switch (pattern) {
+            case access_pattern::sequential:
+                for (std::size_t i = 0; i < count; ++i) sequence[i] = static_cast<std::uint32_t>(i % n);
+                break;
+            case access_pattern::uniform:
+                for (auto& index : sequence) index = static_cast<std::uint32_t>(rng() % n);
+                break;
+            case access_pattern::zipfian: {
+                std::vector<double> cdf(n);
+                double              total = 0;
+                for (std::size_t rank = 0; rank < n; ++rank) {
+                    total += 1.0 / std::pow(static_cast<double>(rank + 1), 0.99);
+                    cdf[rank] = total;
+                }
+                std::uniform_real_distribution<double> uniform(0, total);
+                for (auto& index : sequence) {
+                    std::size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+                    index            = placement[std::min(rank, n - 1)];
+                }
+                break;
+            }
+            case access_pattern::hot_cold: {
+                std::size_t hot = std::max<std::size_t>(n / 10, 1);
+                for (auto& index : sequence) {
+                    bool        to_hot = rng() % 10 != 0;
+                    std::size_t rank   = to_hot ? rng() % hot : hot + rng() % std::max<std::size_t>(n - hot, 1);
+                    index              = placement[std::min(rank, n - 1)];
+                }
+                break;
+            }
+        }
+        return sequence;
+    }
+
+    /**
+     * @brief Evicts the CPU caches by writing a buffer several times the size of the
+     * last-level cache (64 MiB when the size is unknown).
+     */
+    inline void flush_cache()
+    {
+        static std::vector<unsigned char> buffer = [] {
+            long llc = 0;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+            llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+            std::size_t bytes = llc > 0 ? 4 * static_cast<std::size_t>(llc) : std::size_t(64) << 20;
+            return std::vector<unsigned char>(std::max(bytes, std::size_t(64) << 20));
+        }();
+        for (std::size_t i = 0; i < buffer.size(); i += 64) {
+            buffer[i] += 1;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    // element sizes swept by register_sweep
+    static constexpr std::size_t SWEEP_SIZES[] = {4, 16, 64, 256, 1024};
+
+    // accesses per benchmark iteration, amortizing the cold-cache flush's timer pause
+    static constexpr std::size_t SWEEP_BATCH = 1024;
+
+    /**
+     * @brief Runs a batch of accesses per iteration over a container adapter.
+     *
+     * An adapter is constructed with the element count, and `access(i)` touches the i-th
+     * element and returns its key. With `cold`, the caches are flushed (untimed) before
+     * every batch.
+     */
+    template <typename Adapter>
+    void run_sweep(benchmark::State& state, access_pattern pattern, bool cold)
+    {
+        std::size_t n        = static_cast<std::size_t>(state.range(0));
+        Adapter     adapter(n);
+        auto        sequence = make_access_sequence(pattern, n, std::size_t(1) << 16);
+        std::size_t pos      = 0;
+
+        for (auto _ : state) {
+            if (cold) {
+                state.PauseTiming();
+                flush_cache();
+                state.ResumeTiming();
+            }
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < SWEEP_BATCH; ++i) {
+                sum += adapter.access(sequence[pos]);
+                pos = (pos + 1) & (sequence.size() - 1);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * SWEEP_BATCH);
+    }
+
+    namespace detail
+    {
+        template <template <typename> class Adapter, std::size_t Size, bool Trivial>
+        void register_sweep_element(const std::string& name, std::int64_t n)
+        {
+            using adapter = Adapter<element<Size, Trivial>>;
+            static_assert(sizeof(element<Size, Trivial>) == Size, "sweep elements must be exactly Size bytes");
+
+            for (auto pattern : {access_pattern::sequential, access_pattern::uniform, access_pattern::zipfian,
+                                 access_pattern::hot_cold}) {
+                for (bool cold : {false, true}) {
+                    std::string full = name + "/" + std::to_string(Size) + "B/" +
+                                       (Trivial ? "trivial/" : "nontrivial/") + to_string(pattern) +
+                                       (cold ? "/cold" : "/warm");
+                    benchmark::RegisterBenchmark(full.c_str(), [pattern, cold](benchmark::State& state) {
+                        run_sweep<adapter>(state, pattern, cold);
+                    })->Arg(n);
+                }
+            }
+        }
+
+        template <template <typename> class Adapter, std::size_t... I>
+        void register_sweep_sizes(const std::string& name, std::int64_t n, std::index_sequence<I...>)
+        {
+            (register_sweep_element<Adapter, SWEEP_SIZES[I], true>(name, n), ...);
+            (register_sweep_element<Adapter, SWEEP_SIZES[I], false>(name, n), ...);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Registers a container adapter over every element size, copyability, access
+     * pattern and warm/cold cache combination, as "<name>/<size>B/<copyability>/<pattern>/<cache>".
+     *
+     * @return true, so that it can initialize a static at namespace scope.
+     */
+    template <template <typename> class Adapter>
+    bool register_sweep(const std::string& name, std::int64_t n = 1 << 16)
+    {
+        constexpr std::size_t size_count = sizeof(SWEEP_SIZES) / sizeof(SWEEP_SIZES[0]);
+        detail::register_sweep_sizes<Adapter>(name, n, std::make_index_sequence<size_count>{});
+        return true;
+    }
+
+} // namespace apus_bench
+
+#endif // APUS_BENCH_FIXTURES_HPP
@@ -0,0 +1,137 @@
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <apus/flat_hash_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+// random keys shared by all benchmarks of a given size
+static std::vector<uint64_t> make_keys(std::size_t count, uint64_t seed)
+{
+    std::mt19937_64       rng(seed);
+    std::vector<uint64_t> keys(count);
+    for (auto& key : keys) {
+        key = rng();
+    }
+    return keys;
+}
+
+template <typename Map>
+static void BM_Insert(benchmark::State& state)
+{
+    auto keys = make_keys(state.range(0), 42);
+    for (auto _ : state) {
+        Map m;
+        for (auto key : keys) {
+            m[key] = key;
+        }
+        benchmark::DoNotOptimize(m.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Insert, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Insert, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Insert, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+
+template <typename Map>
+static void BM_InsertReserved(benchmark::State& state)
+{
+    auto keys = make_keys(state.range(0), 42);
+    for (auto _ : state) {
+        Map m;
+        m.reserve(keys.size());
+        for (auto key : keys) {
+            m[key] = key;
+        }
+        benchmark::DoNotOptimize(m.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_InsertReserved, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_InsertReserved, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_InsertReserved, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+
+template <typename Map>
+static void BM_LookupHit(benchmark::State& state)
+{
+    auto keys = make_keys(state.range(0), 42);
+    Map  m;
+    for (auto key : keys) {
+        m[key] = key;
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto it = m.find(keys[i]);
+        benchmark::DoNotOptimize(it->second);
+        if (++i == keys.size()) i = 0;
+    }
+}
+BENCHMARK_TEMPLATE(BM_LookupHit, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LookupHit, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LookupHit, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+
+template <typename Map>
+static void BM_LookupMiss(benchmark::State& state)
+{
+    auto keys   = make_keys(state.range(0), 42);
+    auto misses = make_keys(state.range(0), 7);
+    Map  m;
+    for (auto key : keys) {
+        m[key] = key;
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool found = m.find(misses[i]) != m.end();
+        benchmark::DoNotOptimize(found);
+        if (++i == misses.size()) i = 0;
+    }
+}
+BENCHMARK_TEMPLATE(BM_LookupMiss, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LookupMiss, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LookupMiss, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+
+template <typename Map>
+static void BM_EraseInsertChurn(benchmark::State& state)
+{
+    auto keys = make_keys(state.range(0) * 2, 42);
+    Map  m;
+    for (std::size_t i = 0; i < keys.size() / 2; ++i) {
+        m[keys[i]] = keys[i];
+    }
+
+    // slide a window of live keys over the key set, one erase and one insert per iteration
+    std::size_t oldest = 0, next = keys.size() / 2;
+    for (auto _ : state) {
+        m.erase(keys[oldest]);
+        m[keys[next]] = keys[next];
+        if (++oldest == keys.size()) oldest = 0;
+        if (++next == keys.size()) next = 0;
+    }
+}
+BENCHMARK_TEMPLATE(BM_EraseInsertChurn, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_EraseInsertChurn, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_EraseInsertChurn, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+
+template <typename Map>
+static void BM_Iterate(benchmark::State& state)
+{
+    auto keys = make_keys(state.range(0), 42);
+    Map  m;
+    for (auto key : keys) {
+        m[key] = key;
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& item : m) {
+            sum += item.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Iterate, apus::flat_hash_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Iterate, std::unordered_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Iterate, boost::unordered_flat_map<uint64_t, uint64_t>)->Range(1 << 8, 1 << 18);
@@ -0,0 +1,346 @@
+#include <deque>
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <unordered_map>
+#include <memory_resource>
+#include <benchmark/benchmark.h>
+#include <boost/circular_buffer.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <apus/slot_map.hpp>
+#include <apus/small_vector.hpp>
+#include <apus/ring_buffer.hpp>
+#include <apus/flat_hash_map.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include "bench_support.hpp"
+#include "../tests/alloc_counter.hpp"
+
+// Memory footprint of containers holding live elements, after churn. Heap bytes are
+// counted by alloc_counter.cpp's malloc hooks as the bytes malloc actually hands out
+// (malloc_usable_size, so size class rounding is included). Each benchmark reports:
+//   bytes_per_elem  heap bytes plus the container's own sizeof, per live element
+//   heap_kb         heap bytes held at the end, peak_heap_kb the most held during churn
+//   rss_before_mb / rss_after_mb / peak_rss_mb  from /proc/self/statm and VmHWM
+// Footprints are deterministic, so each benchmark runs a single iteration.
+
+namespace
+{
+    /**
+     * @brief Measures the heap and RSS growth of one benchmark body.
+     */
+    class footprint_scope
+    {
+    public:
+        explicit footprint_scope(benchmark::State& state)
+            : state_(state), rss_before_(apus_bench::current_rss_bytes()),
+              heap_before_(apus_testing::live_heap_bytes())
+        {
+            apus_testing::reset_peak_heap_bytes();
+            apus_bench::reset_peak_rss();
+        }
+
+        /**
+         * @brief Reports the footprint of `live_elements` elements held by containers whose
+         * own (non-heap) size totals `header_bytes`. Call it while the containers are alive.
+         */
+        void report(std::size_t live_elements, std::size_t header_bytes)
+        {
+            std::size_t heap = static_cast<std::size_t>(apus_testing::live_heap_bytes() - heap_before_);
+            std::size_t peak = static_cast<std::size_t>(apus_testing::peak_heap_bytes() - heap_before_);
+            if (live_elements != 0) {
+                state_.counters["bytes_per_elem"] = static_cast<double>(heap + header_bytes) / live_elements;
+            }
+            state_.counters["heap_kb"]       = heap / 1024.0;
+            state_.counters["peak_heap_kb"]  = peak / 1024.0;
+            state_.counters["rss_before_mb"] = rss_before_ / 1048576.0;
+            state_.counters["rss_after_mb"]  = apus_bench::current_rss_bytes() / 1048576.0;
+            state_.counters["peak_rss_mb"]   = apus_bench::peak_rss_bytes() / 1048576.0;
+        }
+
+    private:
+        benchmark::State& state_;
+        std::size_t       rss_before_;
+        std::int64_t      heap_before_;
+    };
+
+    template <std::size_t Size>
+    struct blob
+    {
+        unsigned char data[Size];
+    };
+
+    // elements removed and re-added after the initial fill, as a fraction of the fill
+    constexpr std::size_t CHURN_DIVISOR = 2;
+
+    const bool heap_tracking = (apus_testing::enable_heap_tracking(), true);
+} // namespace
+
+// --- handle-based storage: slot_map (paged storage, version array, free list) ---
+
+// Fills `count` elements, removes a random 1/CHURN_DIVISOR of them and adds as many
+// back. The benchmark's own list of live handles is allocated before measuring.
+template <typename Handle, typename Add, typename Remove>
+static void churn(std::size_t count, std::vector<Handle>& live, Add&& add, Remove&& remove)
+{
+    std::mt19937 rng(42);
+    for (std::size_t i = 0; i < count; ++i) live.push_back(add());
+    for (std::size_t i = 0; i < count / CHURN_DIVISOR; ++i) {
+        std::size_t j = rng() % live.size();
+        remove(live[j]);
+        live[j] = live.back();
+        live.pop_back();
+    }
+    for (std::size_t i = 0; i < count / CHURN_DIVISOR; ++i) live.push_back(add());
+}
+
+template <std::size_t Size>
+static void BM_Footprint_SlotMap(benchmark::State& state)
+{
+    using handle = apus::slot_map_handle<blob<Size>>;
+
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        std::vector<handle> live;
+        live.reserve(count);
+        footprint_scope footprint(state);
+
+        apus::slot_map<blob<Size>> sm;
+        churn(count, live, [&] { return sm.add(blob<Size>{}); }, [&](handle h) { sm.remove(h); });
+        footprint.report(sm.size(), sizeof(sm));
+    }
+}
+
+template <std::size_t Size>
+static void BM_Footprint_UnorderedMap(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        std::vector<std::uint32_t> live;
+        live.reserve(count);
+        footprint_scope footprint(state);
+
+        std::unordered_map<std::uint32_t, blob<Size>> um;
+        std::uint32_t                                 next_id = 0;
+        churn(
+            count, live,
+            [&] {
+                um.emplace(next_id, blob<Size>{});
+                return next_id++;
+            },
+            [&](std::uint32_t id) { um.erase(id); });
+        footprint.report(um.size(), sizeof(um));
+    }
+}
+
+// std::vector of slots plus a free list of indices, the usual hand-rolled alternative
+template <std::size_t Size>
+static void BM_Footprint_VectorFreeList(benchmark::State& state)
+{
+    struct slot
+    {
+        blob<Size>    value;
+        std::uint32_t generation;
+    };
+
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        std::vector<std::uint32_t> live;
+        live.reserve(count);
+        footprint_scope footprint(state);
+
+        std::vector<slot>          slots;
+        std::vector<std::uint32_t> free;
+        churn(
+            count, live,
+            [&] {
+                if (free.empty()) {
+                    slots.push_back(slot{});
+                    return static_cast<std::uint32_t>(slots.size() - 1);
+                }
+                std::uint32_t index = free.back();
+                free.pop_back();
+                return index;
+            },
+            [&](std::uint32_t index) {
+                ++slots[index].generation;
+                free.push_back(index);
+            });
+        footprint.report(slots.size() - free.size(), sizeof(slots) + sizeof(free));
+    }
+}
+
+#define APUS_FOOTPRINT_SIZES(bm)                                                                                       \
+    BENCHMARK_TEMPLATE(bm, 16)->Arg(1 << 16)->Iterations(1);                                                          \
+    BENCHMARK_TEMPLATE(bm, 64)->Arg(1 << 16)->Iterations(1);                                                          \
+    BENCHMARK_TEMPLATE(bm, 256)->Arg(1 << 16)->Iterations(1);                                                         \
+    BENCHMARK_TEMPLATE(bm, 1024)->Arg(1 << 16)->Iterations(1)
+
+APUS_FOOTPRINT_SIZES(BM_Footprint_SlotMap);
+APUS_FOOTPRINT_SIZES(BM_Footprint_UnorderedMap);
+APUS_FOOTPRINT_SIZES(BM_Footprint_VectorFreeList);
+
+// --- many small vectors of k ints: inline buffer vs heap block per vector ---
+
+template <typename Vector>
+static void run_small_vectors(benchmark::State& state)
+{
+    constexpr std::size_t VECTOR_COUNT = 1 << 14;
+    std::size_t           length       = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        std::vector<Vector> vectors(VECTOR_COUNT); // the headers are heap bytes of this outer vector
+        for (auto& v : vectors) {
+            for (std::size_t i = 0; i < length; ++i) v.push_back(static_cast<int>(i));
+        }
+        footprint.report(VECTOR_COUNT * length, 0);
+        state.counters["bytes_per_vector"] =
+            state.counters["heap_kb"].value * 1024.0 / static_cast<double>(VECTOR_COUNT);
+    }
+}
+
+static void BM_Footprint_SmallVector(benchmark::State& state)
+{
+    run_small_vectors<apus::small_vector<int, 16>>(state);
+}
+
+static void BM_Footprint_BoostSmallVector(benchmark::State& state)
+{
+    run_small_vectors<boost::container::small_vector<int, 16>>(state);
+}
+
+static void BM_Footprint_StdVector(benchmark::State& state)
+{
+    run_small_vectors<std::vector<int>>(state);
+}
+
+BENCHMARK(BM_Footprint_SmallVector)->Arg(0)->Arg(4)->Arg(16)->Arg(64)->Iterations(1);
+BENCHMARK(BM_Footprint_BoostSmallVector)->Arg(0)->Arg(4)->Arg(16)->Arg(64)->Iterations(1);
+BENCHMARK(BM_Footprint_StdVector)->Arg(0)->Arg(4)->Arg(16)->Arg(64)->Iterations(1);
+
+// --- FIFO queues held full and churned ---
+
+static void BM_Footprint_RingBuffer(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        apus::ring_buffer<blob<64>> rb(count);
+        for (std::size_t i = 0; i < 2 * count; ++i) rb.push_back(blob<64>{}); // overwrites once full
+        footprint.report(rb.size(), sizeof(rb));
+    }
+}
+BENCHMARK(BM_Footprint_RingBuffer)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+
+static void BM_Footprint_BoostCircularBuffer(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        boost::circular_buffer<blob<64>> cb(count);
+        for (std::size_t i = 0; i < 2 * count; ++i) cb.push_back(blob<64>{});
+        footprint.report(cb.size(), sizeof(cb));
+    }
+}
+BENCHMARK(BM_Footprint_BoostCircularBuffer)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+
+static void BM_Footprint_Deque(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        std::deque<blob<64>> dq;
+        for (std::size_t i = 0; i < 2 * count; ++i) {
+            dq.push_back(blob<64>{});
+            if (dq.size() > count) dq.pop_front();
+        }
+        footprint.report(dq.size(), sizeof(dq));
+    }
+}
+BENCHMARK(BM_Footprint_Deque)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+
+// --- hash maps of 8-byte keys and values ---
+
+template <typename Map>
+static void run_hash_map(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+        std::mt19937_64 rng(42);
+
+        Map map;
+        for (std::size_t i = 0; i < count; ++i) map.insert({rng(), i});
+        footprint.report(map.size(), sizeof(map));
+    }
+}
+
+static void BM_Footprint_FlatHashMap(benchmark::State& state)
+{
+    run_hash_map<apus::flat_hash_map<std::uint64_t, std::uint64_t>>(state);
+}
+
+static void BM_Footprint_BoostUnorderedFlatMap(benchmark::State& state)
+{
+    run_hash_map<boost::unordered_flat_map<std::uint64_t, std::uint64_t>>(state);
+}
+
+static void BM_Footprint_StdUnorderedMap(benchmark::State& state)
+{
+    run_hash_map<std::unordered_map<std::uint64_t, std::uint64_t>>(state);
+}
+
+BENCHMARK(BM_Footprint_FlatHashMap)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Footprint_BoostUnorderedFlatMap)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Footprint_StdUnorderedMap)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1);
+
+// --- arenas: page slack for mixed allocation sizes (8 to 512 bytes) ---
+
+template <typename Allocate>
+static std::size_t allocate_mixed(std::size_t count, Allocate&& allocate)
+{
+    std::mt19937 rng(42);
+    std::size_t  requested = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t bytes = 8 + rng() % 505;
+        benchmark::DoNotOptimize(allocate(bytes));
+        requested += bytes;
+    }
+    return requested;
+}
+
+template <std::size_t PageSize>
+static void BM_Footprint_PagedArena(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        apus::paged_memory_arena<PageSize> arena;
+        std::size_t requested = allocate_mixed(count, [&](std::size_t bytes) { return arena.allocate(bytes); });
+        footprint.report(count, sizeof(arena));
+        state.counters["requested_per_elem"] = static_cast<double>(requested) / count;
+        state.counters["slack_kb"] = (arena.page_count() * PageSize - arena.used_bytes()) / 1024.0;
+    }
+}
+BENCHMARK_TEMPLATE(BM_Footprint_PagedArena, 4096)->Arg(1 << 14)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_Footprint_PagedArena, 65536)->Arg(1 << 14)->Iterations(1);
+
+static void BM_Footprint_MonotonicBufferResource(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    for (auto _ : state) {
+        footprint_scope footprint(state);
+
+        std::pmr::monotonic_buffer_resource resource;
+        std::size_t requested = allocate_mixed(count, [&](std::size_t bytes) { return resource.allocate(bytes); });
+        footprint.report(count, sizeof(resource));
+        state.counters["requested_per_elem"] = static_cast<double>(requested) / count;
+    }
+}
+BENCHMARK(BM_Footprint_MonotonicBufferResource)->Arg(1 << 14)->Iterations(1);
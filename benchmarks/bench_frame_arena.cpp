@@ -0,0 +1,53 @@
+#include <array>
+#include <vector>
+#include <cstdlib>
+#include <benchmark/benchmark.h>
+#include <apus/frame_arena.hpp>
+
+// A three-stage pipeline: each frame allocates FRAME_ALLOCS blocks of 16-256 bytes,
+// and the last stage releases them three frames later. The heap version frees frame
+// n - 3's blocks one by one; frame_arena resets that frame's arena as frame n begins.
+
+static constexpr std::size_t FRAME_ALLOCS = 1000;
+static constexpr std::size_t FRAME_DELAY  = 3;
+
+static std::size_t block_size(std::size_t i) { return 16 + (i * 37) % 241; }
+
+static void BM_Malloc_DeferredFree(benchmark::State& state)
+{
+    std::array<std::vector<void*>, FRAME_DELAY> in_flight;
+    for (auto& frame : in_flight) frame.reserve(FRAME_ALLOCS);
+
+    std::size_t n = 0;
+    for (auto _ : state) {
+        auto& frame = in_flight[n++ % FRAME_DELAY];
+        for (void* p : frame) std::free(p);
+        frame.clear();
+        for (std::size_t i = 0; i < FRAME_ALLOCS; ++i) {
+            void* p = std::malloc(block_size(i));
+            benchmark::DoNotOptimize(p);
+            frame.push_back(p);
+        }
+    }
+    for (auto& frame : in_flight) {
+        for (void* p : frame) std::free(p);
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_ALLOCS);
+}
+BENCHMARK(BM_Malloc_DeferredFree);
+
+static void BM_FrameArena_DeferredFree(benchmark::State& state)
+{
+    apus::frame_arena<FRAME_DELAY> arena;
+
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        arena.begin_frame(n++);
+        for (std::size_t i = 0; i < FRAME_ALLOCS; ++i) {
+            void* p = arena.allocate(block_size(i));
+            benchmark::DoNotOptimize(p);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_ALLOCS);
+}
+BENCHMARK(BM_FrameArena_DeferredFree);
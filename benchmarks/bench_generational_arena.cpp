@@ -0,0 +1,64 @@
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <apus/generational_arena.hpp>
+
+// A message-processing loop: each request builds REQUEST_OBJECTS small records and
+// one in SURVIVOR_EVERY requests keeps one of them for the session. The heap version
+// news every record and deletes all but the survivor at the end of the request; the
+// generational arena bump-allocates them and promotes the survivor at reset.
+
+static constexpr std::size_t REQUEST_OBJECTS = 64;
+static constexpr std::size_t SURVIVOR_EVERY  = 16;
+
+struct record
+{
+    std::uint64_t id;
+    std::uint64_t payload[5];
+};
+
+static void BM_Heap_Request(benchmark::State& state)
+{
+    std::vector<record*> request;
+    std::vector<std::unique_ptr<record>> session;
+    request.reserve(REQUEST_OBJECTS);
+
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < REQUEST_OBJECTS; ++i) {
+            request.push_back(new record{n * REQUEST_OBJECTS + i, {}});
+        }
+        benchmark::DoNotOptimize(request.data());
+        if (n++ % SURVIVOR_EVERY == 0) {
+            session.emplace_back(request.back());
+            request.pop_back();
+        }
+        for (record* r : request) delete r;
+        request.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * REQUEST_OBJECTS);
+}
+BENCHMARK(BM_Heap_Request);
+
+static void BM_GenerationalArena_Request(benchmark::State& state)
+{
+    apus::generational_arena<> arena;
+    std::vector<record*>       session;
+
+    std::uint64_t n = 0;
+    for (auto _ : state) {
+        record* last = nullptr;
+        for (std::size_t i = 0; i < REQUEST_OBJECTS; ++i) {
+            last = arena.construct<record>(record{n * REQUEST_OBJECTS + i, {}});
+        }
+        benchmark::DoNotOptimize(last);
+        if (n++ % SURVIVOR_EVERY == 0) {
+            session.push_back(last);
+            arena.promote(session.back());
+        }
+        arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * REQUEST_OBJECTS);
+}
+BENCHMARK(BM_GenerationalArena_Request);
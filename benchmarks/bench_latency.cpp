@@ -0,0 +1,129 @@
+#include <deque>
+#include <vector>
+#include <cstdlib>
+#include <benchmark/benchmark.h>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/small_vector.hpp>
+#include <apus/ring_buffer.hpp>
+#include "bench_support.hpp"
+
+// Latency distributions of single container operations. The mean per iteration
+// hides the rare slow operations (page turnover, spills, relocations); each
+// operation is timed on its own with apus_bench::op_clock and recorded in a
+// latency_histogram, which reports p50/p99/p99.9/max. Times include the clock's
+// own overhead of a few nanoseconds.
+
+template <typename Op>
+static void time_op(apus_bench::latency_histogram& histogram, Op&& op)
+{
+    std::uint64_t start = apus_bench::op_clock::now();
+    op();
+    histogram.record(apus_bench::op_clock::now() - start);
+}
+
+// --- paged_memory_arena: one allocation in every page turns over a page ---
+
+static void BM_Latency_PagedArenaAllocate(benchmark::State& state)
+{
+    apus::paged_memory_arena<1024 * 64> arena;
+    apus_bench::latency_histogram       histogram;
+    std::size_t                         alloc_size = state.range(0);
+    std::size_t                         count      = 0;
+
+    for (auto _ : state) {
+        time_op(histogram, [&] { benchmark::DoNotOptimize(arena.allocate(alloc_size)); });
+        if (++count == (1 << 16)) { // bound memory, keeping the reset out of the timed op
+            arena.reset();
+            count = 0;
+        }
+    }
+    histogram.report(state);
+}
+BENCHMARK(BM_Latency_PagedArenaAllocate)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_Latency_MallocAllocate(benchmark::State& state)
+{
+    apus_bench::latency_histogram histogram;
+    std::size_t                   alloc_size = state.range(0);
+    std::vector<void*>            blocks;
+    blocks.reserve(1 << 16);
+
+    for (auto _ : state) {
+        time_op(histogram, [&] { blocks.push_back(std::malloc(alloc_size)); });
+        if (blocks.size() == blocks.capacity()) {
+            for (void* p : blocks) std::free(p);
+            blocks.clear();
+        }
+    }
+    for (void* p : blocks) std::free(p);
+    histogram.report(state);
+}
+BENCHMARK(BM_Latency_MallocAllocate)->Arg(8)->Arg(64)->Arg(512);
+
+// --- small_vector: push_back past the inline capacity spills to the heap ---
+
+template <typename Vector>
+static void run_push_back_latency(benchmark::State& state)
+{
+    apus_bench::latency_histogram histogram;
+    int                           length = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        Vector v;
+        for (int i = 0; i < length; ++i) {
+            time_op(histogram, [&] { v.push_back(i); });
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    histogram.report(state);
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+static void BM_Latency_SmallVectorPushBack(benchmark::State& state)
+{
+    run_push_back_latency<apus::small_vector<int, 16>>(state);
+}
+BENCHMARK(BM_Latency_SmallVectorPushBack)->Arg(16)->Arg(64)->Arg(1024);
+
+static void BM_Latency_StdVectorPushBack(benchmark::State& state)
+{
+    run_push_back_latency<std::vector<int>>(state);
+}
+BENCHMARK(BM_Latency_StdVectorPushBack)->Arg(16)->Arg(64)->Arg(1024);
+
+// --- ring_buffer: a queue that grows with set_capacity when full ---
+
+static void BM_Latency_RingBufferGrowingPush(benchmark::State& state)
+{
+    apus_bench::latency_histogram histogram;
+    std::size_t                   max_size = state.range(0);
+    apus::ring_buffer<int>        rb(16);
+
+    for (auto _ : state) {
+        time_op(histogram, [&] {
+            if (rb.full()) rb.set_capacity(rb.capacity() * 2);
+            rb.push_back(1);
+        });
+        if (rb.size() == max_size) {
+            rb = apus::ring_buffer<int>(16);
+        }
+    }
+    histogram.report(state);
+}
+BENCHMARK(BM_Latency_RingBufferGrowingPush)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_Latency_DequeGrowingPush(benchmark::State& state)
+{
+    apus_bench::latency_histogram histogram;
+    std::size_t                   max_size = state.range(0);
+    std::deque<int>               dq;
+
+    for (auto _ : state) {
+        time_op(histogram, [&] { dq.push_back(1); });
+        if (dq.size() == max_size) {
+            dq = std::deque<int>();
+        }
+    }
+    histogram.report(state);
+}
+BENCHMARK(BM_Latency_DequeGrowingPush)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,89 @@
+#include <list>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <apus/lru_cache.hpp>
+
+// Skewed key stream over a key space four times larger than the cache, so the
+// workload mixes hits (promotions) with misses (insert + evict).
+static std::vector<std::uint64_t> make_keys(std::size_t capacity)
+{
+    std::mt19937_64            rng(42);
+    std::vector<std::uint64_t> keys(1 << 16);
+    for (auto& key : keys) {
+        key = rng() % (rng() % (capacity * 4) + 1);
+    }
+    return keys;
+}
+
+// the std::list + std::unordered_map cache this replaces
+class list_lru_cache
+{
+public:
+    explicit list_lru_cache(std::size_t capacity) : capacity_(capacity) {}
+
+    std::uint64_t* get(std::uint64_t key)
+    {
+        auto it = index_.find(key);
+        if (it == index_.end()) return nullptr;
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        if (order_.size() == capacity_) {
+            index_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.emplace_front(key, value);
+        index_[key] = order_.begin();
+    }
+
+private:
+    using entry_list = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+
+    std::size_t                                             capacity_;
+    entry_list                                              order_;
+    std::unordered_map<std::uint64_t, entry_list::iterator> index_;
+};
+
+template <typename Cache>
+static void run_cache(benchmark::State& state, Cache& cache)
+{
+    auto        keys = make_keys(state.range(0));
+    std::size_t i    = 0;
+    for (auto _ : state) {
+        std::uint64_t key = keys[i];
+        if (auto* value = cache.get(key)) {
+            benchmark::DoNotOptimize(*value);
+        } else {
+            cache.put(key, key);
+        }
+        if (++i == keys.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_LruCache_Lru(benchmark::State& state)
+{
+    apus::lru_cache<std::uint64_t, std::uint64_t> cache(state.range(0));
+    run_cache(state, cache);
+}
+BENCHMARK(BM_LruCache_Lru)->Range(1 << 10, 1 << 18);
+
+static void BM_LruCache_Clock(benchmark::State& state)
+{
+    apus::lru_cache<std::uint64_t, std::uint64_t> cache(state.range(0), apus::lru_cache_policy::clock);
+    run_cache(state, cache);
+}
+BENCHMARK(BM_LruCache_Clock)->Range(1 << 10, 1 << 18);
+
+static void BM_ListUnorderedMap_Lru(benchmark::State& state)
+{
+    list_lru_cache cache(state.range(0));
+    run_cache(state, cache);
+}
+BENCHMARK(BM_ListUnorderedMap_Lru)->Range(1 << 10, 1 << 18);
@@ -69,3 +69,40 @@ static void BM_Vector_Clear(benchmark::State& state)
     }
 }
 BENCHMARK(BM_Vector_Clear)->Range(8, 8192);
+
+// A request arena partitioned into 4 subsystem budgets of 16KB, each filled with 64
+// allocations of 64 bytes, then released: child arenas carved with make_child versus
+// one malloc'd buffer per budget
+static void BM_ChildArena_SubsystemBudgets(benchmark::State& state)
+{
+    apus::memory_arena<1024 * 1024> request;
+
+    for (auto _ : state) {
+        for (int s = 0; s < 4; ++s) {
+            apus::child_arena budget = request.make_child(16 * 1024);
+            for (int i = 0; i < 64; ++i) {
+                benchmark::DoNotOptimize(budget.allocate(64));
+            }
+        }
+        request.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * 64);
+}
+BENCHMARK(BM_ChildArena_SubsystemBudgets);
+
+static void BM_MallocBudget_SubsystemBudgets(benchmark::State& state)
+{
+    for (auto _ : state) {
+        void* budgets[4];
+        for (int s = 0; s < 4; ++s) {
+            budgets[s] = std::malloc(16 * 1024);
+            apus::child_arena budget(budgets[s], 16 * 1024);
+            for (int i = 0; i < 64; ++i) {
+                benchmark::DoNotOptimize(budget.allocate(64));
+            }
+        }
+        for (void* b : budgets) std::free(b);
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * 64);
+}
+BENCHMARK(BM_MallocBudget_SubsystemBudgets);
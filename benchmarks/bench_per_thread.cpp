@@ -0,0 +1,58 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <apus/per_thread.hpp>
+
+// Threads bumping event counters: one shared atomic, a packed array indexed by thread
+// (neighbouring threads share cache lines), and per_thread, which pads every thread's
+// counter to its own line. The packed array and per_thread update with a relaxed load
+// and store, since each counter has a single writer.
+
+static constexpr int COUNTER_BUMPS = 256;
+
+static void BM_Counter_SharedAtomic(benchmark::State& state)
+{
+    static std::atomic<std::uint64_t> counter{0};
+    for (auto _ : state) {
+        for (int i = 0; i < COUNTER_BUMPS; ++i) counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNTER_BUMPS);
+}
+BENCHMARK(BM_Counter_SharedAtomic)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_Counter_PackedArray(benchmark::State& state)
+{
+    static std::array<std::atomic<std::uint64_t>, 64> counters{};
+    auto&                                             counter = counters[static_cast<std::size_t>(state.thread_index())];
+    for (auto _ : state) {
+        for (int i = 0; i < COUNTER_BUMPS; ++i) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * COUNTER_BUMPS);
+}
+BENCHMARK(BM_Counter_PackedArray)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_Counter_PerThread(benchmark::State& state)
+{
+    static apus::per_thread<std::atomic<std::uint64_t>> counters;
+    for (auto _ : state) {
+        auto& counter = counters.local();
+        for (int i = 0; i < COUNTER_BUMPS; ++i) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * COUNTER_BUMPS);
+}
+BENCHMARK(BM_Counter_PerThread)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_PerThread_Combine(benchmark::State& state)
+{
+    static apus::per_thread<std::uint64_t> values;
+    values.local() = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values.combine([](std::uint64_t a, std::uint64_t b) { return a + b; }));
+    }
+}
+BENCHMARK(BM_PerThread_Combine);
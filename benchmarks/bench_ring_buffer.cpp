@@ -1,10 +1,13 @@
 #include <benchmark/benchmark.h>
 #include <apus/ring_buffer.hpp>
 #include <boost/circular_buffer.hpp>
+#include "bench_support.hpp"
 
 static void BM_BoostCircularBuffer_PushBack(benchmark::State& state)
 {
     boost::circular_buffer<int> rb(state.range(0));
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         for (int i = 0; i < state.range(0); ++i) {
             rb.push_back(i);
@@ -17,6 +20,8 @@ BENCHMARK(BM_BoostCircularBuffer_PushBack)->Range(8, 1024);
 static void BM_ApusRingBuffer_PushBack(benchmark::State& state)
 {
     apus::ring_buffer<int> rb(state.range(0));
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         for (int i = 0; i < state.range(0); ++i) {
             rb.push_back(i);
@@ -30,6 +35,8 @@ static void BM_BoostCircularBuffer_Iterate(benchmark::State& state)
 {
     boost::circular_buffer<int> rb(state.range(0));
     for (int i = 0; i < state.range(0); ++i) rb.push_back(i);
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         int sum = 0;
         for (int x : rb) {
@@ -44,6 +51,8 @@ static void BM_ApusRingBuffer_Iterate(benchmark::State& state)
 {
     apus::ring_buffer<int> rb(state.range(0));
     for (int i = 0; i < state.range(0); ++i) rb.push_back(i);
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         int sum = 0;
         for (int x : rb) {
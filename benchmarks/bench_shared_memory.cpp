@@ -0,0 +1,115 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <benchmark/benchmark.h>
+#include <apus/shared_memory.hpp>
+#include <apus/shared_ring_buffer.hpp>
+#include <apus/shared_slot_map.hpp>
+
+// Round trips of a 64-byte message through an echo peer: a pair of shared_ring_buffers
+// in a shared memory region versus a Unix socketpair. The peer is a thread with its
+// own mapping of the region, which costs the same as a separate process. Both sides
+// of the ring buffer spin, so run this on at least two cores.
+
+namespace
+{
+    struct message
+    {
+        std::uint64_t sequence;
+        std::uint64_t payload[7];
+    };
+
+    using queue = apus::shared_ring_buffer<message, 64>;
+} // namespace
+
+static void BM_SharedRingBuffer_RoundTrip(benchmark::State& state)
+{
+    auto   region  = apus::shared_memory_region::create_anonymous(64 * 1024);
+    queue& request = region.construct<queue>("request");
+    queue& reply   = region.construct<queue>("reply");
+
+    std::atomic<bool> done{false};
+    std::thread       echo([&] {
+        auto    mapping = apus::shared_memory_region::attach(region.fd());
+        queue&  in      = *mapping.find<queue>("request");
+        queue&  out     = *mapping.find<queue>("reply");
+        message m;
+        while (!done.load(std::memory_order_relaxed)) {
+            if (in.try_pop(m)) {
+                while (!out.try_push(m)) {
+                }
+            }
+        }
+    });
+
+    message m{};
+    for (auto _ : state) {
+        ++m.sequence;
+        while (!request.try_push(m)) {
+        }
+        while (!reply.try_pop(m)) {
+        }
+        benchmark::DoNotOptimize(m);
+    }
+
+    done = true;
+    echo.join();
+}
+BENCHMARK(BM_SharedRingBuffer_RoundTrip)->UseRealTime();
+
+static void BM_SocketPair_RoundTrip(benchmark::State& state)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+
+    std::thread echo([fd = fds[1]] {
+        message m;
+        while (::read(fd, &m, sizeof(m)) == static_cast<ssize_t>(sizeof(m))) {
+            if (::write(fd, &m, sizeof(m)) != static_cast<ssize_t>(sizeof(m))) break;
+        }
+    });
+
+    message m{};
+    for (auto _ : state) {
+        ++m.sequence;
+        if (::write(fds[0], &m, sizeof(m)) != static_cast<ssize_t>(sizeof(m)) ||
+            ::read(fds[0], &m, sizeof(m)) != static_cast<ssize_t>(sizeof(m))) {
+            state.SkipWithError("socket round trip failed");
+            break;
+        }
+        benchmark::DoNotOptimize(m);
+    }
+
+    ::shutdown(fds[0], SHUT_RDWR);
+    echo.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+BENCHMARK(BM_SocketPair_RoundTrip)->UseRealTime();
+
+static void BM_SharedSlotMap_Read(benchmark::State& state)
+{
+    using table = apus::shared_slot_map<message>;
+
+    auto   region = apus::shared_memory_region::create_anonymous(1 << 20);
+    table& map    = region.construct<table>("table", region);
+
+    std::vector<table::handle> handles;
+    for (std::uint64_t i = 0; i < 1024; ++i) handles.push_back(map.add(message{i, {}}));
+
+    message m;
+    for (auto _ : state) {
+        for (const auto& h : handles) {
+            map.read(h, m);
+            benchmark::DoNotOptimize(m);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+BENCHMARK(BM_SharedSlotMap_Read);
@@ -2,6 +2,7 @@
 #include <unordered_map>
 #include <benchmark/benchmark.h>
 #include <apus/slot_map.hpp>
+#include "bench_support.hpp"
 
 struct TestObject
 {
@@ -14,6 +15,8 @@ static void BM_SlotMap_AddRemove(benchmark::State& state)
     std::vector<apus::slot_map<TestObject>::handle> handles;
     handles.reserve(state.range(0));
 
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         for (int i = 0; i < state.range(0); ++i) {
             handles.push_back(sm.add(TestObject{}));
@@ -29,6 +32,8 @@ BENCHMARK(BM_SlotMap_AddRemove)->Range(8, 1024);
 static void BM_UnorderedMap_AddRemove(benchmark::State& state)
 {
     std::unordered_map<uint32_t, TestObject> um;
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         for (uint32_t i = 0; i < (uint32_t)state.range(0); ++i) {
             um[i] = TestObject{};
@@ -48,6 +53,8 @@ static void BM_SlotMap_Iteration(benchmark::State& state)
         sm.add(TestObject{});
     }
 
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         uint64_t sum = 0;
         for (const auto& obj : sm) {
@@ -65,6 +72,8 @@ static void BM_UnorderedMap_Iteration(benchmark::State& state)
         um[i] = TestObject{};
     }
 
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         uint64_t sum = 0;
         for (const auto& pair : um) {
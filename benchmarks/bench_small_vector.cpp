@@ -1,9 +1,12 @@
 #include <benchmark/benchmark.h>
 #include <apus/small_vector.hpp>
 #include <vector>
+#include "bench_support.hpp"
 
 static void BM_StdVectorPushBack(benchmark::State& state)
 {
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         std::vector<int> v;
         for (int i = 0; i < state.range(0); ++i) {
@@ -16,6 +19,8 @@ BENCHMARK(BM_StdVectorPushBack)->Range(1, 128);
 
 static void BM_SmallVectorPushBack(benchmark::State& state)
 {
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         apus::small_vector<int, 16> v;
         for (int i = 0; i < state.range(0); ++i) {
@@ -32,6 +37,8 @@ static void BM_StdVectorIterate(benchmark::State& state)
     for (int i = 0; i < state.range(0); ++i) {
         v.push_back(i);
     }
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         int sum = 0;
         for (int x : v) {
@@ -48,6 +55,8 @@ static void BM_SmallVectorIterate(benchmark::State& state)
     for (int i = 0; i < state.range(0); ++i) {
         v.push_back(i);
     }
+    apus_bench::hardware_counters  counters(state);
+    apus_bench::allocation_counter allocations(state);
     for (auto _ : state) {
         int sum = 0;
         for (int x : v) {
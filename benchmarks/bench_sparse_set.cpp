@@ -0,0 +1,131 @@
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <apus/slot_map.hpp>
+#include <apus/sparse_set.hpp>
+
+struct Entity
+{
+    uint64_t id;
+};
+
+struct Extra
+{
+    uint64_t data[4]; // 32 bytes
+};
+
+using entity_handle = apus::slot_map<Entity>::handle;
+
+struct handle_hash
+{
+    std::size_t operator()(entity_handle h) const
+    {
+        return std::hash<uint64_t>()((uint64_t(h.version) << 32) | h.index);
+    }
+};
+
+// spawns count entities and records their handles
+static void fill(apus::slot_map<Entity>& entities, std::vector<entity_handle>& handles, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        handles.push_back(entities.add({i}));
+    }
+}
+
+static void BM_SparseSet_Lookup(benchmark::State& state)
+{
+    apus::slot_map<Entity>          entities;
+    std::vector<entity_handle>      handles;
+    apus::sparse_set<Extra, Entity> extras;
+    fill(entities, handles, state.range(0));
+    for (std::size_t i = 0; i < handles.size(); i += 2) {
+        extras.insert(handles[i], Extra{{i}});
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto h : handles) {
+            if (const Extra* e = extras.find(h)) sum += e->data[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_SparseSet_Lookup)->Range(64, 1 << 16);
+
+static void BM_UnorderedMap_Lookup(benchmark::State& state)
+{
+    apus::slot_map<Entity>                                entities;
+    std::vector<entity_handle>                            handles;
+    std::unordered_map<entity_handle, Extra, handle_hash> extras;
+    fill(entities, handles, state.range(0));
+    for (std::size_t i = 0; i < handles.size(); i += 2) {
+        extras[handles[i]] = Extra{{i}};
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto h : handles) {
+            auto it = extras.find(h);
+            if (it != extras.end()) sum += it->second.data[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_UnorderedMap_Lookup)->Range(64, 1 << 16);
+
+static void BM_SparseSet_Iterate(benchmark::State& state)
+{
+    apus::slot_map<Entity>          entities;
+    std::vector<entity_handle>      handles;
+    apus::sparse_set<Extra, Entity> extras;
+    fill(entities, handles, state.range(0));
+    for (std::size_t i = 0; i < handles.size(); i += 2) {
+        extras.insert(handles[i], Extra{{i}});
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& e : extras) sum += e.data[0];
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_SparseSet_Iterate)->Range(64, 1 << 16);
+
+static void BM_UnorderedMap_Iterate(benchmark::State& state)
+{
+    apus::slot_map<Entity>                                 entities;
+    std::vector<entity_handle>                             handles;
+    std::unordered_map<entity_handle, Extra, handle_hash> extras;
+    fill(entities, handles, state.range(0));
+    for (std::size_t i = 0; i < handles.size(); i += 2) {
+        extras[handles[i]] = Extra{{i}};
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& pair : extras) sum += pair.second.data[0];
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_UnorderedMap_Iterate)->Range(64, 1 << 16);
+
+static void BM_SparseSet_Intersection(benchmark::State& state)
+{
+    apus::slot_map<Entity>             entities;
+    std::vector<entity_handle>         handles;
+    apus::sparse_set<Extra, Entity>    common;
+    apus::sparse_set<uint32_t, Entity> rare;
+    fill(entities, handles, state.range(0));
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        common.insert(handles[i], Extra{{i}});
+        if (i % 64 == 0) rare.insert(handles[i], uint32_t(i));
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        apus::for_each_intersection([&](entity_handle, const Extra& e, uint32_t r) { sum += e.data[0] + r; }, common, rare);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_SparseSet_Intersection)->Range(64, 1 << 16);
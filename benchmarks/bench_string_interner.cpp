@@ -0,0 +1,89 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <unordered_set>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <apus/string_interner.hpp>
+
+// metric-like identifiers with a realistic repetition rate
+static std::vector<std::string> make_names(std::size_t count, std::size_t distinct)
+{
+    std::mt19937                          rng(42);
+    std::uniform_int_distribution<size_t> pick(0, distinct - 1);
+    std::vector<std::string>              names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back("service.request.latency_" + std::to_string(pick(rng)));
+    }
+    return names;
+}
+
+static void BM_StringInterner_Intern(benchmark::State& state)
+{
+    auto names = make_names(state.range(0), state.range(0) / 4);
+    for (auto _ : state) {
+        apus::string_interner<> interner;
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(interner.intern(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringInterner_Intern)->Range(1 << 10, 1 << 18);
+
+static void BM_UnorderedSet_Intern(benchmark::State& state)
+{
+    auto names = make_names(state.range(0), state.range(0) / 4);
+    for (auto _ : state) {
+        std::unordered_set<std::string> interned;
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(&*interned.insert(name).first);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnorderedSet_Intern)->Range(1 << 10, 1 << 18);
+
+static void BM_UnorderedMap_InternIds(benchmark::State& state)
+{
+    auto names = make_names(state.range(0), state.range(0) / 4);
+    for (auto _ : state) {
+        std::unordered_map<std::string, uint32_t> ids;
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(ids.emplace(name, static_cast<uint32_t>(ids.size())).first->second);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnorderedMap_InternIds)->Range(1 << 10, 1 << 18);
+
+static void BM_StringInterner_FrozenLookup(benchmark::State& state)
+{
+    auto                    names = make_names(state.range(0), state.range(0) / 4);
+    apus::string_interner<> interner;
+    for (const auto& name : names) {
+        interner.intern(name);
+    }
+    interner.freeze();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interner.find(names[i]));
+        if (++i == names.size()) i = 0;
+    }
+}
+BENCHMARK(BM_StringInterner_FrozenLookup)->Range(1 << 10, 1 << 18);
+
+static void BM_UnorderedSet_Lookup(benchmark::State& state)
+{
+    auto                            names = make_names(state.range(0), state.range(0) / 4);
+    std::unordered_set<std::string> interned(names.begin(), names.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interned.find(names[i]));
+        if (++i == names.size()) i = 0;
+    }
+}
+BENCHMARK(BM_UnorderedSet_Lookup)->Range(1 << 10, 1 << 18);
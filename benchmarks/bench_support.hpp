@@ -0,0 +1,342 @@
+#ifndef APUS_BENCH_SUPPORT_HPP
+#define APUS_BENCH_SUPPORT_HPP
+
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <benchmark/benchmark.h>
+#include "../tests/alloc_counter.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define APUS_BENCH_HAS_RDTSC 1
+#endif
+
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace apus_bench
+{
+
+    /**
+     * @brief Returns the resident set size of this process in bytes, or 0 if unavailable.
+     *
+     * Reads the second field of /proc/self/statm (resident pages).
+     */
+    inline std::size_t current_rss_bytes()
+    {
+        std::ifstream statm("/proc/self/statm");
+        std::size_t   total_pages = 0, resident_pages = 0;
+        if (!(statm >> total_pages >> resident_pages)) {
+            return 0;
+        }
+        return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    /**
+     * @brief Returns the peak resident set size of this process in bytes, or 0 if unavailable.
+     *
+     * Reads VmHWM from /proc/self/status.
+     */
+    inline std::size_t peak_rss_bytes()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string   line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return std::stoull(line.substr(6)) * 1024; // reported in kB
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Resets the peak resident set size reported by peak_rss_bytes() to the current
+     * resident set size. Returns false if the kernel does not allow it.
+     *
+     * Writes 5 to /proc/self/clear_refs (Linux 4.0 and later).
+     */
+    inline bool reset_peak_rss()
+    {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+    }
+
+    /**
+     * @brief A low-overhead clock for timing individual operations.
+     *
+     * Reads the time stamp counter where available and steady_clock otherwise. The tick
+     * rate is calibrated against steady_clock once, on first use.
+     */
+    class op_clock
+    {
+    public:
+        static std::uint64_t now() noexcept
+        {
+#if defined(APUS_BENCH_HAS_RDTSC)
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now().time_since_epoch())
+                                                  .count());
+#endif
+        }
+
+        static double to_ns(std::uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_ns(); }
+
+        static double ticks_per_ns()
+        {
+#if defined(APUS_BENCH_HAS_RDTSC)
+            static const double rate = [] {
+                auto          start_time  = std::chrono::steady_clock::now();
+                std::uint64_t start_ticks = now();
+                while (std::chrono::steady_clock::now() - start_time < std::chrono::milliseconds(20)) {
+                }
+                std::uint64_t ticks   = now() - start_ticks;
+                auto          elapsed = std::chrono::steady_clock::now() - start_time;
+                return static_cast<double>(ticks) /
+                       static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }();
+            return rate;
+#else
+            return 1.0;
+#endif
+        }
+    };
+
+    /**
+     * @brief An HDR-style log-linear histogram of operation latencies.
+     *
+     * Values below 2^SUB_BITS are counted exactly; above that every power-of-two range is
+     * split into 2^(SUB_BITS-1) buckets, so any recorded value is reported within 1/64
+     * (about 1.6%) of its true value using a fixed 30 KB of counts, however many
+     * operations are recorded. The maximum is tracked exactly.
+     */
+    class latency_histogram
+    {
+        static constexpr unsigned    SUB_BITS     = 7;
+        static constexpr std::size_t SUB_COUNT    = std::size_t(1) << SUB_BITS;
+        static constexpr std::size_t HALF_COUNT   = SUB_COUNT / 2;
+        static constexpr std::size_t BUCKET_COUNT = SUB_COUNT + (64 - SUB_BITS) * HALF_COUNT;
+
+    public:
+        latency_histogram() { clear(); }
+
+        void record(std::uint64_t value) noexcept
+        {
+            ++counts_[bucket_of(value)];
+            ++total_;
+            max_ = std::max(max_, value);
+        }
+
+        /**
+         * @brief Returns the value at a percentile (0-100), or 0 without samples.
+         *
+         * The value reported is the highest value equivalent to the bucket it falls in,
+         * so percentiles never understate the latency.
+         */
+        std::uint64_t percentile(double p) const noexcept
+        {
+            if (total_ == 0) return 0;
+            std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(total_) + 0.5);
+            rank               = std::max<std::uint64_t>(rank, 1);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                seen += counts_[i];
+                if (seen >= rank) return std::min(highest_in_bucket(i), max_);
+            }
+            return max_;
+        }
+
+        std::uint64_t max() const noexcept { return max_; }
+        std::uint64_t count() const noexcept { return total_; }
+
+        void clear() noexcept
+        {
+            std::memset(counts_, 0, sizeof(counts_));
+            total_ = 0;
+            max_   = 0;
+        }
+
+        /**
+         * @brief Adds p50_ns, p99_ns, p999_ns and max_ns counters to a benchmark, treating
+         * recorded values as op_clock ticks.
+         */
+        void report(benchmark::State& state) const
+        {
+            state.counters["p50_ns"]  = op_clock::to_ns(percentile(50));
+            state.counters["p99_ns"]  = op_clock::to_ns(percentile(99));
+            state.counters["p999_ns"] = op_clock::to_ns(percentile(99.9));
+            state.counters["max_ns"]  = op_clock::to_ns(max_);
+        }
+
+    private:
+        static std::size_t bucket_of(std::uint64_t value) noexcept
+        {
+            if (value < SUB_COUNT) return static_cast<std::size_t>(value);
+            unsigned shift = 63 - static_cast<unsigned>(__builtin_clzll(value)) - (SUB_BITS - 1);
+            return SUB_COUNT + (shift - 1) * HALF_COUNT + static_cast<std::size_t>((value >> shift) - HALF_COUNT);
+        }
+
+        static std::uint64_t highest_in_bucket(std::size_t bucket) noexcept
+        {
+            if (bucket < SUB_COUNT) return bucket;
+            std::size_t   k     = bucket - SUB_COUNT;
+            unsigned      shift = static_cast<unsigned>(k / HALF_COUNT) + 1;
+            std::uint64_t sub   = k % HALF_COUNT + HALF_COUNT;
+            return ((sub + 1) << shift) - 1;
+        }
+
+        std::uint64_t counts_[BUCKET_COUNT];
+        std::uint64_t total_;
+        std::uint64_t max_;
+    };
+
+#if defined(__linux__)
+    // perf_event_attr::config of a PERF_TYPE_HW_CACHE read miss event
+    constexpr std::uint64_t perf_cache_read_miss(std::uint64_t cache)
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+    /**
+     * @brief Counts hardware events with perf_event_open and reports them per iteration.
+     *
+     * Construct it right before the timed loop; on destruction it adds one Google Benchmark
+     * counter per event (cycles, instructions, l1d_misses, llc_misses, branch_misses,
+     * dtlb_misses), averaged over iterations. Events the kernel or hardware refuses, e.g.
+     * under a strict perf_event_paranoid or in a VM without a PMU, are simply left out, and
+     * setting APUS_BENCH_PERF=0 disables counting altogether. Counts are scaled when the
+     * kernel had to multiplex the counters.
+     */
+    class hardware_counters
+    {
+    public:
+        explicit hardware_counters(benchmark::State& state) : state_(state)
+        {
+#if defined(__linux__)
+            const char* env = std::getenv("APUS_BENCH_PERF");
+            if (env != nullptr && env[0] == '0') return;
+
+            for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+                fds_[i] = open_event(EVENTS[i].type, EVENTS[i].config);
+            }
+            for (int fd : fds_) {
+                if (fd < 0) continue;
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        ~hardware_counters()
+        {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+            for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+                if (fds_[i] < 0) continue;
+                std::uint64_t values[3]; // value, time enabled, time running
+                if (read(fds_[i], values, sizeof(values)) == sizeof(values) && values[2] != 0) {
+                    double scaled = static_cast<double>(values[0]) * values[1] / values[2];
+                    state_.counters[EVENTS[i].name] = benchmark::Counter(scaled, benchmark::Counter::kAvgIterations);
+                }
+                close(fds_[i]);
+            }
+#endif
+        }
+
+        // disable copying and moving
+        hardware_counters(const hardware_counters&)            = delete;
+        hardware_counters& operator=(const hardware_counters&) = delete;
+        hardware_counters(hardware_counters&&)                 = delete;
+        hardware_counters& operator=(hardware_counters&&)      = delete;
+
+    private:
+#if defined(__linux__)
+        struct event
+        {
+            const char*   name;
+            std::uint32_t type;
+            std::uint64_t config;
+        };
+
+        static constexpr std::size_t EVENT_COUNT = 6;
+        static constexpr event       EVENTS[EVENT_COUNT] = {
+            {"cycles",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"l1d_misses",    PERF_TYPE_HW_CACHE, perf_cache_read_miss(PERF_COUNT_HW_CACHE_L1D)},
+            {"llc_misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"dtlb_misses",   PERF_TYPE_HW_CACHE, perf_cache_read_miss(PERF_COUNT_HW_CACHE_DTLB)},
+        };
+
+        // returns -1 if the event cannot be counted here
+        static int open_event(std::uint32_t type, std::uint64_t config)
+        {
+            perf_event_attr attr{};
+            attr.size           = sizeof(attr);
+            attr.type           = type;
+            attr.config         = config;
+            attr.disabled       = 1;
+            attr.inherit        = 1; // include threads the benchmark spawns
+            attr.exclude_kernel = 1; // allowed under perf_event_paranoid=2
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        int fds_[EVENT_COUNT] = {-1, -1, -1, -1, -1, -1};
+#endif
+        benchmark::State& state_;
+    };
+
+    /**
+     * @brief Reports the heap allocations a benchmark makes per iteration.
+     *
+     * Construct it right before the timed loop; on destruction it adds `allocs` and
+     * `alloc_bytes` counters averaged over iterations, so an allocation-free hot path
+     * shows 0. Counts the benchmark's own thread, and needs tests/alloc_counter.cpp
+     * linked into the benchmark executable.
+     */
+    class allocation_counter
+    {
+    public:
+        explicit allocation_counter(benchmark::State& state) : state_(state) {}
+
+        ~allocation_counter()
+        {
+            state_.counters["allocs"] =
+                benchmark::Counter(static_cast<double>(scope_.allocations()), benchmark::Counter::kAvgIterations);
+            state_.counters["alloc_bytes"] =
+                benchmark::Counter(static_cast<double>(scope_.bytes()), benchmark::Counter::kAvgIterations);
+        }
+
+        // disable copying and moving
+        allocation_counter(const allocation_counter&)            = delete;
+        allocation_counter& operator=(const allocation_counter&) = delete;
+        allocation_counter(allocation_counter&&)                 = delete;
+        allocation_counter& operator=(allocation_counter&&)      = delete;
+
+    private:
+        benchmark::State&         state_;
+        apus_testing::alloc_scope scope_;
+    };
+
+} // namespace apus_bench
+
+#endif // APUS_BENCH_SUPPORT_HPP
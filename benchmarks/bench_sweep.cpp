@@ -0,0 +1,138 @@
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <apus/slot_map.hpp>
+#include <apus/sparse_set.hpp>
+#include <apus/small_vector.hpp>
+#include <apus/ring_buffer.hpp>
+#include <apus/flat_hash_map.hpp>
+#include <apus/typed_memory_arena.hpp>
+#include "bench_fixtures.hpp"
+
+// Element-size, copyability, access-pattern and cache-state sweep over every
+// container (see bench_fixtures.hpp). Each adapter holds n elements and reads
+// the key of element i; its std equivalent is registered next to it. Filter the
+// run with e.g. --benchmark_filter='slot_map/64B/.*/zipfian'.
+
+// --- handle-resolving containers ---
+
+template <typename E>
+struct slot_map_adapter
+{
+    explicit slot_map_adapter(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) handles.push_back(map.add(E(static_cast<std::uint32_t>(i))));
+    }
+    std::uint32_t access(std::uint32_t i) { return map.find(handles[i])->key; }
+
+    apus::slot_map<E>                     map;
+    std::vector<apus::slot_map_handle<E>> handles;
+};
+
+template <typename E>
+struct sparse_set_adapter
+{
+    explicit sparse_set_adapter(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            handles.push_back(owners.add(0));
+            set.insert(handles.back(), E(static_cast<std::uint32_t>(i)));
+        }
+    }
+    std::uint32_t access(std::uint32_t i) { return set.find(handles[i])->key; }
+
+    apus::slot_map<int>                     owners;
+    apus::sparse_set<E, int>                set;
+    std::vector<apus::slot_map_handle<int>> handles;
+};
+
+// --- keyed containers ---
+
+template <typename Map>
+struct map_adapter
+{
+    explicit map_adapter(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            map.emplace(static_cast<std::uint32_t>(i), typename Map::mapped_type(static_cast<std::uint32_t>(i)));
+        }
+    }
+    std::uint32_t access(std::uint32_t i) { return map.find(i)->second.key; }
+
+    Map map;
+};
+
+template <typename E>
+using flat_hash_map_adapter = map_adapter<apus::flat_hash_map<std::uint32_t, E>>;
+
+template <typename E>
+using unordered_map_adapter = map_adapter<std::unordered_map<std::uint32_t, E>>;
+
+// --- indexed containers ---
+
+template <typename Container>
+struct indexed_adapter
+{
+    explicit indexed_adapter(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_back(typename Container::value_type(static_cast<std::uint32_t>(i)));
+        }
+    }
+    std::uint32_t access(std::uint32_t i) { return container[i].key; }
+
+    Container container;
+};
+
+template <typename E>
+using small_vector_adapter = indexed_adapter<apus::small_vector<E, 16>>;
+
+template <typename E>
+using vector_adapter = indexed_adapter<std::vector<E>>;
+
+template <typename E>
+using deque_adapter = indexed_adapter<std::deque<E>>;
+
+template <typename E>
+struct ring_buffer_adapter
+{
+    explicit ring_buffer_adapter(std::size_t n) : ring(n)
+    {
+        // wrap around once so the live range straddles the end of the buffer
+        for (std::size_t i = 0; i < n + n / 2; ++i) ring.push_back(E(static_cast<std::uint32_t>(i % n)));
+    }
+    std::uint32_t access(std::uint32_t i) { return ring[i].key; }
+
+    apus::ring_buffer<E> ring;
+};
+
+template <typename E>
+struct typed_memory_arena_adapter
+{
+    explicit typed_memory_arena_adapter(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            auto slot = arena.allocate();
+            new (slot.ptr) E(static_cast<std::uint32_t>(i));
+        }
+    }
+    ~typed_memory_arena_adapter()
+    {
+        for (std::size_t i = 0; i < arena.size(); ++i) arena[i].~E();
+    }
+    std::uint32_t access(std::uint32_t i) { return arena[i].key; }
+
+    apus::typed_memory_arena<E, 1024> arena;
+};
+
+static const bool registered = apus_bench::register_sweep<slot_map_adapter>("slot_map") &&
+                               apus_bench::register_sweep<sparse_set_adapter>("sparse_set") &&
+                               apus_bench::register_sweep<flat_hash_map_adapter>("flat_hash_map") &&
+                               apus_bench::register_sweep<unordered_map_adapter>("std_unordered_map") &&
+                               apus_bench::register_sweep<small_vector_adapter>("small_vector") &&
+                               apus_bench::register_sweep<vector_adapter>("std_vector") &&
+                               apus_bench::register_sweep<ring_buffer_adapter>("ring_buffer") &&
+                               apus_bench::register_sweep<deque_adapter>("std_deque") &&
+                               apus_bench::register_sweep<typed_memory_arena_adapter>("typed_memory_arena");
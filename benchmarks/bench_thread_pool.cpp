@@ -0,0 +1,97 @@
+#include <vector>
+#include <thread>
+#include <numeric>
+#include <benchmark/benchmark.h>
+#include <apus/thread_pool.hpp>
+#include <apus/work_stealing_deque.hpp>
+
+static void BM_WorkStealingDeque_PushPop(benchmark::State& state)
+{
+    apus::work_stealing_deque<void*> deque;
+    void*                            value = nullptr;
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); ++i) {
+            deque.push(&value);
+        }
+        for (int i = 0; i < state.range(0); ++i) {
+            deque.pop(value);
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WorkStealingDeque_PushPop)->Range(8, 4096);
+
+static void BM_Serial_Sum(benchmark::State& state)
+{
+    std::vector<uint64_t> data(state.range(0));
+    std::iota(data.begin(), data.end(), 0);
+    for (auto _ : state) {
+        uint64_t sum = std::accumulate(data.begin(), data.end(), uint64_t(0));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint64_t));
+}
+BENCHMARK(BM_Serial_Sum)->Range(1 << 12, 1 << 24);
+
+static void BM_ThreadPool_ParallelForSum(benchmark::State& state)
+{
+    apus::thread_pool     pool;
+    std::vector<uint64_t> data(state.range(0));
+    std::iota(data.begin(), data.end(), 0);
+
+    for (auto _ : state) {
+        std::atomic<uint64_t> total{0};
+        pool.parallel_for(0, data.size(), 1 << 14, [&](std::size_t first, std::size_t last) {
+            uint64_t sum = 0;
+            for (std::size_t i = first; i < last; ++i) sum += data[i];
+            total.fetch_add(sum, std::memory_order_relaxed);
+        });
+        benchmark::DoNotOptimize(total.load());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint64_t));
+}
+BENCHMARK(BM_ThreadPool_ParallelForSum)->Range(1 << 12, 1 << 24)->UseRealTime();
+
+// grain size sweep over a fixed range of cheap per-index work
+static void BM_ThreadPool_ParallelForGrain(benchmark::State& state)
+{
+    apus::thread_pool     pool;
+    std::vector<uint32_t> data(1 << 20, 1);
+
+    for (auto _ : state) {
+        pool.parallel_for(0, data.size(), state.range(0), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) data[i] = data[i] * 3 + 1;
+        });
+        benchmark::DoNotOptimize(data.data());
+    }
+}
+BENCHMARK(BM_ThreadPool_ParallelForGrain)->RangeMultiplier(8)->Range(64, 1 << 18)->UseRealTime();
+
+static long fib_task(apus::thread_pool& pool, int n)
+{
+    if (n < 16) {
+        long a = 0, b = 1;
+        for (int i = 0; i < n; ++i) {
+            long next = a + b;
+            a         = b;
+            b         = next;
+        }
+        return a;
+    }
+    long             a = 0;
+    apus::task_group group(pool);
+    group.run([&] { a = fib_task(pool, n - 1); });
+    long b = fib_task(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+static void BM_ThreadPool_ForkJoin(benchmark::State& state)
+{
+    apus::thread_pool pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fib_task(pool, static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_ThreadPool_ForkJoin)->DenseRange(20, 28, 4)->UseRealTime();
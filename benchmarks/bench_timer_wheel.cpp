@@ -0,0 +1,107 @@
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <apus/timer_wheel.hpp>
+
+// Churn workload modelled on connection timeouts: N timers are outstanding, and
+// every tick one timer is reset (cancel + reschedule) and the clock advances by
+// one. Expired timers are rescheduled so the population stays at N.
+
+static constexpr std::uint64_t MAX_TIMEOUT = 1 << 16;
+
+static void BM_TimerWheel_Churn(benchmark::State& state)
+{
+    const std::size_t                       count = state.range(0);
+    std::mt19937_64                         rng(42);
+    apus::timer_wheel<std::uint32_t>        wheel;
+    std::vector<apus::timer_handle>         handles(count);
+
+    for (std::uint32_t id = 0; id < count; ++id) {
+        handles[id] = wheel.schedule(1 + rng() % MAX_TIMEOUT, id);
+    }
+
+    std::uint64_t now = 0;
+    for (auto _ : state) {
+        std::uint32_t id = static_cast<std::uint32_t>(rng() % count);
+        wheel.cancel(handles[id]);
+        handles[id] = wheel.schedule(now + 1 + rng() % MAX_TIMEOUT, id);
+
+        ++now;
+        wheel.advance(now, [&](std::uint32_t& expired) {
+            handles[expired] = wheel.schedule(now + 1 + rng() % MAX_TIMEOUT, expired);
+        });
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheel_Churn)->Range(1 << 10, 1 << 20);
+
+static void BM_PriorityQueue_Churn(benchmark::State& state)
+{
+    // no cancel in std::priority_queue: lazy deletion through per-timer generations
+    struct entry
+    {
+        std::uint64_t expiry;
+        std::uint32_t id;
+        std::uint32_t generation;
+        bool          operator>(const entry& other) const { return expiry > other.expiry; }
+    };
+
+    const std::size_t                                               count = state.range(0);
+    std::mt19937_64                                                 rng(42);
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> queue;
+    std::vector<std::uint32_t>                                      generations(count, 0);
+
+    for (std::uint32_t id = 0; id < count; ++id) {
+        queue.push({1 + rng() % MAX_TIMEOUT, id, 0});
+    }
+
+    std::uint64_t now = 0;
+    for (auto _ : state) {
+        std::uint32_t id = static_cast<std::uint32_t>(rng() % count);
+        queue.push({now + 1 + rng() % MAX_TIMEOUT, id, ++generations[id]});
+
+        ++now;
+        while (!queue.empty() && queue.top().expiry <= now) {
+            entry top = queue.top();
+            queue.pop();
+            if (top.generation == generations[top.id]) {
+                queue.push({now + 1 + rng() % MAX_TIMEOUT, top.id, ++generations[top.id]});
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PriorityQueue_Churn)->Range(1 << 10, 1 << 20);
+
+static void BM_Multimap_Churn(benchmark::State& state)
+{
+    using timer_map = std::multimap<std::uint64_t, std::uint32_t>;
+
+    const std::size_t                 count = state.range(0);
+    std::mt19937_64                   rng(42);
+    timer_map                         timers;
+    std::vector<timer_map::iterator>  handles(count);
+
+    for (std::uint32_t id = 0; id < count; ++id) {
+        handles[id] = timers.emplace(1 + rng() % MAX_TIMEOUT, id);
+    }
+
+    std::uint64_t now = 0;
+    for (auto _ : state) {
+        std::uint32_t id = static_cast<std::uint32_t>(rng() % count);
+        timers.erase(handles[id]);
+        handles[id] = timers.emplace(now + 1 + rng() % MAX_TIMEOUT, id);
+
+        ++now;
+        while (!timers.empty() && timers.begin()->first <= now) {
+            std::uint32_t expired = timers.begin()->second;
+            timers.erase(timers.begin());
+            handles[expired] = timers.emplace(now + 1 + rng() % MAX_TIMEOUT, expired);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Multimap_Churn)->Range(1 << 10, 1 << 20);
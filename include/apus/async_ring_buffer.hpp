@@ -0,0 +1,394 @@
+#ifndef APUS_ASYNC_RING_BUFFER_HPP
+#define APUS_ASYNC_RING_BUFFER_HPP
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "apus/async_ring_buffer.hpp requires C++20 coroutines"
+#endif
+
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <coroutine>
+#include <exception>
+
+#include <apus/ring_buffer.hpp>
+
+namespace apus
+{
+
+    // initial capacity of a coroutine_executor's run queue (it grows as needed)
+    static constexpr std::size_t DEFAULT_COROUTINE_EXECUTOR_CAPACITY = 64;
+
+    /**
+     * @brief A bounded FIFO queue for coroutines, built on ring_buffer.
+     *
+     * co_await push(value) suspends while the queue is full and co_await pop()
+     * suspends while it is empty. Suspended coroutines wait in intrusive FIFO lists
+     * threaded through their awaiters, which live in the coroutine frames, so waiting
+     * never allocates and never blocks a thread.
+     *
+     * A push that finds a suspended popper hands the value straight to it, and a pop
+     * that frees a slot moves the oldest suspended pusher's value in. Either way the
+     * woken coroutine is resumed directly, on the calling thread, before the call that
+     * woke it returns. A capacity of 0 makes every push a rendezvous with a pop.
+     *
+     * close() wakes every waiter: pending and later pushes return false, and pops
+     * drain the remaining elements and then return nullopt.
+     *
+     * Not thread-safe: the coroutines sharing a queue must run on one thread, for
+     * example on one coroutine_executor.
+     *
+     * @tparam T The type of elements to store.
+     */
+    template <typename T>
+    class async_ring_buffer
+    {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        class push_awaiter;
+        class pop_awaiter;
+
+        /**
+         * @brief Construct a new queue holding at most capacity elements.
+         */
+        explicit async_ring_buffer(size_type capacity) : buffer_(capacity) {}
+
+        // disable copying and moving
+        async_ring_buffer(const async_ring_buffer&)            = delete;
+        async_ring_buffer& operator=(const async_ring_buffer&) = delete;
+        async_ring_buffer(async_ring_buffer&&)                 = delete;
+        async_ring_buffer& operator=(async_ring_buffer&&)      = delete;
+
+        /**
+         * @brief Returns an awaitable that appends value, suspending while the queue is full.
+         *
+         * co_await yields true once the value is queued, or false if the queue is closed.
+         */
+        push_awaiter push(T value) { return push_awaiter(*this, std::move(value)); }
+
+        /**
+         * @brief Returns an awaitable that removes the oldest element, suspending while the queue is empty.
+         *
+         * co_await yields the element, or nullopt once the queue is closed and drained.
+         */
+        pop_awaiter pop() { return pop_awaiter(*this); }
+
+        /**
+         * @brief Appends value if there is room (or a waiting popper), without suspending.
+         *
+         * @return true If the value was queued or handed over.
+         */
+        bool try_push(T value) { return offer(value); }
+
+        /**
+         * @brief Removes the oldest element if there is one, without suspending.
+         */
+        std::optional<T> try_pop()
+        {
+            if (!buffer_.empty()) {
+                std::optional<T> value(std::move(buffer_.front()));
+                buffer_.pop_front();
+                // refill the freed slot from the oldest waiting pusher
+                if (push_awaiter* waiter = pop_waiter(pushers_)) {
+                    buffer_.push_back(std::move(waiter->value_));
+                    waiter->accepted_ = true;
+                    waiter->handle_.resume();
+                }
+                return value;
+            }
+            if (push_awaiter* waiter = pop_waiter(pushers_)) {
+                // capacity 0: take the value straight from the pusher
+                std::optional<T> value(std::move(waiter->value_));
+                waiter->accepted_ = true;
+                waiter->handle_.resume();
+                return value;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Closes the queue and resumes every waiting coroutine.
+         */
+        void close()
+        {
+            closed_ = true;
+            while (pop_awaiter* waiter = pop_waiter(poppers_)) {
+                waiter->handle_.resume();
+            }
+            while (push_awaiter* waiter = pop_waiter(pushers_)) {
+                waiter->handle_.resume();
+            }
+        }
+
+        // clang-format off
+        size_type size()     const noexcept { return buffer_.size();     }
+        size_type capacity() const noexcept { return buffer_.capacity(); }
+        bool      empty()    const noexcept { return buffer_.empty();    }
+        bool      closed()   const noexcept { return closed_;            }
+        // clang-format on
+
+        /**
+         * @brief The awaitable returned by push().
+         */
+        class push_awaiter
+        {
+        public:
+            bool await_ready()
+            {
+                accepted_ = queue_.offer(value_);
+                return accepted_ || queue_.closed_;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                queue_.push_waiter(queue_.pushers_, this);
+            }
+
+            bool await_resume() const noexcept { return accepted_; }
+
+        private:
+            friend class async_ring_buffer;
+
+            push_awaiter(async_ring_buffer& queue, T&& value) : queue_(queue), value_(std::move(value)) {}
+
+            async_ring_buffer&      queue_;
+            T                       value_;
+            bool                    accepted_ = false;
+            std::coroutine_handle<> handle_;
+            push_awaiter*           next_ = nullptr;
+        };
+
+        /**
+         * @brief The awaitable returned by pop().
+         */
+        class pop_awaiter
+        {
+        public:
+            bool await_ready()
+            {
+                result_ = queue_.try_pop();
+                return result_.has_value() || queue_.closed_;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                queue_.push_waiter(queue_.poppers_, this);
+            }
+
+            std::optional<T> await_resume() { return std::move(result_); }
+
+        private:
+            friend class async_ring_buffer;
+
+            explicit pop_awaiter(async_ring_buffer& queue) noexcept : queue_(queue) {}
+
+            async_ring_buffer&      queue_;
+            std::optional<T>        result_;
+            std::coroutine_handle<> handle_;
+            pop_awaiter*            next_ = nullptr;
+        };
+
+    private:
+        // an intrusive FIFO of suspended awaiters, linked through their next_ members
+        template <typename Awaiter>
+        struct waiter_list
+        {
+            Awaiter* head = nullptr;
+            Awaiter* tail = nullptr;
+        };
+
+        template <typename Awaiter>
+        static void push_waiter(waiter_list<Awaiter>& list, Awaiter* waiter) noexcept
+        {
+            waiter->next_ = nullptr;
+            if (list.tail != nullptr) {
+                list.tail->next_ = waiter;
+            } else {
+                list.head = waiter;
+            }
+            list.tail = waiter;
+        }
+
+        template <typename Awaiter>
+        static Awaiter* pop_waiter(waiter_list<Awaiter>& list) noexcept
+        {
+            Awaiter* waiter = list.head;
+            if (waiter != nullptr) {
+                list.head = waiter->next_;
+                if (list.head == nullptr) list.tail = nullptr;
+            }
+            return waiter;
+        }
+
+        // queues value, or hands it to a waiting popper; moves from value only on success
+        bool offer(T& value)
+        {
+            if (closed_) {
+                return false;
+            }
+            if (pop_awaiter* waiter = pop_waiter(poppers_)) {
+                waiter->result_.emplace(std::move(value));
+                waiter->handle_.resume();
+                return true;
+            }
+            if (buffer_.full()) {
+                return false;
+            }
+            buffer_.push_back(std::move(value));
+            return true;
+        }
+
+        ring_buffer<T>            buffer_;
+        waiter_list<push_awaiter> pushers_;
+        waiter_list<pop_awaiter>  poppers_;
+        bool                      closed_ = false;
+    };
+
+    /**
+     * @brief A fire-and-forget coroutine, started by coroutine_executor::spawn.
+     *
+     * The coroutine starts suspended and frees its frame when it finishes. An
+     * exception escaping it terminates the program.
+     */
+    class detached_task
+    {
+    public:
+        struct promise_type
+        {
+            detached_task         get_return_object() noexcept { return detached_task(handle::from_promise(*this)); }
+            std::suspend_always   initial_suspend() noexcept { return {}; }
+            std::suspend_never    final_suspend() noexcept { return {}; }
+            void                  return_void() noexcept {}
+            [[noreturn]] void     unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        using handle = std::coroutine_handle<promise_type>;
+
+        detached_task(detached_task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+        ~detached_task()
+        {
+            // a task that was never started is destroyed with its frame
+            if (handle_) handle_.destroy();
+        }
+
+        // disable copying
+        detached_task(const detached_task&)            = delete;
+        detached_task& operator=(const detached_task&) = delete;
+        detached_task& operator=(detached_task&&)      = delete;
+
+        /**
+         * @brief Gives up ownership of the suspended coroutine, to be resumed once.
+         */
+        handle release() noexcept { return std::exchange(handle_, {}); }
+
+    private:
+        explicit detached_task(handle h) noexcept : handle_(h) {}
+
+        handle handle_;
+    };
+
+    /**
+     * @brief A minimal single-threaded executor for coroutines.
+     *
+     * Keeps a FIFO run queue of coroutine handles in a ring_buffer that doubles when
+     * full. run() resumes them on the calling thread until the queue is empty.
+     * Coroutines blocked on an async_ring_buffer are not in the run queue; the push or
+     * pop that wakes them resumes them directly.
+     */
+    class coroutine_executor
+    {
+    public:
+        /**
+         * @brief Construct a new executor.
+         *
+         * @param capacity The initial capacity of the run queue.
+         */
+        explicit coroutine_executor(std::size_t capacity = DEFAULT_COROUTINE_EXECUTOR_CAPACITY)
+            : ready_(capacity > 0 ? capacity : 1)
+        {
+        }
+
+        // disable copying and moving
+        coroutine_executor(const coroutine_executor&)            = delete;
+        coroutine_executor& operator=(const coroutine_executor&) = delete;
+        coroutine_executor(coroutine_executor&&)                 = delete;
+        coroutine_executor& operator=(coroutine_executor&&)      = delete;
+
+        /**
+         * @brief Queues a suspended coroutine to be resumed by run().
+         */
+        void post(std::coroutine_handle<> handle)
+        {
+            if (ready_.full()) {
+                ready_.set_capacity(ready_.capacity() * 2);
+            }
+            ready_.push_back(handle);
+        }
+
+        /**
+         * @brief Starts a task on this executor.
+         */
+        void spawn(detached_task task) { post(task.release()); }
+
+        /**
+         * @brief Returns an awaitable that moves the awaiting coroutine to the back of the run queue.
+         */
+        auto schedule() noexcept
+        {
+            struct awaiter
+            {
+                coroutine_executor& executor;
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle) { executor.post(handle); }
+                void await_resume() const noexcept {}
+            };
+            return awaiter{*this};
+        }
+
+        /**
+         * @brief Resumes the oldest queued coroutine, if any.
+         *
+         * @return true If a coroutine was resumed.
+         */
+        bool run_one()
+        {
+            if (ready_.empty()) {
+                return false;
+            }
+            std::coroutine_handle<> handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+            return true;
+        }
+
+        /**
+         * @brief Resumes queued coroutines until none is left.
+         *
+         * @return std::size_t The number of coroutines resumed.
+         */
+        std::size_t run()
+        {
+            std::size_t resumed = 0;
+            while (run_one()) {
+                ++resumed;
+            }
+            return resumed;
+        }
+
+        // clang-format off
+        std::size_t pending() const noexcept { return ready_.size(); }
+        // clang-format on
+
+    private:
+        ring_buffer<std::coroutine_handle<>> ready_;
+    };
+
+} // namespace apus
+
+#endif // APUS_ASYNC_RING_BUFFER_HPP
@@ -0,0 +1,198 @@
+#ifndef APUS_CHILD_ARENA_HPP
+#define APUS_CHILD_ARENA_HPP
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+
+#include <apus/config.hpp>
+
+namespace apus
+{
+
+    /**
+     * @brief A bump-pointer arena over a contiguous range it does not own.
+     *
+     * Returned by make_child on memory_arena, paged_memory_arena and child_arena, it
+     * gives a subsystem a fixed budget carved out of a larger arena. The child has its
+     * own bump pointer: it can be reset, or rewound to a marker, without touching the
+     * parent or its siblings. Its memory belongs to the parent and is reclaimed when
+     * the parent is reset, so a child must not be used after that. Carving and
+     * allocating never touch the system allocator.
+     *
+     * Allocating past the budget is a budget overflow. It is counted (overflow_count)
+     * and reported like an exhausted memory_arena: allocate calls the allocation
+     * failure handler and throws std::bad_alloc (see config.hpp), try_allocate returns
+     * nullptr.
+     */
+    class child_arena
+    {
+    public:
+        /**
+         * @brief A position of the bump pointer, to rewind to.
+         */
+        using marker = std::size_t;
+
+        /**
+         * @brief Construct an empty child with no budget.
+         */
+        child_arena() noexcept = default;
+
+        /**
+         * @brief Construct a child over [base, base + capacity).
+         */
+        child_arena(void* base, std::size_t capacity) noexcept
+            : base_(static_cast<std::byte*>(base)), capacity_(capacity) {}
+
+        // disable copying: two children over one range would hand out the same bytes
+        child_arena(const child_arena&)            = delete;
+        child_arena& operator=(const child_arena&) = delete;
+
+        // enable moving; the moved-from child is left empty with no budget
+        child_arena(child_arena&& other) noexcept { swap(other); }
+
+        child_arena& operator=(child_arena&& other) noexcept
+        {
+            child_arena(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Allocate raw memory from the child's budget.
+         *
+         * @return void* Pointer to the allocated memory.
+         * @throws std::bad_alloc If the budget is exhausted (see set_alloc_failure_handler).
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            void* ptr = try_allocate(bytes, alignment);
+            if (ptr == nullptr) {
+                detail::alloc_failure(bytes);
+            }
+            return ptr;
+        }
+
+        /**
+         * @brief Allocate raw memory from the child's budget without failing loudly.
+         *
+         * @return void* Pointer to the allocated memory, or nullptr if the budget is exhausted.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            std::uintptr_t current = reinterpret_cast<std::uintptr_t>(base_) + offset_;
+            std::uintptr_t aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            std::size_t    padding = static_cast<std::size_t>(aligned - current);
+
+            if (padding > capacity_ - offset_ || bytes > capacity_ - offset_ - padding) {
+                ++overflow_count_;
+                return nullptr;
+            }
+
+            offset_ += padding + bytes;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        /**
+         * @brief Allocate memory for a specific type.
+         *
+         * @tparam T The type of object to allocate for.
+         * @param count The number of objects to allocate.
+         * @return T* Pointer to the allocated memory.
+         */
+        template <typename T>
+        T* allocate(std::size_t count = 1)
+        {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Carves a grandchild with a budget of bytes out of this child.
+         *
+         * @throws std::bad_alloc If this child's budget cannot hold it (see set_alloc_failure_handler).
+         */
+        child_arena make_child(std::size_t bytes) { return child_arena(allocate(bytes), bytes); }
+
+        /**
+         * @brief Carves a grandchild with a budget of bytes, or returns nullopt if it does not fit.
+         */
+        std::optional<child_arena> try_make_child(std::size_t bytes) noexcept
+        {
+            void* base = try_allocate(bytes);
+            if (base == nullptr) {
+                return std::nullopt;
+            }
+            return child_arena(base, bytes);
+        }
+
+        /**
+         * @brief Returns the current bump pointer position, for rewind().
+         */
+        marker mark() const noexcept { return offset_; }
+
+        /**
+         * @brief Releases everything allocated since mark returned m.
+         */
+        void rewind(marker m) noexcept
+        {
+            high_water_mark_ = std::max(high_water_mark_, offset_);
+            offset_          = std::min(m, offset_);
+        }
+
+        /**
+         * @brief Releases everything allocated from the child; the parent is not affected.
+         */
+        void reset() noexcept { rewind(0); }
+
+        /**
+         * @brief Returns the number of bytes handed out since the last reset, including alignment padding.
+         */
+        std::size_t used_bytes() const noexcept { return offset_; }
+
+        /**
+         * @brief Returns the number of bytes left in the budget (before alignment of the next allocation).
+         */
+        std::size_t remaining_bytes() const noexcept { return capacity_ - offset_; }
+
+        /**
+         * @brief Returns the budget in bytes.
+         */
+        std::size_t capacity() const noexcept { return capacity_; }
+
+        /**
+         * @brief Returns the highest used_bytes() ever reached, across resets and rewinds.
+         */
+        std::size_t high_water_mark() const noexcept { return std::max(high_water_mark_, offset_); }
+
+        /**
+         * @brief Returns the number of allocations that did not fit in the budget.
+         */
+        std::size_t overflow_count() const noexcept { return overflow_count_; }
+
+        /**
+         * @brief Returns the base address of the child's range.
+         */
+        void* get_base_address() const noexcept { return base_; }
+
+        void swap(child_arena& other) noexcept
+        {
+            std::swap(base_, other.base_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(offset_, other.offset_);
+            std::swap(high_water_mark_, other.high_water_mark_);
+            std::swap(overflow_count_, other.overflow_count_);
+        }
+
+    private:
+        std::byte*  base_            = nullptr;
+        std::size_t capacity_        = 0;
+        std::size_t offset_          = 0; // bytes used since the last reset
+        std::size_t high_water_mark_ = 0; // highest offset_ seen at a reset or rewind
+        std::size_t overflow_count_  = 0; // allocations that exceeded the budget
+    };
+
+} // namespace apus
+
+#endif // APUS_CHILD_ARENA_HPP
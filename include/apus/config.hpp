@@ -0,0 +1,96 @@
+#ifndef APUS_CONFIG_HPP
+#define APUS_CONFIG_HPP
+
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+
+// APUS_EXCEPTIONS is 1 when apus reports errors by throwing. It follows the compiler
+// (0 under -fno-exceptions) and can be forced to 0 by defining APUS_NO_EXCEPTIONS.
+#if !defined(APUS_NO_EXCEPTIONS) && (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define APUS_EXCEPTIONS 1
+#else
+#define APUS_EXCEPTIONS 0
+#endif
+
+namespace apus
+{
+
+    /**
+     * @brief A function called when apus fails to allocate memory, with the requested size.
+     */
+    using alloc_failure_handler = void (*)(std::size_t bytes);
+
+    namespace detail
+    {
+        inline std::atomic<alloc_failure_handler>& alloc_failure_handler_slot() noexcept
+        {
+            static std::atomic<alloc_failure_handler> handler{nullptr};
+            return handler;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Installs the function called when an apus allocation fails.
+     *
+     * The handler sees every failed allocation of a throwing API (an exhausted
+     * memory_arena, a failed page or buffer allocation) and may log, release memory or
+     * terminate. If it returns, apus throws std::bad_alloc, or aborts when built without
+     * exceptions. The try_* functions report failure through their return value instead
+     * and never call the handler.
+     *
+     * @param handler The new handler, or nullptr for none.
+     * @return alloc_failure_handler The previous handler.
+     */
+    inline alloc_failure_handler set_alloc_failure_handler(alloc_failure_handler handler) noexcept
+    {
+        return detail::alloc_failure_handler_slot().exchange(handler);
+    }
+
+    /**
+     * @brief Returns the installed allocation failure handler, or nullptr.
+     */
+    inline alloc_failure_handler get_alloc_failure_handler() noexcept
+    {
+        return detail::alloc_failure_handler_slot().load();
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Reports a failed allocation of `bytes`: calls the handler, then throws
+         * std::bad_alloc or, without exceptions, aborts.
+         */
+        [[noreturn]] inline void alloc_failure(std::size_t bytes)
+        {
+            if (alloc_failure_handler handler = get_alloc_failure_handler()) {
+                handler(bytes);
+            }
+#if APUS_EXCEPTIONS
+            throw std::bad_alloc();
+#else
+            std::fprintf(stderr, "apus: failed to allocate %zu bytes\n", bytes);
+            std::abort();
+#endif
+        }
+
+        /**
+         * @brief Throws `error`, or, without exceptions, prints its message and aborts.
+         */
+        template <typename Error>
+        [[noreturn]] inline void throw_error(const Error& error)
+        {
+#if APUS_EXCEPTIONS
+            throw error;
+#else
+            std::fprintf(stderr, "apus: %s\n", error.what());
+            std::abort();
+#endif
+        }
+    } // namespace detail
+
+} // namespace apus
+
+#endif // APUS_CONFIG_HPP
@@ -0,0 +1,351 @@
+#ifndef APUS_CSR_GRAPH_HPP
+#define APUS_CSR_GRAPH_HPP
+
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+
+#include <apus/config.hpp>
+
+namespace apus
+{
+
+    /**
+     * @brief A read-only view of one row of a csr_graph.
+     *
+     * Offers the read-only interface of small_vector, so code reading
+     * small_vector adjacency lists works on frozen rows unchanged.
+     *
+     * @tparam T The type of the row elements.
+     */
+    template <typename T>
+    class csr_row
+    {
+    public:
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference       = const T&;
+        using const_reference = const T&;
+        using pointer         = const T*;
+        using const_pointer   = const T*;
+        using iterator        = const T*;
+        using const_iterator  = const T*;
+
+        csr_row() noexcept = default;
+        csr_row(const T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+        // clang-format off
+        size_type       size()                  const noexcept { return size_;            }
+        bool            empty()                 const noexcept { return size_ == 0;       }
+        const_reference operator[](size_type i) const noexcept { return data_[i];         }
+        const_reference front()                 const          { return data_[0];         }
+        const_reference back()                  const          { return data_[size_ - 1]; }
+        const_pointer   data()                  const noexcept { return data_;            }
+        // clang-format on
+
+        /**
+         * @brief Accesses an element at a given index with bounds checking.
+         *
+         * @throws std::out_of_range If index is out of bounds.
+         */
+        const_reference at(size_type index) const
+        {
+            if (index >= size_) {
+                detail::throw_error(std::out_of_range("csr_row::at: index out of range"));
+            }
+            return data_[index];
+        }
+
+        /**
+         * @brief Finds an element in the row.
+         *
+         * @return const_iterator Iterator to the found element, or end() if not found.
+         */
+        const_iterator find(const T& value) const { return std::find(begin(), end(), value); }
+
+        /**
+         * @brief Checks if the row contains a given value.
+         */
+        bool contains(const T& value) const { return find(value) != end(); }
+
+        // iterators
+        // clang-format off
+        const_iterator begin()  const noexcept { return data_;         }
+        const_iterator end()    const noexcept { return data_ + size_; }
+        const_iterator cbegin() const noexcept { return data_;         }
+        const_iterator cend()   const noexcept { return data_ + size_; }
+        // clang-format on
+
+    private:
+        const T*  data_ = nullptr;
+        size_type size_ = 0;
+    };
+
+    template <typename T, typename Offset>
+    class csr_builder;
+
+    /**
+     * @brief An immutable graph (or any list of lists) in compressed sparse row form.
+     *
+     * All rows are stored back to back in one edges array, and row r spans
+     * [offsets[r], offsets[r + 1]). Compared with a std::vector of small_vectors this
+     * drops the per-row header (pointer, size, capacity and inline buffer) and the
+     * scattered heap spills, so a traversal streams through two contiguous arrays.
+     *
+     * Build one with csr_builder, or from existing rows with from_rows().
+     *
+     * @tparam T The type of the row elements, typically a node index.
+     * @tparam Offset The type of the row offsets; it bounds the total number of elements.
+     */
+    template <typename T = std::uint32_t, typename Offset = std::uint32_t>
+    class csr_graph
+    {
+    public:
+        using value_type  = T;
+        using offset_type = Offset;
+        using size_type   = std::size_t;
+        using row_type    = csr_row<T>;
+
+        /**
+         * @brief Construct an empty graph.
+         */
+        csr_graph()
+            : offsets_(1, Offset(0)) {}
+
+        /**
+         * @brief Freezes a range of rows (e.g. a std::vector of small_vectors) into a graph.
+         *
+         * @throws std::length_error If the total number of elements does not fit in Offset.
+         */
+        template <typename Rows>
+        static csr_graph from_rows(const Rows& rows)
+        {
+            // row sizes live in the row headers, so sizing the edge array up front is cheap
+            size_type row_count  = 0;
+            size_type edge_count = 0;
+            for (const auto& row : rows) {
+                ++row_count;
+                edge_count += static_cast<size_type>(std::size(row));
+            }
+
+            csr_builder<T, Offset> builder;
+            builder.reserve(row_count, edge_count);
+            for (const auto& row : rows) {
+                builder.add_row(row);
+            }
+            return builder.freeze();
+        }
+
+        /**
+         * @brief Returns a view of row r (no bounds checking).
+         */
+        row_type operator[](size_type r) const noexcept
+        {
+            return row_type(edges_.data() + offsets_[r], static_cast<size_type>(offsets_[r + 1] - offsets_[r]));
+        }
+
+        /**
+         * @brief Returns a view of row r with bounds checking.
+         *
+         * @throws std::out_of_range If r is not a row of the graph.
+         */
+        row_type at(size_type r) const
+        {
+            if (r >= size()) {
+                detail::throw_error(std::out_of_range("csr_graph::at: row out of range"));
+            }
+            return (*this)[r];
+        }
+
+        /**
+         * @brief Returns the number of elements of row r (no bounds checking).
+         */
+        size_type degree(size_type r) const noexcept { return static_cast<size_type>(offsets_[r + 1] - offsets_[r]); }
+
+        /**
+         * @brief Returns the number of rows.
+         */
+        size_type size() const noexcept { return offsets_.size() - 1; }
+
+        /**
+         * @brief Returns true if the graph has no rows.
+         */
+        bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Returns the total number of elements in all rows.
+         */
+        size_type edge_count() const noexcept { return edges_.size(); }
+
+        /**
+         * @brief Returns the size() + 1 row offsets.
+         */
+        const std::vector<Offset>& offsets() const noexcept { return offsets_; }
+
+        /**
+         * @brief Returns the elements of all rows, back to back.
+         */
+        const std::vector<T>& edges() const noexcept { return edges_; }
+
+        /**
+         * @brief Returns the bytes held by the graph, including its arrays.
+         */
+        size_type memory_bytes() const noexcept
+        {
+            return sizeof(*this) + offsets_.capacity() * sizeof(Offset) + edges_.capacity() * sizeof(T);
+        }
+
+    private:
+        friend class csr_builder<T, Offset>;
+
+        csr_graph(std::vector<Offset> offsets, std::vector<T> edges)
+            : offsets_(std::move(offsets)), edges_(std::move(edges)) {}
+
+        std::vector<Offset> offsets_; // size() + 1 entries, offsets_[0] == 0
+        std::vector<T>      edges_;   // all rows, back to back
+    };
+
+    /**
+     * @brief Collects rows or edges and freezes them into a csr_graph.
+     *
+     * Rows can be appended whole with add_row (e.g. from small_vector adjacency lists)
+     * or edge by edge with add_edge, in any order; rows that never get an edge are
+     * empty. freeze() keeps the edges of each row in insertion order. While edges
+     * arrive in row order (always the case with add_row) it just computes the offsets
+     * and hands over the edge array; otherwise it places the edges with one counting
+     * sort pass.
+     *
+     * @tparam T The type of the row elements, typically a node index.
+     * @tparam Offset The type of the row offsets of the frozen graph.
+     */
+    template <typename T = std::uint32_t, typename Offset = std::uint32_t>
+    class csr_builder
+    {
+    public:
+        using size_type = std::size_t;
+
+        /**
+         * @brief Reserves space for rows and edges.
+         */
+        void reserve(size_type rows, size_type edges)
+        {
+            degrees_.reserve(rows);
+            targets_.reserve(edges);
+        }
+
+        /**
+         * @brief Appends the edge from -> to, growing the graph to at least from + 1 rows.
+         */
+        void add_edge(size_type from, const T& to)
+        {
+            if (from >= degrees_.size()) {
+                degrees_.resize(from + 1, 0);
+            }
+            if (sorted_ && from < last_source_) {
+                // the first edge out of row order: remember the row of every edge from now on
+                sources_.reserve(targets_.capacity());
+                for (size_type r = 0; r < degrees_.size(); ++r) {
+                    sources_.insert(sources_.end(), degrees_[r], r);
+                }
+                sorted_ = false;
+            }
+            if (!sorted_) {
+                sources_.push_back(from);
+            }
+            last_source_ = from;
+            ++degrees_[from];
+            targets_.push_back(to);
+        }
+
+        /**
+         * @brief Appends a new row holding the elements of row, and returns its index.
+         */
+        template <typename Row>
+        size_type add_row(const Row& row)
+        {
+            size_type r     = degrees_.size();
+            size_type count = static_cast<size_type>(std::distance(std::begin(row), std::end(row)));
+            degrees_.push_back(count);
+            targets_.insert(targets_.end(), std::begin(row), std::end(row));
+            if (!sorted_) {
+                sources_.insert(sources_.end(), count, r);
+            }
+            last_source_ = r;
+            return r;
+        }
+
+        /**
+         * @brief Grows the graph to at least rows rows; new rows are empty.
+         */
+        void resize_rows(size_type rows)
+        {
+            if (rows > degrees_.size()) {
+                degrees_.resize(rows, 0);
+            }
+        }
+
+        /**
+         * @brief Returns the number of rows so far.
+         */
+        size_type row_count() const noexcept { return degrees_.size(); }
+
+        /**
+         * @brief Returns the number of edges so far.
+         */
+        size_type edge_count() const noexcept { return targets_.size(); }
+
+        /**
+         * @brief Builds the graph and leaves the builder empty.
+         *
+         * @throws std::length_error If the number of edges does not fit in Offset.
+         */
+        csr_graph<T, Offset> freeze()
+        {
+            if (targets_.size() > static_cast<size_type>(std::numeric_limits<Offset>::max())) {
+                detail::throw_error(std::length_error("csr_builder::freeze: too many edges for the offset type"));
+            }
+
+            std::vector<Offset> offsets(degrees_.size() + 1);
+            offsets[0] = 0;
+            for (size_type r = 0; r < degrees_.size(); ++r) {
+                offsets[r + 1] = static_cast<Offset>(offsets[r] + degrees_[r]);
+            }
+
+            std::vector<T> edges;
+            if (sorted_) {
+                edges = std::move(targets_);
+                edges.shrink_to_fit();
+            } else {
+                // counting sort by row; stable, so each row keeps its insertion order
+                edges.resize(targets_.size());
+                std::vector<Offset> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_type i = 0; i < targets_.size(); ++i) {
+                    edges[cursor[sources_[i]]++] = std::move(targets_[i]);
+                }
+            }
+
+            degrees_.clear();
+            targets_.clear();
+            sources_.clear();
+            sorted_      = true;
+            last_source_ = 0;
+            return csr_graph<T, Offset>(std::move(offsets), std::move(edges));
+        }
+
+    private:
+        std::vector<size_type> degrees_;         // edges per row
+        std::vector<T>         targets_;         // edges in insertion order
+        std::vector<size_type> sources_;         // row of each edge, kept once edges arrive out of row order
+        bool                   sorted_      = true;
+        size_type              last_source_ = 0;
+    };
+
+} // namespace apus
+
+#endif // APUS_CSR_GRAPH_HPP
@@ -0,0 +1,814 @@
+#ifndef APUS_FLAT_HASH_MAP_HPP
+#define APUS_FLAT_HASH_MAP_HPP
+
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <memory_resource>
+#include <apus/config.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APUS_FLAT_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace apus
+{
+
+    // alignment of the flat_hash_map storage block (one cache line)
+    static constexpr std::size_t FLAT_HASH_MAP_ALIGNMENT = 64;
+
+    namespace detail
+    {
+
+        // control byte of a slot: empty, deleted, or the 7-bit H2 fragment of a full slot's hash
+        using ctrl_t = std::int8_t;
+
+        static constexpr ctrl_t      CTRL_EMPTY   = -128; // 0b10000000
+        static constexpr ctrl_t      CTRL_DELETED = -2;   // 0b11111110
+        static constexpr std::size_t GROUP_WIDTH  = 16;   // slots probed at once
+
+        /**
+         * @brief Index of the lowest set bit of a non-zero mask.
+         */
+        inline std::uint32_t lowest_bit_index(std::uint32_t mask) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::uint32_t>(__builtin_ctz(mask));
+#else
+            std::uint32_t index = 0;
+            while ((mask & 1u) == 0) {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        /**
+         * @brief Scrambles a user hash so that both the H1 (group) and H2 (tag) parts are well distributed.
+         *
+         * std::hash for integers is usually the identity, which would put every small key into the same group.
+         */
+        inline std::uint64_t mix_hash(std::size_t hash) noexcept
+        {
+            std::uint64_t x = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+            return x ^ (x >> 32);
+        }
+
+        /**
+         * @brief A group of GROUP_WIDTH control bytes matched in parallel.
+         *
+         * Uses SSE2 when available and a scalar loop otherwise. Each match returns
+         * a bitmask where bit i is set if the i-th control byte of the group matches.
+         */
+        class ctrl_group
+        {
+        public:
+            explicit ctrl_group(const ctrl_t* pos) noexcept
+            {
+#ifdef APUS_FLAT_HASH_MAP_SSE2
+                ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+#else
+                std::memcpy(ctrl_, pos, GROUP_WIDTH);
+#endif
+            }
+
+            std::uint32_t match(ctrl_t h2) const noexcept
+            {
+#ifdef APUS_FLAT_HASH_MAP_SSE2
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+                    mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+                }
+                return mask;
+#endif
+            }
+
+            std::uint32_t match_empty() const noexcept
+            {
+                return match(CTRL_EMPTY);
+            }
+
+            // empty and deleted are the only control bytes with the sign bit set
+            std::uint32_t match_empty_or_deleted() const noexcept
+            {
+#ifdef APUS_FLAT_HASH_MAP_SSE2
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+                    mask |= static_cast<std::uint32_t>(ctrl_[i] < 0) << i;
+                }
+                return mask;
+#endif
+            }
+
+        private:
+#ifdef APUS_FLAT_HASH_MAP_SSE2
+            __m128i ctrl_;
+#else
+            ctrl_t ctrl_[GROUP_WIDTH];
+#endif
+        };
+
+        template <typename T, typename = void>
+        struct is_transparent : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type
+        {
+        };
+
+    } // namespace detail
+
+    /**
+     * @brief An open-addressing hash map with SwissTable-style control bytes.
+     *
+     * Keys and values are stored inline in a single flat array of slots, next to
+     * an array of one-byte control tags. Lookups hash the key once, then probe
+     * groups of 16 control bytes in parallel (SSE2, or a scalar fallback) and only
+     * compare keys whose 7-bit tag matches. The storage block is cache-line aligned
+     * and comes from a std::pmr::memory_resource, so it can be backed by an
+     * apus::memory_arena.
+     *
+     * Heterogeneous lookup is enabled when both Hash and KeyEqual define is_transparent.
+     *
+     * Pointers and iterators are invalidated by any insertion that grows the table.
+     * Erasure never moves other elements.
+     *
+     * @tparam K The key type.
+     * @tparam V The mapped type.
+     * @tparam Hash The hash function for keys.
+     * @tparam KeyEqual The equality comparison for keys.
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    class flat_hash_map
+    {
+        static constexpr bool is_transparent_lookup =
+            detail::is_transparent<Hash>::value && detail::is_transparent<KeyEqual>::value;
+
+        template <typename K2>
+        using enable_if_transparent_t = std::enable_if_t<is_transparent_lookup && !std::is_convertible_v<const K2&, const K&>>;
+
+    public:
+        using key_type        = K;
+        using mapped_type     = V;
+        using value_type      = std::pair<K, V>;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher          = Hash;
+        using key_equal       = KeyEqual;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using pointer         = value_type*;
+        using const_pointer   = const value_type*;
+
+        // unified iterator template for both const and non-const iteration
+        template <bool IsConst>
+        class basic_iterator
+        {
+            friend class flat_hash_map;
+            using map_ptr_type = std::conditional_t<IsConst, const flat_hash_map*, flat_hash_map*>;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = typename flat_hash_map::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+            using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+            basic_iterator() : map_ptr_(nullptr), index_(0) {}
+            basic_iterator(map_ptr_type map_ptr, size_type index)
+                : map_ptr_(map_ptr), index_(index) { advance_to_valid(); }
+
+            // support conversion from non-const to const iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            basic_iterator(const basic_iterator<OtherConst>& other)
+                : map_ptr_(other.map_ptr_), index_(other.index_) {}
+
+            reference operator*() const { return map_ptr_->slots_[index_]; }
+            pointer   operator->() const { return map_ptr_->slots_ + index_; }
+
+            basic_iterator& operator++()
+            {
+                ++index_;
+                advance_to_valid();
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                basic_iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            bool operator==(const basic_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const basic_iterator& other) const { return index_ != other.index_; }
+
+        private:
+            void advance_to_valid()
+            {
+                while (index_ < map_ptr_->capacity_ && map_ptr_->ctrl_[index_] < 0) {
+                    ++index_;
+                }
+            }
+
+            map_ptr_type map_ptr_;
+            size_type    index_;
+        };
+
+        using iterator       = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        /**
+         * @brief Construct an empty map. No memory is allocated until the first insertion.
+         *
+         * @param resource The memory resource that provides the slot storage.
+         */
+        explicit flat_hash_map(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : resource_(resource) {}
+
+        /**
+         * @brief Construct an empty map with room for at least count elements.
+         *
+         * @param count The number of elements to reserve space for.
+         * @param resource The memory resource that provides the slot storage.
+         */
+        explicit flat_hash_map(size_type count, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : resource_(resource)
+        {
+            reserve(count);
+        }
+
+        /**
+         * @brief Copy constructor. The copy shares the memory resource of other.
+         */
+        flat_hash_map(const flat_hash_map& other)
+            : hash_(other.hash_), equal_(other.equal_), resource_(other.resource_)
+        {
+            reserve(other.size_);
+            for (const auto& item : other) {
+                insert_unique(item);
+            }
+        }
+
+        /**
+         * @brief Move constructor.
+         */
+        flat_hash_map(flat_hash_map&& other) noexcept
+            : hash_(std::move(other.hash_)), equal_(std::move(other.equal_)), resource_(other.resource_)
+        {
+            steal(other);
+        }
+
+        /**
+         * @brief Destructor.
+         */
+        ~flat_hash_map()
+        {
+            destroy_slots();
+            release_storage();
+        }
+
+        /**
+         * @brief Copy assignment operator.
+         */
+        flat_hash_map& operator=(const flat_hash_map& other)
+        {
+            if (this != &other) {
+                flat_hash_map temp(other);
+                *this = std::move(temp);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator.
+         */
+        flat_hash_map& operator=(flat_hash_map&& other) noexcept
+        {
+            if (this != &other) {
+                destroy_slots();
+                release_storage();
+                hash_     = std::move(other.hash_);
+                equal_    = std::move(other.equal_);
+                resource_ = other.resource_;
+                steal(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Inserts a key-value pair if the key is not present.
+         *
+         * @param value The pair to insert.
+         * @return std::pair<iterator, bool> Iterator to the element with that key, and whether insertion took place.
+         */
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        /**
+         * @brief Inserts a key-value pair if the key is not present, using move semantics.
+         *
+         * @param value The pair to insert.
+         * @return std::pair<iterator, bool> Iterator to the element with that key, and whether insertion took place.
+         */
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        /**
+         * @brief Inserts a range of key-value pairs.
+         *
+         * For forward ranges, the table is reserved once up front instead of growing incrementally.
+         *
+         * @param first Iterator to the first pair.
+         * @param last Iterator past the last pair.
+         */
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            using category = typename std::iterator_traits<InputIt>::iterator_category;
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+                reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+
+        /**
+         * @brief Constructs the mapped value in-place if the key is not present.
+         *
+         * Unlike emplace, the arguments are not consumed when the key already exists.
+         *
+         * @param key The key to insert.
+         * @param args Arguments to construct the mapped value with.
+         * @return std::pair<iterator, bool> Iterator to the element with that key, and whether insertion took place.
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            return try_emplace_impl(key, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Constructs the mapped value in-place if the key is not present (movable key).
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+        {
+            return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Constructs a key-value pair from args and inserts it if the key is not present.
+         *
+         * @param args Arguments to construct a value_type with.
+         * @return std::pair<iterator, bool> Iterator to the element with that key, and whether insertion took place.
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Inserts a key-value pair, or assigns the value if the key already exists.
+         *
+         * @param key The key to insert or update.
+         * @param value The value to assign.
+         * @return std::pair<iterator, bool> Iterator to the element, and whether insertion took place.
+         */
+        template <typename M>
+        std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value)
+        {
+            auto result = try_emplace(key, std::forward<M>(value));
+            if (!result.second) {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Accesses the value for key, default-constructing it if the key is not present.
+         */
+        mapped_type& operator[](const key_type& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        /**
+         * @brief Accesses the value for key, default-constructing it if the key is not present (movable key).
+         */
+        mapped_type& operator[](key_type&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        /**
+         * @brief Accesses the value for key with bounds checking.
+         *
+         * @param key The key to look up.
+         * @return mapped_type& Reference to the mapped value.
+         * @throws std::out_of_range If the key is not present.
+         */
+        mapped_type& at(const key_type& key)
+        {
+            size_type index = find_index(key);
+            if (index == capacity_) {
+                detail::throw_error(std::out_of_range("flat_hash_map::at: key not found"));
+            }
+            return slots_[index].second;
+        }
+
+        /**
+         * @brief Accesses the value for key with bounds checking (const version).
+         *
+         * @param key The key to look up.
+         * @return const mapped_type& Reference to the mapped value.
+         * @throws std::out_of_range If the key is not present.
+         */
+        const mapped_type& at(const key_type& key) const
+        {
+            size_type index = find_index(key);
+            if (index == capacity_) {
+                detail::throw_error(std::out_of_range("flat_hash_map::at: key not found"));
+            }
+            return slots_[index].second;
+        }
+
+        /**
+         * @brief Finds the element with the given key.
+         *
+         * @param key The key to look up.
+         * @return iterator Iterator to the element, or end() if not found.
+         */
+        iterator find(const key_type& key) { return iterator(this, find_index(key)); }
+
+        /**
+         * @brief Finds the element with the given key (const version).
+         */
+        const_iterator find(const key_type& key) const { return const_iterator(this, find_index(key)); }
+
+        /**
+         * @brief Finds the element with a key equivalent to key (heterogeneous lookup).
+         */
+        template <typename K2, typename = enable_if_transparent_t<K2>>
+        iterator find(const K2& key) { return iterator(this, find_index(key)); }
+
+        /**
+         * @brief Finds the element with a key equivalent to key (heterogeneous lookup, const version).
+         */
+        template <typename K2, typename = enable_if_transparent_t<K2>>
+        const_iterator find(const K2& key) const { return const_iterator(this, find_index(key)); }
+
+        /**
+         * @brief Checks if the map contains the given key.
+         */
+        bool contains(const key_type& key) const { return find_index(key) != capacity_; }
+
+        /**
+         * @brief Checks if the map contains a key equivalent to key (heterogeneous lookup).
+         */
+        template <typename K2, typename = enable_if_transparent_t<K2>>
+        bool contains(const K2& key) const { return find_index(key) != capacity_; }
+
+        /**
+         * @brief Returns the number of elements with the given key (0 or 1).
+         */
+        size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Removes the element with the given key.
+         *
+         * @param key The key to remove.
+         * @return size_type The number of elements removed (0 or 1).
+         */
+        size_type erase(const key_type& key)
+        {
+            size_type index = find_index(key);
+            if (index == capacity_) {
+                return 0;
+            }
+            erase_at(index);
+            return 1;
+        }
+
+        /**
+         * @brief Removes the element at the given position.
+         *
+         * @param pos Iterator to the element to remove.
+         * @return iterator Iterator following the removed element.
+         */
+        iterator erase(const_iterator pos)
+        {
+            erase_at(pos.index_);
+            return iterator(this, pos.index_ + 1);
+        }
+
+        /**
+         * @brief Removes the element at the given position.
+         */
+        iterator erase(iterator pos)
+        {
+            return erase(const_iterator(pos));
+        }
+
+        /**
+         * @brief Removes all elements, keeping the allocated storage.
+         */
+        void clear() noexcept
+        {
+            destroy_slots();
+            if (capacity_ > 0) {
+                std::memset(ctrl_, static_cast<unsigned char>(detail::CTRL_EMPTY), capacity_);
+            }
+            size_        = 0;
+            growth_left_ = max_load(capacity_);
+        }
+
+        /**
+         * @brief Reserves space for at least count elements without exceeding the maximum load factor.
+         *
+         * @param count The number of elements to reserve space for.
+         */
+        void reserve(size_type count)
+        {
+            size_type new_capacity = capacity_for(count);
+            if (new_capacity > capacity_) {
+                rehash_to(new_capacity);
+            }
+        }
+
+        // clang-format off
+        size_type size()            const noexcept { return size_;     }
+        size_type capacity()        const noexcept { return capacity_; }
+        bool      empty()           const noexcept { return size_ == 0; }
+        float     load_factor()     const noexcept { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_); }
+        float     max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+        hasher                     hash_function() const { return hash_;     }
+        key_equal                  key_eq()        const { return equal_;    }
+        std::pmr::memory_resource* resource()      const { return resource_; }
+
+        iterator       begin()        { return iterator(this, 0);                }
+        iterator       end()          { return iterator(this, capacity_);        }
+        const_iterator begin()  const { return const_iterator(this, 0);          }
+        const_iterator end()    const { return const_iterator(this, capacity_);  }
+        const_iterator cbegin() const { return const_iterator(this, 0);          }
+        const_iterator cend()   const { return const_iterator(this, capacity_);  }
+        // clang-format on
+
+    private:
+        // maximum number of full slots for a given capacity (7/8 load factor)
+        static size_type max_load(size_type capacity) noexcept
+        {
+            return capacity - capacity / 8;
+        }
+
+        // smallest power-of-two capacity (at least one group) that holds count elements
+        static size_type capacity_for(size_type count) noexcept
+        {
+            if (count == 0) return 0;
+            size_type capacity = detail::GROUP_WIDTH;
+            while (max_load(capacity) < count) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        // slots start on the first cache line after the control bytes
+        static size_type slots_offset(size_type capacity) noexcept
+        {
+            return (capacity + storage_alignment() - 1) & ~(storage_alignment() - 1);
+        }
+
+        static constexpr size_type storage_alignment() noexcept
+        {
+            return alignof(value_type) > FLAT_HASH_MAP_ALIGNMENT ? alignof(value_type) : FLAT_HASH_MAP_ALIGNMENT;
+        }
+
+        static size_type storage_bytes(size_type capacity) noexcept
+        {
+            return slots_offset(capacity) + capacity * sizeof(value_type);
+        }
+
+        template <typename K2>
+        size_type find_index(const K2& key) const
+        {
+            return find_index(key, hash_(key));
+        }
+
+        template <typename K2>
+        size_type find_index(const K2& key, std::size_t hash) const
+        {
+            if (size_ == 0) {
+                return capacity_;
+            }
+
+            std::uint64_t mixed = detail::mix_hash(hash);
+            auto          h2    = static_cast<detail::ctrl_t>(mixed & 0x7F);
+            size_type     group = static_cast<size_type>(mixed >> 7) & group_mask_;
+
+            // triangular probing over groups visits every group once for a power-of-two group count
+            for (size_type step = 1;; ++step) {
+                size_type          base = group * detail::GROUP_WIDTH;
+                detail::ctrl_group ctrl(ctrl_ + base);
+
+                for (std::uint32_t mask = ctrl.match(h2); mask != 0; mask &= mask - 1) {
+                    size_type index = base + detail::lowest_bit_index(mask);
+                    if (equal_(slots_[index].first, key)) {
+                        return index;
+                    }
+                }
+
+                // a lookup never has to look past a group with an empty slot
+                if (ctrl.match_empty() != 0) {
+                    return capacity_;
+                }
+                group = (group + step) & group_mask_;
+            }
+        }
+
+        // first empty or deleted slot along the probe sequence of hash
+        size_type find_insert_index(std::size_t hash) const noexcept
+        {
+            size_type group = static_cast<size_type>(detail::mix_hash(hash) >> 7) & group_mask_;
+            for (size_type step = 1;; ++step) {
+                size_type     base = group * detail::GROUP_WIDTH;
+                std::uint32_t mask = detail::ctrl_group(ctrl_ + base).match_empty_or_deleted();
+                if (mask != 0) {
+                    return base + detail::lowest_bit_index(mask);
+                }
+                group = (group + step) & group_mask_;
+            }
+        }
+
+        template <typename KArg, typename... Args>
+        std::pair<iterator, bool> try_emplace_impl(KArg&& key, Args&&... args)
+        {
+            std::size_t hash  = hash_(key);
+            size_type   index = find_index(key, hash);
+            if (index != capacity_) {
+                return {iterator(this, index), false};
+            }
+
+            index = prepare_insert(hash);
+            new (slots_ + index) value_type(std::piecewise_construct,
+                std::forward_as_tuple(std::forward<KArg>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            commit_insert(index, hash);
+            return {iterator(this, index), true};
+        }
+
+        // inserts a value known not to be present (used for copies)
+        void insert_unique(const value_type& value)
+        {
+            std::size_t hash  = hash_(value.first);
+            size_type   index = prepare_insert(hash);
+            new (slots_ + index) value_type(value);
+            commit_insert(index, hash);
+        }
+
+        // returns the slot a new element with the given hash should be constructed in, growing if needed
+        size_type prepare_insert(std::size_t hash)
+        {
+            if (capacity_ == 0) {
+                rehash_to(detail::GROUP_WIDTH);
+            }
+
+            size_type index = find_insert_index(hash);
+            if (growth_left_ == 0 && ctrl_[index] == detail::CTRL_EMPTY) {
+                // reclaim tombstones in place if they are what fills the table, otherwise grow
+                rehash_to(size_ + 1 <= max_load(capacity_) / 2 ? capacity_ : capacity_ * 2);
+                index = find_insert_index(hash);
+            }
+            return index;
+        }
+
+        void commit_insert(size_type index, std::size_t hash) noexcept
+        {
+            if (ctrl_[index] == detail::CTRL_EMPTY) {
+                --growth_left_;
+            }
+            ctrl_[index] = static_cast<detail::ctrl_t>(detail::mix_hash(hash) & 0x7F);
+            ++size_;
+        }
+
+        void erase_at(size_type index)
+        {
+            slots_[index].~value_type();
+            --size_;
+
+            // if the group still has an empty slot, no probe sequence continues past it,
+            // so the slot can become empty again instead of a tombstone
+            size_type base = index & ~(detail::GROUP_WIDTH - 1);
+            if (detail::ctrl_group(ctrl_ + base).match_empty() != 0) {
+                ctrl_[index] = detail::CTRL_EMPTY;
+                ++growth_left_;
+            } else {
+                ctrl_[index] = detail::CTRL_DELETED;
+            }
+        }
+
+        void rehash_to(size_type new_capacity)
+        {
+            void* storage = resource_->allocate(storage_bytes(new_capacity), storage_alignment());
+
+            detail::ctrl_t* old_ctrl     = ctrl_;
+            value_type*     old_slots    = slots_;
+            size_type       old_capacity = capacity_;
+
+            ctrl_        = static_cast<detail::ctrl_t*>(storage);
+            slots_       = reinterpret_cast<value_type*>(static_cast<std::byte*>(storage) + slots_offset(new_capacity));
+            capacity_    = new_capacity;
+            group_mask_  = new_capacity / detail::GROUP_WIDTH - 1;
+            growth_left_ = max_load(new_capacity) - size_;
+            std::memset(ctrl_, static_cast<unsigned char>(detail::CTRL_EMPTY), new_capacity);
+
+            for (size_type i = 0; i < old_capacity; ++i) {
+                if (old_ctrl[i] < 0) continue;
+
+                std::size_t hash  = hash_(old_slots[i].first);
+                size_type   index = find_insert_index(hash);
+                new (slots_ + index) value_type(std::move(old_slots[i]));
+                old_slots[i].~value_type();
+                ctrl_[index] = old_ctrl[i];
+            }
+
+            if (old_capacity > 0) {
+                resource_->deallocate(old_ctrl, storage_bytes(old_capacity), storage_alignment());
+            }
+        }
+
+        void destroy_slots() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                for (size_type i = 0; i < capacity_; ++i) {
+                    if (ctrl_[i] >= 0) {
+                        slots_[i].~value_type();
+                    }
+                }
+            }
+        }
+
+        void release_storage() noexcept
+        {
+            if (capacity_ > 0) {
+                resource_->deallocate(ctrl_, storage_bytes(capacity_), storage_alignment());
+            }
+            ctrl_        = nullptr;
+            slots_       = nullptr;
+            capacity_    = 0;
+            group_mask_  = 0;
+            size_        = 0;
+            growth_left_ = 0;
+        }
+
+        void steal(flat_hash_map& other) noexcept
+        {
+            ctrl_        = other.ctrl_;
+            slots_       = other.slots_;
+            capacity_    = other.capacity_;
+            group_mask_  = other.group_mask_;
+            size_        = other.size_;
+            growth_left_ = other.growth_left_;
+
+            other.ctrl_        = nullptr;
+            other.slots_       = nullptr;
+            other.capacity_    = 0;
+            other.group_mask_  = 0;
+            other.size_        = 0;
+            other.growth_left_ = 0;
+        }
+
+        detail::ctrl_t*            ctrl_        = nullptr; // one control byte per slot
+        value_type*                slots_       = nullptr; // key-value storage, parallel to ctrl_
+        size_type                  capacity_    = 0;       // number of slots (0 or a power of two >= GROUP_WIDTH)
+        size_type                  group_mask_  = 0;       // number of groups - 1
+        size_type                  size_        = 0;       // number of full slots
+        size_type                  growth_left_ = 0;       // empty slots that may still be filled before rehashing
+        Hash                       hash_;
+        KeyEqual                   equal_;
+        std::pmr::memory_resource* resource_;
+    };
+
+} // namespace apus
+
+#endif // APUS_FLAT_HASH_MAP_HPP
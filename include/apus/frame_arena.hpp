@@ -0,0 +1,197 @@
+#ifndef APUS_FRAME_ARENA_HPP
+#define APUS_FRAME_ARENA_HPP
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+#include <apus/config.hpp>
+#include <apus/page_source.hpp>
+#include <apus/stats_policy.hpp>
+#include <apus/paged_memory_arena.hpp>
+
+namespace apus
+{
+
+    // page size of the per-frame arenas of a frame_arena
+    static constexpr std::size_t DEFAULT_FRAME_ARENA_PAGE_SIZE = 64 * 1024;
+
+    /**
+     * @brief A ring of Frames paged_memory_arenas for frame-scoped data that outlives its frame.
+     *
+     * Frame n allocates from arena n % Frames. begin_frame(n) resets that arena, which
+     * last served frame n - Frames, and leaves the other Frames - 1 frames' data alone.
+     * A pipeline whose last stage releases a frame's data k frames after the first
+     * stage allocated it needs Frames > k. Every allocation is a bump in the current
+     * frame's arena, and memory is bounded by Frames arenas, each trimmed to one page
+     * on reset.
+     *
+     * When the stage that releases frames runs on another thread, it calls
+     * retire(n) once it is done with frame n's data, and the allocating thread starts
+     * frames with try_begin_frame, which refuses to reset an arena whose frame has not
+     * retired yet. retire is the only function that may be called from other threads;
+     * begin_frame and allocation belong to one thread.
+     *
+     * @tparam Frames The number of frames whose data is alive at once.
+     * @tparam PageSizeInBytes The page size of each frame's paged_memory_arena.
+     * @tparam Stats The stats policy of each frame's arena (see stats_policy.hpp).
+     * @tparam PageSource Where pages come from (see page_source.hpp).
+     */
+    template <std::size_t Frames, std::size_t PageSizeInBytes = DEFAULT_FRAME_ARENA_PAGE_SIZE, typename Stats = null_stats, typename PageSource = heap_page_source>
+    class frame_arena
+    {
+        static_assert(Frames > 0, "Frames must be greater than 0");
+
+        // frame number of a slot that has not served a frame yet
+        static constexpr std::uint64_t NO_FRAME = std::numeric_limits<std::uint64_t>::max();
+
+    public:
+        using arena_type = paged_memory_arena<PageSizeInBytes, Stats, PageSource>;
+
+        /**
+         * @brief Construct a new frame arena. Start the first frame with begin_frame before allocating.
+         */
+        frame_arena() { slot_frames_.fill(NO_FRAME); }
+
+        // disable copying and moving
+        frame_arena(const frame_arena&)            = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+        frame_arena(frame_arena&&)                 = delete;
+        frame_arena& operator=(frame_arena&&)      = delete;
+
+        /**
+         * @brief Starts frame n, releasing the data of frame n - Frames.
+         *
+         * Does not check retirement: the caller knows frame n - Frames is done.
+         *
+         * @throws std::logic_error If n is not later than the current frame.
+         */
+        void begin_frame(std::uint64_t n)
+        {
+            if (n <= current_ && started_) {
+                detail::throw_error(std::logic_error("frame_arena::begin_frame: frames must be started in increasing order"));
+            }
+            start(n);
+        }
+
+        /**
+         * @brief Starts frame n if the frame that last used its arena has retired.
+         *
+         * @return true If frame n was started; false if its arena is still in use.
+         * @throws std::logic_error If n is not later than the current frame.
+         */
+        bool try_begin_frame(std::uint64_t n)
+        {
+            if (n <= current_ && started_) {
+                detail::throw_error(std::logic_error("frame_arena::try_begin_frame: frames must be started in increasing order"));
+            }
+            std::uint64_t previous = slot_frames_[n % Frames];
+            if (previous != NO_FRAME && retired_[n % Frames].load(std::memory_order_acquire) != previous + 1) {
+                return false;
+            }
+            start(n);
+            return true;
+        }
+
+        /**
+         * @brief Marks frame n as done, so try_begin_frame may reuse its arena. May be called from any thread.
+         */
+        void retire(std::uint64_t n) noexcept
+        {
+            // stores n + 1 so that 0 means "nothing retired"; release publishes the reads of the frame's data
+            retired_[n % Frames].store(n + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Allocate raw memory in the current frame.
+         *
+         * @return void* Pointer to the allocated memory, or nullptr if bytes > PageSizeInBytes.
+         * @throws std::bad_alloc If a new page cannot be allocated (see set_alloc_failure_handler).
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            return current_arena().allocate(bytes, alignment);
+        }
+
+        /**
+         * @brief Allocate raw memory in the current frame without failing loudly.
+         *
+         * @return void* Pointer to the allocated memory, or nullptr.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            return current_arena().try_allocate(bytes, alignment);
+        }
+
+        /**
+         * @brief Allocate memory for count objects of type T in the current frame.
+         */
+        template <typename T>
+        T* allocate(std::size_t count = 1)
+        {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Returns the number of the current frame.
+         */
+        std::uint64_t current_frame() const noexcept { return current_; }
+
+        /**
+         * @brief Returns the arena of the current frame.
+         */
+        arena_type& current_arena() noexcept { return arenas_[current_ % Frames]; }
+
+        /**
+         * @brief Returns the arena frame n allocates from, which it shares with frames n +/- Frames.
+         */
+        arena_type& arena_of(std::uint64_t n) noexcept { return arenas_[n % Frames]; }
+
+        /**
+         * @brief Returns the bytes in use across all live frames.
+         */
+        std::size_t used_bytes() const noexcept
+        {
+            std::size_t total = 0;
+            for (const auto& arena : arenas_) total += arena.used_bytes();
+            return total;
+        }
+
+        /**
+         * @brief Returns the pages held across all frames.
+         */
+        std::size_t page_count() const noexcept
+        {
+            std::size_t total = 0;
+            for (const auto& arena : arenas_) total += arena.page_count();
+            return total;
+        }
+
+        /**
+         * @brief Returns the number of frames whose data is alive at once.
+         */
+        static constexpr std::size_t frames() noexcept { return Frames; }
+
+    private:
+        void start(std::uint64_t n)
+        {
+            arenas_[n % Frames].reset();
+            slot_frames_[n % Frames] = n;
+            current_                 = n;
+            started_                 = true;
+        }
+
+        std::array<arena_type, Frames>                 arenas_;
+        std::array<std::uint64_t, Frames>              slot_frames_; // frame last started in each arena, or NO_FRAME
+        std::array<std::atomic<std::uint64_t>, Frames> retired_{};   // last retired frame of each arena, plus one
+        std::uint64_t                                  current_ = 0;
+        bool                                           started_ = false; // begin_frame called at least once
+    };
+
+} // namespace apus
+
+#endif // APUS_FRAME_ARENA_HPP
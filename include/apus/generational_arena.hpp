@@ -0,0 +1,267 @@
+#ifndef APUS_GENERATIONAL_ARENA_HPP
+#define APUS_GENERATIONAL_ARENA_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include <apus/config.hpp>
+#include <apus/page_source.hpp>
+#include <apus/stats_policy.hpp>
+#include <apus/paged_memory_arena.hpp>
+
+namespace apus
+{
+
+    // page size of the nursery and the old generation of a generational_arena
+    static constexpr std::size_t DEFAULT_GENERATIONAL_ARENA_PAGE_SIZE = 64 * 1024;
+
+    /**
+     * @brief A two-generation arena: a nursery that is reset wholesale, and an old generation for survivors.
+     *
+     * Objects are bump-allocated in the nursery with construct. The few that must
+     * outlive the current request are registered with promote(ref), where ref is the
+     * caller's pointer to the object. reset() relocates every registered object into
+     * the old generation, rewrites its ref to the new address, and then resets the
+     * nursery. Only survivors are copied; everything else is dropped with the nursery's
+     * pages.
+     *
+     * Relocation move-constructs the object into the old generation by default. A
+     * relocate hook can be passed to promote instead, for objects that point at other
+     * nursery memory (strings, arrays) and must copy it along. Objects are never
+     * destroyed, so they must be trivially destructible. clear() releases the old
+     * generation too, e.g. when a session ends.
+     *
+     * @tparam PageSizeInBytes The page size of both generations; also the largest object.
+     * @tparam Stats The stats policy of both generations (see stats_policy.hpp).
+     * @tparam PageSource Where pages come from (see page_source.hpp).
+     */
+    template <std::size_t PageSizeInBytes = DEFAULT_GENERATIONAL_ARENA_PAGE_SIZE, typename Stats = null_stats, typename PageSource = heap_page_source>
+    class generational_arena
+    {
+    public:
+        using arena_type = paged_memory_arena<PageSizeInBytes, Stats, PageSource>;
+
+        /**
+         * @brief Construct a new generational arena.
+         */
+        generational_arena()
+            : generational_arena(PageSource()) {}
+
+        /**
+         * @brief Construct a new generational arena whose generations take their pages from source.
+         */
+        explicit generational_arena(PageSource source)
+            : nursery_(source), old_(std::move(source)) {}
+
+        // disable copying and moving
+        generational_arena(const generational_arena&)            = delete;
+        generational_arena& operator=(const generational_arena&) = delete;
+        generational_arena(generational_arena&&)                 = delete;
+        generational_arena& operator=(generational_arena&&)      = delete;
+
+        /**
+         * @brief Constructs an object in the nursery.
+         *
+         * @param args Arguments forwarded to the constructor of T.
+         * @return T* The object, valid until the next reset unless promoted.
+         * @throws std::bad_alloc If a new page cannot be allocated (see set_alloc_failure_handler).
+         */
+        template <typename T, typename... Args>
+        T* construct(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "objects in a generational_arena are never destroyed");
+            static_assert(sizeof(T) <= PageSizeInBytes, "generational_arena::construct: object larger than a page");
+
+            return new (nursery_.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Constructs an object in the nursery, or returns nullptr if a new page cannot be allocated.
+         */
+        template <typename T, typename... Args>
+        T* try_construct(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "objects in a generational_arena are never destroyed");
+            static_assert(sizeof(T) <= PageSizeInBytes, "generational_arena::try_construct: object larger than a page");
+
+            void* ptr = nursery_.try_allocate(sizeof(T), alignof(T));
+            return ptr == nullptr ? nullptr : new (ptr) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Allocate raw memory in the nursery, e.g. for buffers that nursery objects point at.
+         *
+         * @return void* Pointer to the allocated memory, or nullptr if bytes > PageSizeInBytes.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            return nursery_.allocate(bytes, alignment);
+        }
+
+        /**
+         * @brief Registers the nursery object ref points at as a survivor of the next reset.
+         *
+         * At reset the object is move-constructed into the old generation and ref is set to
+         * the copy. ref must outlive the reset, so it must not live in the nursery, and each
+         * object must be promoted once.
+         */
+        template <typename T>
+        void promote(T*& ref)
+        {
+            promote(ref, [](T& object, arena_type& old) { return new (old.allocate(sizeof(T), alignof(T))) T(std::move(object)); });
+        }
+
+        /**
+         * @brief Registers the nursery object ref points at as a survivor, relocated by relocate.
+         *
+         * At reset, relocate(T& object, arena_type& old) is called with the nursery object and
+         * the old generation, and must return the relocated object; ref is set to it. The hook
+         * allocates from old for the object and for any nursery memory it copies along.
+         */
+        template <typename T, typename Relocate>
+        void promote(T*& ref, Relocate relocate)
+        {
+            using record_type = survivor_record<T, Relocate>;
+
+            auto* record = new (nursery_.allocate(sizeof(record_type), alignof(record_type))) record_type(ref, std::move(relocate));
+            if (tail_ == nullptr) {
+                head_ = record;
+            } else {
+                tail_->next = record;
+            }
+            tail_ = record;
+            ++survivor_count_;
+        }
+
+        /**
+         * @brief Relocates the registered survivors into the old generation and resets the nursery.
+         */
+        void reset()
+        {
+            reset([](const void*, void*) {});
+        }
+
+        /**
+         * @brief Like reset(), calling on_forward(const void* from, void* to) for each survivor in
+         *        promotion order, for callers that hold other pointers to survivors.
+         *
+         * If a relocate hook (or the old generation) throws, the survivors relocated so far
+         * stay relocated and the one being relocated is unregistered, with its ref left
+         * pointing into the nursery. The survivors not reached yet stay registered, and the
+         * nursery is not reset, so the objects are still valid and reset can be called again.
+         */
+        template <typename OnForward>
+        void reset(OnForward&& on_forward)
+        {
+            while (head_ != nullptr) {
+                // unlink first, so that a throwing hook never leaves a relocated record registered
+                survivor* record = head_;
+                head_            = record->next;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+                --survivor_count_;
+
+                hook_guard              guard{record};
+                std::pair<void*, void*> moved = record->relocate(record, old_);
+                ++promoted_count_;
+                on_forward(static_cast<const void*>(moved.first), moved.second);
+            }
+            nursery_.reset();
+        }
+
+        /**
+         * @brief Resets both generations; registered survivors are dropped without relocation.
+         */
+        void clear()
+        {
+            drop_survivors();
+            nursery_.reset();
+            old_.reset();
+        }
+
+        /**
+         * @brief Returns the number of survivors registered since the last reset.
+         */
+        std::size_t survivor_count() const noexcept { return survivor_count_; }
+
+        /**
+         * @brief Returns the number of objects relocated into the old generation since construction.
+         */
+        std::size_t promoted_count() const noexcept { return promoted_count_; }
+
+        /**
+         * @brief Returns the nursery.
+         */
+        arena_type& nursery() noexcept { return nursery_; }
+
+        /**
+         * @brief Returns the old generation.
+         */
+        arena_type& old_generation() noexcept { return old_; }
+
+    private:
+        // a registered survivor; lives in the nursery and is dropped with it
+        struct survivor
+        {
+            // relocates the object, updates the caller's ref and returns {from, to}
+            std::pair<void*, void*> (*relocate)(survivor*, arena_type&);
+            // destroys the relocate hook
+            void (*destroy)(survivor*) noexcept;
+            survivor* next = nullptr;
+        };
+
+        template <typename T, typename Relocate>
+        struct survivor_record : survivor
+        {
+            survivor_record(T*& ref, Relocate&& hook)
+                : survivor{&relocate_object, &destroy_hook}, ref(ref), hook(std::move(hook)) {}
+
+            static std::pair<void*, void*> relocate_object(survivor* base, arena_type& old)
+            {
+                auto* self = static_cast<survivor_record*>(base);
+                T*    from = self->ref;
+                self->ref  = self->hook(*from, old);
+                return {from, self->ref};
+            }
+
+            static void destroy_hook(survivor* base) noexcept { static_cast<survivor_record*>(base)->~survivor_record(); }
+
+            T*&      ref;
+            Relocate hook;
+        };
+
+        // destroys the relocate hook of an unlinked record, also when the hook throws
+        struct hook_guard
+        {
+            survivor* record;
+
+            ~hook_guard() { record->destroy(record); }
+        };
+
+        void drop_survivors() noexcept
+        {
+            for (survivor* record = head_; record != nullptr;) {
+                survivor* next = record->next;
+                record->destroy(record);
+                record = next;
+            }
+            head_           = nullptr;
+            tail_           = nullptr;
+            survivor_count_ = 0;
+        }
+
+        arena_type  nursery_;
+        arena_type  old_;
+        survivor*   head_           = nullptr; // survivors in promotion order
+        survivor*   tail_           = nullptr;
+        std::size_t survivor_count_ = 0; // survivors registered since the last reset
+        std::size_t promoted_count_ = 0; // survivors relocated since construction
+    };
+
+} // namespace apus
+
+#endif // APUS_GENERATIONAL_ARENA_HPP
@@ -0,0 +1,414 @@
+#ifndef APUS_LRU_CACHE_HPP
+#define APUS_LRU_CACHE_HPP
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+
+#include <apus/config.hpp>
+#include <apus/slot_map.hpp>
+#include <apus/flat_hash_map.hpp>
+
+namespace apus
+{
+
+    // default page size for lru_cache's internal slot_map
+    static constexpr std::size_t DEFAULT_LRU_CACHE_PAGE_SIZE = 1024;
+
+    /**
+     * @brief Eviction policy of an lru_cache.
+     */
+    enum class lru_cache_policy
+    {
+        lru,  // exact least-recently-used order; hits are promoted in batches
+        clock // CLOCK (second chance): hits only set a reference bit
+    };
+
+    /**
+     * @brief A bounded key-value cache with least-recently-used eviction.
+     *
+     * Entries live in a slot_map and are threaded on an intrusive recency list whose
+     * prev/next links are slot indices, so an entry costs one arena slot plus a 12-byte
+     * index record, and no per-entry heap node. Each key is stored once, in its entry:
+     * the open-addressing flat_hash_map that finds entries holds only slot indices and
+     * key hashes, and compares a looked-up key against the entry's key.
+     *
+     * Each entry has a weight (1 by default) and the cache evicts from the cold end
+     * until the total weight fits the capacity, which allows bounding by bytes rather
+     * than by entry count.
+     *
+     * With lru_cache_policy::lru, hits are recorded in a small fixed buffer and
+     * applied to the recency list when it fills up or before any eviction, so a hit
+     * costs a hash lookup and a store; eviction order is still exact LRU. With
+     * lru_cache_policy::clock, hits only set a reference bit and the eviction hand
+     * gives referenced entries a second chance.
+     *
+     * Pointers returned by get() and put() stay valid until the entry is evicted or erased.
+     *
+     * @tparam K The key type.
+     * @tparam V The value type.
+     * @tparam Hash The hash function for keys.
+     * @tparam KeyEqual The equality comparison for keys.
+     * @tparam PageSize The number of entries per page of the underlying slot_map.
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+              std::size_t PageSize = DEFAULT_LRU_CACHE_PAGE_SIZE>
+    class lru_cache
+    {
+        static constexpr std::uint32_t NIL             = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::size_t   PROMOTION_BATCH = 32;
+
+        struct entry
+        {
+            K             key;
+            V             value;
+            std::size_t   weight;
+            std::uint32_t prev;       // towards the most recently used end
+            std::uint32_t next;       // towards the least recently used end
+            std::uint32_t hash;       // truncated hash of key, for the index
+            bool          referenced; // CLOCK reference bit
+        };
+
+        using entry_map = slot_map<entry, slot_map_deleter<entry>, PageSize>;
+        using handle    = typename entry_map::handle;
+
+        // index record of an entry: its slot and the hash of its key
+        struct index_key
+        {
+            std::uint32_t index;
+            std::uint32_t hash;
+        };
+
+        // a key being looked up, compared against the keys of the entries
+        struct key_probe
+        {
+            const K&         key;
+            std::uint32_t    hash;
+            const lru_cache* cache;
+        };
+
+        struct index_hash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(const index_key& k) const noexcept { return k.hash; }
+            std::size_t operator()(const key_probe& p) const noexcept { return p.hash; }
+        };
+
+        struct index_equal
+        {
+            using is_transparent = void;
+
+            // only compares records of different entries, since a key is looked up before it is inserted
+            bool operator()(const index_key& a, const index_key& b) const noexcept { return a.index == b.index; }
+
+            bool operator()(const index_key& a, const key_probe& p) const
+            {
+                return a.hash == p.hash && KeyEqual()(p.cache->entry_at(a.index).key, p.key);
+            }
+        };
+
+        // slot index and hash -> version of the entry's handle
+        using index_map = flat_hash_map<index_key, std::uint32_t, index_hash, index_equal>;
+
+    public:
+        using key_type    = K;
+        using mapped_type = V;
+        using size_type   = std::size_t;
+
+        /**
+         * @brief Construct a new LRU cache.
+         *
+         * @param capacity The maximum total weight of the cached entries.
+         * @param policy The eviction policy.
+         */
+        explicit lru_cache(size_type capacity, lru_cache_policy policy = lru_cache_policy::lru)
+            : capacity_(capacity), policy_(policy)
+        {
+        }
+
+        /**
+         * @brief Looks up a value and marks it as recently used.
+         *
+         * @param key The key to look up.
+         * @return V* A pointer to the cached value, or nullptr on a miss.
+         */
+        V* get(const K& key)
+        {
+            auto it = index_.find(probe(key));
+            if (it == index_.end()) {
+                return nullptr;
+            }
+            handle h = handle_of(*it);
+            entry& e = entries_[h];
+            touch(h, e);
+            return &e.value;
+        }
+
+        /**
+         * @brief Looks up a value without affecting its recency.
+         *
+         * @param key The key to look up.
+         * @return const V* A pointer to the cached value, or nullptr on a miss.
+         */
+        const V* peek(const K& key) const
+        {
+            auto it = index_.find(probe(key));
+            return it == index_.end() ? nullptr : &entry_at(it->first.index).value;
+        }
+
+        /**
+         * @brief Checks if a key is cached, without affecting its recency.
+         */
+        bool contains(const K& key) const
+        {
+            return index_.contains(probe(key));
+        }
+
+        /**
+         * @brief Inserts or replaces a value, marks it as most recently used and evicts as needed.
+         *
+         * @param key The key.
+         * @param value The value to cache.
+         * @param weight The weight of the entry, counted against the capacity.
+         * @return V& A reference to the cached value.
+         * @throws std::length_error If weight exceeds the capacity of the cache.
+         */
+        V& put(const K& key, V value, size_type weight = 1)
+        {
+            if (weight > capacity_) {
+                detail::throw_error(std::length_error("lru_cache::put: entry weight exceeds capacity"));
+            }
+            return put_impl(key, std::move(value), weight);
+        }
+
+        /**
+         * @brief Like put, but reports an entry heavier than the whole cache by returning nullptr.
+         *
+         * @param key The key.
+         * @param value The value to cache.
+         * @param weight The weight of the entry, counted against the capacity.
+         * @return V* A pointer to the cached value, or nullptr if weight exceeds the capacity.
+         */
+        V* try_put(const K& key, V value, size_type weight = 1)
+        {
+            if (weight > capacity_) {
+                return nullptr;
+            }
+            return &put_impl(key, std::move(value), weight);
+        }
+
+        /**
+         * @brief Removes an entry.
+         *
+         * @param key The key of the entry.
+         * @return true If the entry was cached and has been removed.
+         */
+        bool erase(const K& key)
+        {
+            auto it = index_.find(probe(key));
+            if (it == index_.end()) {
+                return false;
+            }
+            handle h = handle_of(*it);
+            index_.erase(it);
+            remove_entry(h);
+            return true;
+        }
+
+        /**
+         * @brief Removes all entries.
+         */
+        void clear()
+        {
+            for (auto& kv : index_) {
+                entries_.remove(handle_of(kv));
+            }
+            index_.clear();
+            head_          = NIL;
+            tail_          = NIL;
+            weight_        = 0;
+            pending_count_ = 0;
+        }
+
+        /**
+         * @brief Changes the capacity, evicting entries if the cache no longer fits.
+         *
+         * @param capacity The new maximum total weight.
+         */
+        void set_capacity(size_type capacity)
+        {
+            capacity_ = capacity;
+            evict_until(capacity_);
+        }
+
+        /**
+         * @brief Visits the entries from the most to the least recently used.
+         *
+         * @param fn Callable invoked as fn(const K&, V&).
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn)
+        {
+            flush_promotions();
+            for (std::uint32_t index = head_; index != NIL;) {
+                entry& e = entry_at(index);
+                index    = e.next;
+                fn(static_cast<const K&>(e.key), e.value);
+            }
+        }
+
+        // clang-format off
+        size_type        size()     const noexcept { return entries_.size();  }
+        bool             empty()    const noexcept { return entries_.empty(); }
+        size_type        weight()   const noexcept { return weight_;          }
+        size_type        capacity() const noexcept { return capacity_;        }
+        lru_cache_policy policy()   const noexcept { return policy_;          }
+        // clang-format on
+
+    private:
+        V& put_impl(const K& key, V value, size_type weight)
+        {
+            std::uint32_t hash = hash_of(key);
+            auto          it   = index_.find(key_probe{key, hash, this});
+            if (it != index_.end()) {
+                handle h = handle_of(*it);
+                entry& e = entries_[h];
+                e.value  = std::move(value);
+                weight_  = weight_ - e.weight + weight;
+                e.weight = weight;
+                touch(h, e);
+                // the updated entry is the most recent, so it is never the victim while others remain
+                evict_until(capacity_);
+                return entries_[h].value;
+            }
+
+            evict_until(capacity_ - weight);
+
+            handle h = entries_.add(entry{key, std::move(value), weight, NIL, NIL, hash, false});
+            index_.try_emplace(index_key{h.index, hash}, h.version);
+            push_front(h.index);
+            weight_ += weight;
+            return entries_[h].value;
+        }
+
+        // list links are bare slot indices; slot_map::operator[] does not check versions
+        entry&       entry_at(std::uint32_t index) { return entries_[handle{index, 0}]; }
+        const entry& entry_at(std::uint32_t index) const { return entries_[handle{index, 0}]; }
+
+        static std::uint32_t hash_of(const K& key) { return static_cast<std::uint32_t>(Hash()(key)); }
+
+        key_probe probe(const K& key) const { return key_probe{key, hash_of(key), this}; }
+
+        static handle handle_of(const typename index_map::value_type& record) noexcept
+        {
+            return handle{record.first.index, record.second};
+        }
+
+        void touch(handle h, entry& e)
+        {
+            if (policy_ == lru_cache_policy::clock) {
+                e.referenced = true;
+                return;
+            }
+            if (pending_count_ == 0 && h.index == head_) {
+                return;
+            }
+            if (pending_count_ == PROMOTION_BATCH) {
+                flush_promotions();
+            }
+            // versioned, since the entry may be erased before the batch is applied
+            pending_[pending_count_++] = h;
+        }
+
+        void flush_promotions()
+        {
+            for (size_type i = 0; i < pending_count_; ++i) {
+                handle h = pending_[i];
+                if (entries_.find(h) && h.index != head_) {
+                    unlink(h.index);
+                    push_front(h.index);
+                }
+            }
+            pending_count_ = 0;
+        }
+
+        void evict_until(size_type limit)
+        {
+            if (weight_ <= limit) {
+                return;
+            }
+            flush_promotions();
+
+            while (weight_ > limit) {
+                std::uint32_t victim = tail_;
+                if (policy_ == lru_cache_policy::clock) {
+                    // second chance: referenced entries go back to the hot end with their bit cleared
+                    while (entry_at(victim).referenced) {
+                        entry_at(victim).referenced = false;
+                        unlink(victim);
+                        push_front(victim);
+                        victim = tail_;
+                    }
+                }
+
+                auto   it = index_.find(index_key{victim, entry_at(victim).hash});
+                handle h  = handle_of(*it);
+                index_.erase(it);
+                remove_entry(h);
+            }
+        }
+
+        void remove_entry(handle h)
+        {
+            unlink(h.index);
+            weight_ -= entries_[h].weight;
+            entries_.remove(h);
+        }
+
+        void push_front(std::uint32_t index)
+        {
+            entry& e = entry_at(index);
+            e.prev   = NIL;
+            e.next   = head_;
+            if (head_ != NIL) {
+                entry_at(head_).prev = index;
+            } else {
+                tail_ = index;
+            }
+            head_ = index;
+        }
+
+        void unlink(std::uint32_t index)
+        {
+            entry& e = entry_at(index);
+            if (e.prev != NIL) {
+                entry_at(e.prev).next = e.next;
+            } else {
+                head_ = e.next;
+            }
+            if (e.next != NIL) {
+                entry_at(e.next).prev = e.prev;
+            } else {
+                tail_ = e.prev;
+            }
+        }
+
+        entry_map                           entries_;            // entries, linked in recency order
+        index_map                           index_;              // key (through its entry) -> entry handle
+        std::array<handle, PROMOTION_BATCH> pending_;            // recorded hits not yet applied to the list
+        size_type                           pending_count_ = 0;
+        std::uint32_t                       head_          = NIL; // most recently used
+        std::uint32_t                       tail_          = NIL; // least recently used
+        size_type                           weight_        = 0;   // total weight of the entries
+        size_type                           capacity_;
+        lru_cache_policy                    policy_;
+    };
+
+} // namespace apus
+
+#endif // APUS_LRU_CACHE_HPP
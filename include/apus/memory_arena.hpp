@@ -1,30 +1,57 @@
 #ifndef APUS_MEMORY_ARENA_HPP
 #define APUS_MEMORY_ARENA_HPP
 
+#include <new>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
 #include <memory_resource>
 
+#include <apus/config.hpp>
+#include <apus/child_arena.hpp>
+#include <apus/stats_policy.hpp>
+
 namespace apus
 {
 
     /**
-     * @brief A memory arena that uses std::pmr::monotonic_buffer_resource.
+     * @brief A memory arena over a fixed-size buffer.
      *
      * This arena manages a fixed-size buffer and provides fast allocations
      * by incrementing a pointer. Deallocations are no-ops until the arena is reset.
+     * Like a std::pmr::monotonic_buffer_resource with a null upstream, it throws
+     * std::bad_alloc when the buffer is exhausted (through the allocation failure
+     * handler, see config.hpp), but it keeps its offset visible so usage can be
+     * reported. try_allocate returns nullptr instead.
      *
      * @tparam SizeInBytes The size of the internal buffer in bytes.
+     * @tparam Stats The stats policy (see stats_policy.hpp); records allocations, padding and sizes.
      */
-    template <std::size_t SizeInBytes>
-    class memory_arena
+    template <std::size_t SizeInBytes, typename Stats = null_stats>
+    class memory_arena : private Stats
     {
+        // the std::pmr view of the arena, so resource() allocations are accounted too
+        class bump_resource : public std::pmr::memory_resource
+        {
+        public:
+            explicit bump_resource(memory_arena* arena) : arena_(arena) {}
+
+        private:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override { return arena_->allocate(bytes, alignment); }
+            void  do_deallocate(void*, std::size_t, std::size_t) override {}
+            bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+            memory_arena* arena_;
+        };
+
     public:
         /**
          * @brief Construct a new memory arena.
          */
         memory_arena()
-            : resource_(buffer_.data(), buffer_.size(), std::pmr::null_memory_resource()) {}
+            : resource_(this) {}
 
         // disable copying and moving
         memory_arena(const memory_arena&)            = delete;
@@ -38,10 +65,37 @@ namespace apus
          * @param bytes Number of bytes to allocate.
          * @param alignment Alignment requirement.
          * @return void* Pointer to the allocated memory.
+         * @throws std::bad_alloc If the buffer is exhausted (see set_alloc_failure_handler).
          */
         void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
         {
-            return resource_.allocate(bytes, alignment);
+            void* ptr = try_allocate(bytes, alignment);
+            if (ptr == nullptr) {
+                detail::alloc_failure(bytes);
+            }
+            return ptr;
+        }
+
+        /**
+         * @brief Allocate raw memory from the arena without failing loudly.
+         *
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment requirement.
+         * @return void* Pointer to the allocated memory, or nullptr if the buffer is exhausted.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            std::uintptr_t current = reinterpret_cast<std::uintptr_t>(buffer_.data()) + offset_;
+            std::uintptr_t aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            std::size_t    padding = static_cast<std::size_t>(aligned - current);
+
+            if (padding > SizeInBytes - offset_ || bytes > SizeInBytes - offset_ - padding) {
+                return nullptr;
+            }
+
+            offset_ += padding + bytes;
+            Stats::record_allocation(bytes, padding);
+            return reinterpret_cast<void*>(aligned);
         }
 
         /**
@@ -57,6 +111,28 @@ namespace apus
             return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
         }
 
+        /**
+         * @brief Carves a child arena with a budget of bytes out of this arena.
+         *
+         * The child bump-allocates within its own contiguous range and can be reset on
+         * its own; its memory is reclaimed by this arena's reset(). See child_arena.
+         *
+         * @throws std::bad_alloc If the buffer cannot hold the budget (see set_alloc_failure_handler).
+         */
+        child_arena make_child(std::size_t bytes) { return child_arena(allocate(bytes), bytes); }
+
+        /**
+         * @brief Carves a child arena with a budget of bytes, or returns nullopt if the buffer cannot hold it.
+         */
+        std::optional<child_arena> try_make_child(std::size_t bytes) noexcept
+        {
+            void* base = try_allocate(bytes);
+            if (base == nullptr) {
+                return std::nullopt;
+            }
+            return child_arena(base, bytes);
+        }
+
         /**
          * @brief Deallocate raw memory from the arena.
          *
@@ -68,7 +144,9 @@ namespace apus
          */
         void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
         {
-            resource_.deallocate(p, bytes, alignment);
+            (void)p;
+            (void)bytes;
+            (void)alignment;
         }
 
         /**
@@ -93,9 +171,38 @@ namespace apus
          */
         void reset()
         {
-            resource_.release();
+            high_water_mark_ = std::max(high_water_mark_, offset_);
+            offset_          = 0;
         }
 
+        /**
+         * @brief Returns the number of bytes handed out since the last reset, including alignment padding.
+         */
+        std::size_t used_bytes() const noexcept { return offset_; }
+
+        /**
+         * @brief Returns the number of bytes left in the buffer (before alignment of the next allocation).
+         */
+        std::size_t remaining_bytes() const noexcept { return SizeInBytes - offset_; }
+
+        /**
+         * @brief Returns the highest used_bytes() ever reached, across resets.
+         */
+        std::size_t high_water_mark() const noexcept { return std::max(high_water_mark_, offset_); }
+
+        /**
+         * @brief Returns the bytes skipped to satisfy alignment, or 0 if the stats policy does not count.
+         */
+        std::size_t alignment_padding_bytes() const noexcept
+        {
+            return static_cast<std::size_t>(detail::stats_count<Stats>(*this, stats_event::padding_bytes));
+        }
+
+        /**
+         * @brief Returns the stats policy instance of this arena.
+         */
+        const Stats& stats() const noexcept { return *this; }
+
         /**
          * @brief Get the underlying PMR memory resource.
          *
@@ -128,8 +235,10 @@ namespace apus
         }
 
     private:
-        std::array<std::byte, SizeInBytes>  buffer_;
-        std::pmr::monotonic_buffer_resource resource_;
+        alignas(std::max_align_t) std::array<std::byte, SizeInBytes> buffer_;
+        bump_resource                                          resource_;
+        std::size_t                                            offset_          = 0; // bytes used since the last reset
+        std::size_t                                            high_water_mark_ = 0; // highest offset_ seen at a reset
     };
 
 } // namespace apus
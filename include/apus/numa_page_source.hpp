@@ -0,0 +1,285 @@
+#ifndef APUS_NUMA_PAGE_SOURCE_HPP
+#define APUS_NUMA_PAGE_SOURCE_HPP
+
+#include <array>
+#include <mutex>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <apus/page_source.hpp>
+
+namespace apus
+{
+
+    // nodes numa_page_source can bind to; machines with more nodes use the first ones
+    static constexpr int NUMA_MAX_NODES = 64;
+
+    // distinct page sizes pooled per node; pages of further sizes are unmapped when freed
+    static constexpr std::size_t NUMA_POOL_SIZE_CLASSES = 8;
+
+    namespace detail
+    {
+        // mempolicy constants from <linux/mempolicy.h>, to avoid depending on libnuma's numaif.h
+        static constexpr int numa_mpol_preferred = 1;
+        static constexpr int numa_mpol_f_node    = 1 << 0;
+        static constexpr int numa_mpol_f_addr    = 1 << 1;
+
+        // freed pages of one node, in intrusive lists threaded through the pages themselves
+        struct numa_node_pool
+        {
+            struct free_page
+            {
+                free_page* next;
+            };
+
+            struct size_class
+            {
+                std::size_t bytes = 0; // mapping length of the pages in the list, 0 if unused
+                free_page*  head  = nullptr;
+                std::size_t count = 0;
+            };
+
+            std::mutex                                     mutex;
+            std::array<size_class, NUMA_POOL_SIZE_CLASSES> classes;
+        };
+
+        inline numa_node_pool& numa_pool(int node) noexcept
+        {
+            static numa_node_pool pools[NUMA_MAX_NODES];
+            return pools[node];
+        }
+    } // namespace detail
+
+    /**
+     * @brief A page source that places arena pages on one NUMA node.
+     *
+     * Pages are mapped with mmap and bound to the node with the mbind syscall before
+     * anything touches them, so they land on the chosen node rather than wherever the
+     * first toucher happens to run. The policy is "preferred": if the node runs out of
+     * memory the kernel falls back to another node instead of failing. Freed pages go
+     * to a per-node pool and are handed out again without a syscall or page faults;
+     * trim() returns pooled pages to the system.
+     *
+     * Page sizes are rounded up to whole OS pages, so use arena pages of at least 4 KiB.
+     * No libnuma is needed. On a single-node machine, or when the kernel refuses the
+     * mempolicy syscalls (containers often do), nothing is bound and pages behave like
+     * any other mapped memory; a node outside the machine falls back to node 0. Off
+     * Linux, pages come from the heap.
+     *
+     * The pools are shared by every numa_page_source in the process and are thread-safe.
+     *
+     * Usage:
+     *   paged_memory_arena<64 * 1024, null_stats, numa_page_source> arena(numa_page_source(1));
+     */
+    class numa_page_source
+    {
+    public:
+        /**
+         * @brief Construct a source for the node the calling thread is running on.
+         */
+        numa_page_source() noexcept : node_(current_node()) {}
+
+        /**
+         * @brief Construct a source for the given node (node 0 if the machine has no such node).
+         */
+        explicit numa_page_source(int node) noexcept : node_(node >= 0 && node < node_count() ? node : 0) {}
+
+        /**
+         * @brief Returns a page of at least bytes bytes on this source's node, or nullptr.
+         */
+        void* allocate_page(std::size_t bytes, std::size_t alignment) noexcept
+        {
+#if defined(__linux__)
+            if (alignment > os_page_size()) {
+                return nullptr;
+            }
+            const std::size_t       length = mapping_length(bytes);
+            detail::numa_node_pool& pool   = detail::numa_pool(node_);
+            {
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                for (auto& sc : pool.classes) {
+                    if (sc.bytes == length && sc.head != nullptr) {
+                        detail::numa_node_pool::free_page* page = sc.head;
+                        sc.head                                 = page->next;
+                        --sc.count;
+                        return page;
+                    }
+                }
+            }
+
+            void* page = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (page == MAP_FAILED) {
+                return nullptr;
+            }
+            if (node_count() > 1) {
+                // best effort: an unbound page still works, it just lands on the first toucher's node
+                unsigned long mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long)) + 1] = {};
+                mask[node_ / (8 * sizeof(unsigned long))] |= 1UL << (node_ % (8 * sizeof(unsigned long)));
+                ::syscall(SYS_mbind, page, length, detail::numa_mpol_preferred, mask, NUMA_MAX_NODES + 1, 0);
+            }
+            return page;
+#else
+            return heap_page_source().allocate_page(bytes, alignment);
+#endif
+        }
+
+        /**
+         * @brief Returns a page to this source's node pool.
+         */
+        void deallocate_page(void* page, std::size_t bytes, std::size_t alignment) noexcept
+        {
+#if defined(__linux__)
+            (void)alignment;
+            const std::size_t       length = mapping_length(bytes);
+            detail::numa_node_pool& pool   = detail::numa_pool(node_);
+            {
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                for (auto& sc : pool.classes) {
+                    if (sc.bytes == length || sc.bytes == 0) {
+                        sc.bytes = length;
+                        sc.head  = new (page) detail::numa_node_pool::free_page{sc.head};
+                        ++sc.count;
+                        return;
+                    }
+                }
+            }
+            // every size class is taken by other page sizes
+            ::munmap(page, length);
+#else
+            heap_page_source().deallocate_page(page, bytes, alignment);
+#endif
+        }
+
+        /**
+         * @brief Returns the node this source places pages on.
+         */
+        int node() const noexcept { return node_; }
+
+        /**
+         * @brief Returns the number of NUMA nodes of the machine (1 if unknown).
+         */
+        static int node_count() noexcept
+        {
+            static const int count = read_node_count();
+            return count;
+        }
+
+        /**
+         * @brief Returns the node of the CPU the calling thread is running on (0 if unknown).
+         */
+        static int current_node() noexcept
+        {
+#if defined(__linux__) && defined(SYS_getcpu)
+            unsigned cpu  = 0;
+            unsigned node = 0;
+            if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && static_cast<int>(node) < node_count()) {
+                return static_cast<int>(node);
+            }
+#endif
+            return 0;
+        }
+
+        /**
+         * @brief Returns the node holding the memory at address, faulting it in if needed, or -1 if unknown.
+         */
+        static int node_of(const void* address) noexcept
+        {
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+            int node = -1;
+            if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, address, detail::numa_mpol_f_node | detail::numa_mpol_f_addr) == 0) {
+                return node;
+            }
+#else
+            (void)address;
+#endif
+            return -1;
+        }
+
+        /**
+         * @brief Returns the number of free pages pooled for node.
+         */
+        static std::size_t pooled_pages(int node) noexcept
+        {
+            if (node < 0 || node >= NUMA_MAX_NODES) {
+                return 0;
+            }
+            detail::numa_node_pool&     pool = detail::numa_pool(node);
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            std::size_t                 count = 0;
+            for (const auto& sc : pool.classes) {
+                count += sc.count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns every pooled page of every node to the system.
+         *
+         * @return std::size_t The number of pages released.
+         */
+        static std::size_t trim() noexcept
+        {
+            std::size_t released = 0;
+#if defined(__linux__)
+            for (int node = 0; node < node_count(); ++node) {
+                detail::numa_node_pool&     pool = detail::numa_pool(node);
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                for (auto& sc : pool.classes) {
+                    while (sc.head != nullptr) {
+                        detail::numa_node_pool::free_page* page = sc.head;
+                        sc.head                                 = page->next;
+                        ::munmap(page, sc.bytes);
+                        ++released;
+                    }
+                    sc = detail::numa_node_pool::size_class();
+                }
+            }
+#endif
+            return released;
+        }
+
+    private:
+#if defined(__linux__)
+        static std::size_t os_page_size() noexcept
+        {
+            static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        static std::size_t mapping_length(std::size_t bytes) noexcept
+        {
+            const std::size_t page = os_page_size();
+            return (std::max<std::size_t>(bytes, 1) + page - 1) / page * page;
+        }
+#endif
+
+        // the highest node listed in /sys/devices/system/node/online (e.g. "0-1" or "0,2-3"), plus one
+        static int read_node_count() noexcept
+        {
+            int count = 1;
+#if defined(__linux__)
+            if (std::FILE* file = std::fopen("/sys/devices/system/node/online", "r")) {
+                int node = 0;
+                while (std::fscanf(file, "%d", &node) == 1) {
+                    count = std::max(count, node + 1);
+                    if (std::fgetc(file) == EOF) break; // skip ',' or '-'
+                }
+                std::fclose(file);
+            }
+#endif
+            return std::min(count, NUMA_MAX_NODES);
+        }
+
+        int node_;
+    };
+
+} // namespace apus
+
+#endif // APUS_NUMA_PAGE_SOURCE_HPP
@@ -0,0 +1,75 @@
+#ifndef APUS_PAGE_SOURCE_HPP
+#define APUS_PAGE_SOURCE_HPP
+
+#include <new>
+#include <memory>
+#include <cstddef>
+
+namespace apus
+{
+
+    /**
+     * @brief The default page source of paged_memory_arena and typed_memory_arena: pages come from the global heap.
+     *
+     * A page source is a small copyable value that hands out raw blocks for arena pages
+     * and takes them back. An arena keeps one copy to allocate pages and gives every page
+     * its own copy to return it through, so a source can remember where its pages go
+     * (numa_page_source keeps its node). allocate_page returns nullptr on failure and
+     * leaves it to the arena to decide whether that is an error.
+     */
+    struct heap_page_source
+    {
+        void* allocate_page(std::size_t bytes, std::size_t alignment) noexcept
+        {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+            }
+            return ::operator new(bytes, std::nothrow);
+        }
+
+        void deallocate_page(void* page, std::size_t bytes, std::size_t alignment) noexcept
+        {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                ::operator delete(page, bytes, std::align_val_t(alignment));
+            } else {
+                ::operator delete(page, bytes);
+            }
+        }
+    };
+
+    namespace detail
+    {
+        // destroys a page and returns its memory to the source it came from
+        template <typename Page, typename PageSource>
+        struct page_deleter
+        {
+            PageSource source;
+
+            void operator()(Page* page) noexcept
+            {
+                page->~Page();
+                source.deallocate_page(page, sizeof(Page), alignof(Page));
+            }
+        };
+
+        template <typename Page, typename PageSource>
+        using page_ptr = std::unique_ptr<Page, page_deleter<Page, PageSource>>;
+
+        /**
+         * @brief Default-constructs a Page in memory from source; the result is null if the source is out of memory.
+         */
+        template <typename Page, typename PageSource>
+        page_ptr<Page, PageSource> make_page(const PageSource& source) noexcept
+        {
+            page_deleter<Page, PageSource> deleter{source};
+            void*                          memory = deleter.source.allocate_page(sizeof(Page), alignof(Page));
+            if (memory == nullptr) {
+                return page_ptr<Page, PageSource>(nullptr, deleter);
+            }
+            return page_ptr<Page, PageSource>(new (memory) Page(), deleter);
+        }
+    } // namespace detail
+
+} // namespace apus
+
+#endif // APUS_PAGE_SOURCE_HPP
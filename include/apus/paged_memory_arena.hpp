@@ -2,9 +2,17 @@
 #define APUS_PAGED_MEMORY_ARENA_HPP
 
 #include <apus/memory_arena.hpp>
+#include <apus/child_arena.hpp>
+#include <apus/page_source.hpp>
+#include <apus/stats_policy.hpp>
 #include <vector>
+#include <utility>
+#include <new>
 #include <memory>
 #include <cstddef>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
 
 namespace apus
 {
@@ -16,18 +24,32 @@ namespace apus
      * a new page is allocated. If the request is larger than PageSizeInBytes, it returns nullptr.
      *
      * @tparam PageSizeInBytes The size of each memory page in bytes.
+     * @tparam Stats The stats policy (see stats_policy.hpp); records page allocations, allocations, padding and sizes.
+     * @tparam PageSource Where pages come from (see page_source.hpp), e.g. numa_page_source to place them on a NUMA node.
      */
-    template <std::size_t PageSizeInBytes>
-    class paged_memory_arena
+    template <std::size_t PageSizeInBytes, typename Stats = null_stats, typename PageSource = heap_page_source>
+    class paged_memory_arena : private Stats
     {
     public:
         /**
          * @brief Construct a new paged memory arena.
          */
         paged_memory_arena()
+            : paged_memory_arena(PageSource()) {}
+
+        /**
+         * @brief Construct a new paged memory arena that takes its pages from source.
+         */
+        explicit paged_memory_arena(PageSource source)
+            : source_(std::move(source))
         {
             // start with one page
-            pages_.emplace_back(std::make_unique<memory_arena<PageSizeInBytes>>());
+            page_ptr page = detail::make_page<page_type>(source_);
+            if (page == nullptr) {
+                detail::alloc_failure(sizeof(page_type));
+            }
+            pages_.push_back(std::move(page));
+            Stats::record(stats_event::page_allocation);
         }
 
         // disable copying and moving
@@ -42,6 +64,7 @@ namespace apus
          * @param bytes Number of bytes to allocate.
          * @param alignment Alignment requirement.
          * @return void* Pointer to the allocated memory, or nullptr if bytes > PageSizeInBytes.
+         * @throws std::bad_alloc If a new page cannot be allocated (see set_alloc_failure_handler).
          */
         void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
         {
@@ -49,13 +72,47 @@ namespace apus
                 return nullptr;
             }
 
-            try {
-                return pages_.back()->allocate(bytes, alignment);
-            } catch (const std::bad_alloc&) {
+            void* ptr = try_allocate(bytes, alignment);
+            if (ptr == nullptr) {
+                detail::alloc_failure(sizeof(page_type));
+            }
+            return ptr;
+        }
+
+        /**
+         * @brief Allocate raw memory from the arena without failing loudly.
+         *
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment requirement.
+         * @return void* Pointer to the allocated memory, or nullptr if bytes > PageSizeInBytes
+         *         or a new page cannot be allocated.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            if (bytes > PageSizeInBytes) {
+                return nullptr;
+            }
+
+            page_type*  page        = pages_.back().get();
+            std::size_t used_before = page->used_bytes();
+
+            void* ptr = page->try_allocate(bytes, alignment);
+            if (ptr == nullptr) {
                 // current page is full, add a new one
-                pages_.emplace_back(std::make_unique<memory_arena<PageSizeInBytes>>());
-                return pages_.back()->allocate(bytes, alignment);
+                page_ptr fresh = detail::make_page<page_type>(source_);
+                if (fresh == nullptr || (ptr = fresh->try_allocate(bytes, alignment)) == nullptr) {
+                    return nullptr;
+                }
+                full_pages_bytes_ += used_before;
+                pages_.push_back(std::move(fresh));
+                Stats::record(stats_event::page_allocation);
+
+                page        = pages_.back().get();
+                used_before = 0;
             }
+
+            Stats::record_allocation(bytes, page->used_bytes() - used_before - bytes);
+            return ptr;
         }
 
         /**
@@ -71,19 +128,97 @@ namespace apus
             return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
         }
 
+        /**
+         * @brief Carves a child arena with a budget of bytes out of the current page (or a new one).
+         *
+         * The child bump-allocates within its own contiguous range and can be reset on
+         * its own; its memory is reclaimed by this arena's reset(). See child_arena.
+         *
+         * @throws std::length_error If bytes > PageSizeInBytes, since a child must be contiguous.
+         * @throws std::bad_alloc If a new page cannot be allocated (see set_alloc_failure_handler).
+         */
+        child_arena make_child(std::size_t bytes)
+        {
+            if (bytes > PageSizeInBytes) {
+                detail::throw_error(std::length_error("paged_memory_arena::make_child: budget exceeds the page size"));
+            }
+            return child_arena(allocate(bytes), bytes);
+        }
+
+        /**
+         * @brief Carves a child arena with a budget of bytes, or returns nullopt if
+         *        bytes > PageSizeInBytes or a new page cannot be allocated.
+         */
+        std::optional<child_arena> try_make_child(std::size_t bytes)
+        {
+            void* base = try_allocate(bytes);
+            if (base == nullptr) {
+                return std::nullopt;
+            }
+            return child_arena(base, bytes);
+        }
+
         /**
          * @brief Reset the arena, reclaiming all pages except the first one.
          */
         void reset()
         {
+            high_water_mark_  = high_water_mark();
+            full_pages_bytes_ = 0;
             if (pages_.size() > 1) {
                 pages_.erase(pages_.begin() + 1, pages_.end());
             }
             pages_.back()->reset();
         }
 
+        /**
+         * @brief Returns the number of bytes handed out since the last reset, including alignment padding.
+         *
+         * Space left unused at the end of full pages is not counted.
+         */
+        std::size_t used_bytes() const noexcept { return full_pages_bytes_ + pages_.back()->used_bytes(); }
+
+        /**
+         * @brief Returns the number of bytes left in the current page before a new page is needed.
+         */
+        std::size_t remaining_bytes() const noexcept { return pages_.back()->remaining_bytes(); }
+
+        /**
+         * @brief Returns the number of pages currently held.
+         */
+        std::size_t page_count() const noexcept { return pages_.size(); }
+
+        /**
+         * @brief Returns the highest used_bytes() ever reached, across resets.
+         */
+        std::size_t high_water_mark() const noexcept { return std::max(high_water_mark_, used_bytes()); }
+
+        /**
+         * @brief Returns the bytes skipped to satisfy alignment, or 0 if the stats policy does not count.
+         */
+        std::size_t alignment_padding_bytes() const noexcept
+        {
+            return static_cast<std::size_t>(detail::stats_count<Stats>(*this, stats_event::padding_bytes));
+        }
+
+        /**
+         * @brief Returns the stats policy instance of this arena.
+         */
+        const Stats& stats() const noexcept { return *this; }
+
+        /**
+         * @brief Returns the page source of this arena.
+         */
+        const PageSource& page_source() const noexcept { return source_; }
+
     private:
-        std::vector<std::unique_ptr<memory_arena<PageSizeInBytes>>> pages_;
+        using page_type = memory_arena<PageSizeInBytes>;
+        using page_ptr  = detail::page_ptr<page_type, PageSource>;
+
+        std::vector<page_ptr> pages_;
+        PageSource            source_;
+        std::size_t           full_pages_bytes_ = 0; // used bytes of all pages but the last
+        std::size_t           high_water_mark_  = 0; // highest used_bytes() seen at a reset
     };
 
 } // namespace apus
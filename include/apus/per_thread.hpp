@@ -0,0 +1,292 @@
+#ifndef APUS_PER_THREAD_HPP
+#define APUS_PER_THREAD_HPP
+
+#include <new>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include <apus/config.hpp>
+
+namespace apus
+{
+
+    namespace detail
+    {
+        // hands out dense thread indices: each new thread takes the lowest free index
+        // and gives it back when it exits
+        class thread_index_registry
+        {
+        public:
+            static thread_index_registry& instance()
+            {
+                // intentionally leaked: threads may exit after static destruction
+                static thread_index_registry* registry = new thread_index_registry();
+                return *registry;
+            }
+
+            std::size_t acquire()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (free_.empty()) {
+                    return next_++;
+                }
+                std::pop_heap(free_.begin(), free_.end(), std::greater<>());
+                std::size_t index = free_.back();
+                free_.pop_back();
+                return index;
+            }
+
+            void release(std::size_t index)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.push_back(index);
+                std::push_heap(free_.begin(), free_.end(), std::greater<>());
+            }
+
+        private:
+            std::mutex               mutex_;
+            std::vector<std::size_t> free_; // min-heap of released indices
+            std::size_t              next_ = 0;
+        };
+
+        struct thread_index_holder
+        {
+            std::size_t index = thread_index_registry::instance().acquire();
+
+            ~thread_index_holder() { thread_index_registry::instance().release(index); }
+        };
+    } // namespace detail
+
+    /**
+     * @brief Returns the calling thread's index: a small number unique among live threads.
+     *
+     * Indices are dense: a new thread gets the lowest index not held by a live thread,
+     * so they can index arrays, and an index is reused once its thread has exited.
+     */
+    inline std::size_t this_thread_index()
+    {
+        static thread_local detail::thread_index_holder holder;
+        return holder.index;
+    }
+
+    /**
+     * @brief An enumerable thread-local value: one T per thread, each on its own cache lines.
+     *
+     * local() returns the calling thread's T, constructing it on first use. Values live
+     * in pages of PageSize slots that are allocated as thread indices (see
+     * this_thread_index) reach them and never move, so references stay valid until
+     * clear() or destruction. Each slot is aligned to and padded to whole cache lines,
+     * so threads updating their own values never share a line.
+     *
+     * for_each, combine and reduce visit the values of every thread that called local().
+     * They may run while other threads update their values, but then T must tolerate
+     * concurrent reads (e.g. std::atomic counters updated with relaxed load + store);
+     * otherwise call them once the threads are done.
+     *
+     * A value outlives its thread. A later thread that is given the same index takes it
+     * over, which keeps counters exact but means thread caches may be inherited.
+     *
+     * @tparam T The type of the per-thread value.
+     * @tparam PageSize The number of slots per page.
+     * @tparam MaxPages The number of pages; at most PageSize * MaxPages thread indices are supported.
+     */
+    template <typename T, std::size_t PageSize = 64, std::size_t MaxPages = 64>
+    class per_thread
+    {
+        static_assert(PageSize > 0 && MaxPages > 0, "PageSize and MaxPages must be greater than 0");
+
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        struct alignas(std::max(CACHE_LINE_SIZE, alignof(T))) slot
+        {
+            alignas(T) unsigned char storage[sizeof(T)]; // first, so the value starts a cache line
+            std::atomic<bool>        constructed{false};
+
+            T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        struct page
+        {
+            slot slots[PageSize];
+        };
+
+    public:
+        using value_type = T;
+
+        /**
+         * @brief Construct an empty per_thread whose values are value-initialized.
+         */
+        per_thread() = default;
+
+        /**
+         * @brief Construct an empty per_thread whose values are created by factory.
+         *
+         * factory is called by each thread on its first local(), on that thread.
+         */
+        explicit per_thread(std::function<T()> factory)
+            : factory_(std::move(factory)) {}
+
+        ~per_thread()
+        {
+            clear();
+            for (auto& p : pages_) {
+                delete p.load(std::memory_order_relaxed);
+            }
+        }
+
+        // disable copying and moving
+        per_thread(const per_thread&)            = delete;
+        per_thread& operator=(const per_thread&) = delete;
+        per_thread(per_thread&&)                 = delete;
+        per_thread& operator=(per_thread&&)      = delete;
+
+        /**
+         * @brief Returns the calling thread's value, constructing it on first use.
+         *
+         * @throws std::length_error If the thread index exceeds PageSize * MaxPages.
+         * @throws std::bad_alloc If a page cannot be allocated (see set_alloc_failure_handler).
+         */
+        T& local()
+        {
+            slot& s = slot_at(this_thread_index());
+            if (!s.constructed.load(std::memory_order_relaxed)) {
+                if (factory_) {
+                    ::new (s.storage) T(factory_());
+                } else {
+                    ::new (s.storage) T();
+                }
+                s.constructed.store(true, std::memory_order_release);
+                size_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return *s.get();
+        }
+
+        /**
+         * @brief Calls fn(value) for the value of every thread that has one.
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn)
+        {
+            visit([&](slot& s) { fn(*s.get()); });
+        }
+
+        /**
+         * @brief Calls fn(value) for the value of every thread that has one (const version).
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            visit([&](slot& s) { fn(std::as_const(*s.get())); });
+        }
+
+        /**
+         * @brief Folds all values with op, e.g. combine(std::plus<>()).
+         *
+         * @return T The combined value, or T() if no thread has a value.
+         */
+        template <typename BinaryOp>
+        T combine(BinaryOp op) const
+        {
+            std::optional<T> result;
+            for_each([&](const T& value) {
+                if (result) {
+                    result = op(std::move(*result), value);
+                } else {
+                    result.emplace(value);
+                }
+            });
+            return result ? std::move(*result) : T();
+        }
+
+        /**
+         * @brief Folds all values into init with fn(init, value); works for T that cannot be copied, like atomics.
+         */
+        template <typename U, typename Fn>
+        U reduce(U init, Fn fn) const
+        {
+            for_each([&](const T& value) { init = fn(std::move(init), value); });
+            return init;
+        }
+
+        /**
+         * @brief Destroys every value; threads get a fresh one on their next local().
+         *
+         * Must not run concurrently with local() or the visiting functions.
+         */
+        void clear() noexcept
+        {
+            visit([](slot& s) {
+                s.get()->~T();
+                s.constructed.store(false, std::memory_order_relaxed);
+            });
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the number of threads that hold a value.
+         */
+        std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns true if no thread holds a value.
+         */
+        bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Returns the number of thread indices that can hold a value.
+         */
+        static constexpr std::size_t capacity() noexcept { return PageSize * MaxPages; }
+
+    private:
+        slot& slot_at(std::size_t index)
+        {
+            std::size_t page_idx = index / PageSize;
+            if (page_idx >= MaxPages) {
+                detail::throw_error(std::length_error("per_thread: thread index exceeds capacity"));
+            }
+
+            page* p = pages_[page_idx].load(std::memory_order_acquire);
+            if (p == nullptr) {
+                page* fresh = new (std::nothrow) page();
+                if (fresh == nullptr) {
+                    detail::alloc_failure(sizeof(page));
+                }
+                // another thread of the same page may have won the race
+                if (pages_[page_idx].compare_exchange_strong(p, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    p = fresh;
+                } else {
+                    delete fresh;
+                }
+            }
+            return p->slots[index % PageSize];
+        }
+
+        // slots live in pages that are not part of the object, so const visitors still reach them mutably
+        template <typename Fn>
+        void visit(Fn&& fn) const
+        {
+            for (auto& entry : pages_) {
+                page* p = entry.load(std::memory_order_acquire);
+                if (p == nullptr) continue;
+                for (slot& s : p->slots) {
+                    if (s.constructed.load(std::memory_order_acquire)) fn(s);
+                }
+            }
+        }
+
+        std::array<std::atomic<page*>, MaxPages> pages_{};
+        std::atomic<std::size_t>                 size_{0};
+        std::function<T()>                       factory_; // empty: value-initialize
+    };
+
+} // namespace apus
+
+#endif // APUS_PER_THREAD_HPP
@@ -8,6 +8,9 @@
 #include <algorithm>
 #include <type_traits>
 
+#include <apus/config.hpp>
+#include <apus/stats_policy.hpp>
+
 namespace apus
 {
 
@@ -18,9 +21,10 @@ namespace apus
      * at both ends. It uses a contiguous block of memory and wraps around.
      *
      * @tparam T The type of elements to store.
+     * @tparam Stats The stats policy (see stats_policy.hpp); records overwrites and reallocations.
      */
-    template <typename T>
-    class ring_buffer
+    template <typename T, typename Stats = null_stats>
+    class ring_buffer : private Stats
     {
     public:
         using value_type      = T;
@@ -132,7 +136,7 @@ namespace apus
         {
             if (capacity_ > 0) {
                 data_ = static_cast<T*>(std::malloc(capacity_ * sizeof(T)));
-                if (!data_) throw std::bad_alloc();
+                if (!data_) detail::alloc_failure(capacity_ * sizeof(T));
             } else {
                 data_ = nullptr;
             }
@@ -146,7 +150,7 @@ namespace apus
         {
             if (capacity_ > 0) {
                 data_ = static_cast<T*>(std::malloc(capacity_ * sizeof(T)));
-                if (!data_) throw std::bad_alloc();
+                if (!data_) detail::alloc_failure(capacity_ * sizeof(T));
                 for (size_type i = 0; i < other.size(); ++i) {
                     push_back(other[i]);
                 }
@@ -191,7 +195,7 @@ namespace apus
                     capacity_ = other.capacity_;
                     if (capacity_ > 0) {
                         data_ = static_cast<T*>(std::malloc(capacity_ * sizeof(T)));
-                        if (!data_) throw std::bad_alloc();
+                        if (!data_) detail::alloc_failure(capacity_ * sizeof(T));
                     } else {
                         data_ = nullptr;
                     }
@@ -236,6 +240,7 @@ namespace apus
         {
             if (capacity_ == 0) return;
             if (full()) {
+                Stats::record(stats_event::overwrite);
                 data_[tail_].~T();
                 head_ = increment(head_);
             } else {
@@ -254,6 +259,7 @@ namespace apus
         {
             if (capacity_ == 0) return;
             if (full()) {
+                Stats::record(stats_event::overwrite);
                 data_[tail_].~T();
                 head_ = increment(head_);
             } else {
@@ -281,16 +287,31 @@ namespace apus
          * are removed to fit the new capacity.
          *
          * @param new_capacity The new capacity.
+         * @throws std::bad_alloc If the new buffer cannot be allocated (see set_alloc_failure_handler).
          */
         void set_capacity(size_type new_capacity)
         {
-            if (new_capacity == capacity_) return;
+            if (!try_set_capacity(new_capacity)) {
+                detail::alloc_failure(new_capacity * sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Changes the capacity of the ring buffer, leaving it untouched if allocation fails.
+         *
+         * @param new_capacity The new capacity.
+         * @return true If the capacity has been changed.
+         */
+        bool try_set_capacity(size_type new_capacity)
+        {
+            if (new_capacity == capacity_) return true;
 
             T* new_data = nullptr;
             if (new_capacity > 0) {
                 new_data = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
-                if (!new_data) throw std::bad_alloc();
+                if (!new_data) return false;
             }
+            Stats::record(stats_event::reallocation);
 
             size_type old_size         = size_;
             size_type elements_to_copy = std::min(old_size, new_capacity);
@@ -312,6 +333,7 @@ namespace apus
             size_     = elements_to_copy;
             head_     = 0;
             tail_     = (size_ == capacity_) ? 0 : size_;
+            return true;
         }
 
         /**
@@ -364,7 +386,7 @@ namespace apus
          */
         reference at(size_type index)
         {
-            if (index >= size_) throw std::out_of_range("ring_buffer::at: index out of range");
+            if (index >= size_) detail::throw_error(std::out_of_range("ring_buffer::at: index out of range"));
             return (*this)[index];
         }
 
@@ -373,10 +395,20 @@ namespace apus
          */
         const_reference at(size_type index) const
         {
-            if (index >= size_) throw std::out_of_range("ring_buffer::at: index out of range");
+            if (index >= size_) detail::throw_error(std::out_of_range("ring_buffer::at: index out of range"));
             return (*this)[index];
         }
 
+        /**
+         * @brief Returns a pointer to the element at index, or nullptr if index is out of range.
+         */
+        pointer try_at(size_type index) noexcept { return index < size_ ? &(*this)[index] : nullptr; }
+
+        /**
+         * @brief Returns a pointer to the element at index, or nullptr if index is out of range (const version).
+         */
+        const_pointer try_at(size_type index) const noexcept { return index < size_ ? &(*this)[index] : nullptr; }
+
         void clear() noexcept
         {
             while (!empty()) {
@@ -384,6 +416,11 @@ namespace apus
             }
         }
 
+        /**
+         * @brief Returns the stats policy instance of this ring_buffer.
+         */
+        const Stats& stats() const noexcept { return *this; }
+
         // clang-format off
         reference       front()          { return data_[head_];               }
         const_reference front()    const { return data_[head_];               }
@@ -0,0 +1,466 @@
+#ifndef APUS_SHARED_MEMORY_HPP
+#define APUS_SHARED_MEMORY_HPP
+
+#include <new>
+#include <atomic>
+#include <string>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <apus/config.hpp>
+
+namespace apus
+{
+
+    // number of named objects a shared memory region can hold
+    static constexpr std::size_t SHARED_MEMORY_MAX_OBJECTS = 32;
+
+    // longest object name, including the terminating zero
+    static constexpr std::size_t SHARED_MEMORY_MAX_NAME = 48;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+        "atomics placed in shared memory must be lock-free to work across processes");
+
+    /**
+     * @brief A pointer that stores the distance from itself to its target.
+     *
+     * An offset_ptr inside a shared memory region stays valid in every process that
+     * maps the region, whatever address the region is mapped at, as long as its target
+     * lives in the same region. Copying an offset_ptr recomputes the distance for the
+     * new location. The offset 1 stands for nullptr, since no object can start one byte
+     * into the pointer itself.
+     *
+     * @tparam T The type pointed to.
+     */
+    template <typename T>
+    class offset_ptr
+    {
+    public:
+        offset_ptr() noexcept = default;
+        offset_ptr(std::nullptr_t) noexcept {}
+        offset_ptr(T* ptr) noexcept { set(ptr); }
+        offset_ptr(const offset_ptr& other) noexcept { set(other.get()); }
+
+        offset_ptr& operator=(const offset_ptr& other) noexcept
+        {
+            set(other.get());
+            return *this;
+        }
+
+        offset_ptr& operator=(T* ptr) noexcept
+        {
+            set(ptr);
+            return *this;
+        }
+
+        /**
+         * @brief Returns the target address in the calling process, or nullptr.
+         */
+        T* get() const noexcept
+        {
+            if (offset_ == NULL_OFFSET) return nullptr;
+            return reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + offset_);
+        }
+
+        // clang-format off
+        T& operator*()  const noexcept { return *get(); }
+        T* operator->() const noexcept { return get();  }
+        explicit operator bool() const noexcept { return offset_ != NULL_OFFSET; }
+
+        friend bool operator==(const offset_ptr& a, const offset_ptr& b) noexcept { return a.get() == b.get(); }
+        friend bool operator!=(const offset_ptr& a, const offset_ptr& b) noexcept { return a.get() != b.get(); }
+        // clang-format on
+
+    private:
+        static constexpr std::ptrdiff_t NULL_OFFSET = 1;
+
+        void set(T* ptr) noexcept
+        {
+            offset_ = ptr ? reinterpret_cast<std::intptr_t>(ptr) - reinterpret_cast<std::intptr_t>(this) : NULL_OFFSET;
+        }
+
+        std::ptrdiff_t offset_ = NULL_OFFSET;
+    };
+
+    /**
+     * @brief The bookkeeping at the start of every shared memory region.
+     *
+     * It holds a bump allocator over the rest of the region and a fixed directory of
+     * named objects. Both are updated with atomics only, so any process mapping the
+     * region may allocate; objects are found by name with find().
+     */
+    class shared_memory_header
+    {
+    public:
+        // "apusshm" followed by the layout version
+        static constexpr std::uint64_t MAGIC = 0x6170757373686d01ull;
+
+        explicit shared_memory_header(std::size_t size) noexcept
+            : size_(size), used_(sizeof(shared_memory_header))
+        {
+            magic_.store(MAGIC, std::memory_order_release);
+        }
+
+        // disable copying and moving
+        shared_memory_header(const shared_memory_header&)            = delete;
+        shared_memory_header& operator=(const shared_memory_header&) = delete;
+        shared_memory_header(shared_memory_header&&)                 = delete;
+        shared_memory_header& operator=(shared_memory_header&&)      = delete;
+
+        /**
+         * @brief Checks if the region has been initialized by an apus creator.
+         */
+        bool valid() const noexcept { return magic_.load(std::memory_order_acquire) == MAGIC; }
+
+        /**
+         * @brief Allocates memory from the region.
+         *
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment requirement (at most the page size).
+         * @return void* Pointer to the memory, or nullptr if the region is exhausted.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            std::uint64_t used = used_.load(std::memory_order_relaxed);
+            std::uint64_t aligned;
+            do {
+                aligned = (used + alignment - 1) & ~(static_cast<std::uint64_t>(alignment) - 1);
+                if (aligned > size_ || bytes > size_ - aligned) {
+                    return nullptr;
+                }
+            } while (!used_.compare_exchange_weak(used, aligned + bytes, std::memory_order_relaxed));
+            return base() + aligned;
+        }
+
+        /**
+         * @brief Returns the object registered under name, or nullptr.
+         *
+         * @param name The name given to publish().
+         * @param size The expected size of the object; a different size does not match.
+         */
+        void* find(std::string_view name, std::size_t size) const noexcept
+        {
+            std::uint32_t count = std::min<std::uint32_t>(object_count_.load(std::memory_order_acquire),
+                                                          static_cast<std::uint32_t>(SHARED_MEMORY_MAX_OBJECTS));
+            for (std::uint32_t i = 0; i < count; ++i) {
+                const object_entry& entry  = objects_[i];
+                std::uint64_t       offset = entry.offset.load(std::memory_order_acquire);
+                if (offset != 0 && entry.size == size && name == entry.name) {
+                    return const_cast<std::byte*>(base()) + offset;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Registers an object of the region under name.
+         *
+         * @return true If the object was registered; false if the name is too long or the directory is full.
+         */
+        bool publish(std::string_view name, const void* object, std::size_t size) noexcept
+        {
+            if (name.size() >= SHARED_MEMORY_MAX_NAME) {
+                return false;
+            }
+            std::uint32_t index = object_count_.fetch_add(1, std::memory_order_acq_rel);
+            if (index >= SHARED_MEMORY_MAX_OBJECTS) {
+                return false;
+            }
+            object_entry& entry = objects_[index];
+            std::memcpy(entry.name, name.data(), name.size());
+            entry.name[name.size()] = '\0';
+            entry.size              = size;
+            entry.offset.store(static_cast<const std::byte*>(object) - base(), std::memory_order_release);
+            return true;
+        }
+
+        // clang-format off
+        std::size_t size()            const noexcept { return size_;                                 }
+        std::size_t used_bytes()      const noexcept { return used_.load(std::memory_order_relaxed); }
+        std::size_t remaining_bytes() const noexcept { return size_ - used_bytes();                  }
+        // clang-format on
+
+    private:
+        struct object_entry
+        {
+            char                       name[SHARED_MEMORY_MAX_NAME];
+            std::uint64_t              size;
+            std::atomic<std::uint64_t> offset; // from the start of the region, 0 until published
+        };
+
+        std::byte*       base() noexcept { return reinterpret_cast<std::byte*>(this); }
+        const std::byte* base() const noexcept { return reinterpret_cast<const std::byte*>(this); }
+
+        std::atomic<std::uint64_t> magic_{0};
+        std::uint64_t              size_;
+        std::atomic<std::uint64_t> used_;
+        std::atomic<std::uint32_t> object_count_{0};
+        object_entry               objects_[SHARED_MEMORY_MAX_OBJECTS] = {};
+    };
+
+    /**
+     * @brief A mapping of a POSIX shared memory object (shm_open or memfd) in this process.
+     *
+     * One process creates the region, by name with create() or anonymously with
+     * create_anonymous(), and constructs named objects in it. Others attach with
+     * open(name) or attach(fd), the latter with a descriptor received over a Unix
+     * socket, and look the objects up with find(). The region may be mapped at a
+     * different address in every process, so objects placed in it must not hold raw
+     * pointers: apus provides shared_ring_buffer and shared_slot_map, which store
+     * offsets, and offset_ptr for your own types.
+     *
+     * Objects in the region are never destroyed; the memory goes away with the last
+     * mapping once the name has been removed.
+     */
+    class shared_memory_region
+    {
+    public:
+        /**
+         * @brief Creates a named region of at least bytes, failing if the name exists.
+         *
+         * @param name The POSIX shared memory name, such as "/apus-queue".
+         * @param bytes The size of the region, including its header.
+         * @throws std::system_error If the object cannot be created or mapped; a half-made object is unlinked.
+         */
+        static shared_memory_region create(const std::string& name, std::size_t bytes)
+        {
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                detail::throw_error(std::system_error(errno, std::generic_category(), "shared_memory_region::create: " + name));
+            }
+            return initialize(fd, bytes, name.c_str());
+        }
+
+        /**
+         * @brief Opens the named region created by another process.
+         *
+         * @throws std::system_error If the object cannot be opened or mapped.
+         * @throws std::runtime_error If it is not an initialized apus region.
+         */
+        static shared_memory_region open(const std::string& name)
+        {
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                detail::throw_error(std::system_error(errno, std::generic_category(), "shared_memory_region::open: " + name));
+            }
+            return map_existing(fd);
+        }
+
+        /**
+         * @brief Creates a region without a name, to be passed to other processes by descriptor.
+         *
+         * Uses memfd_create on Linux and an immediately unlinked shm_open object elsewhere.
+         *
+         * @throws std::system_error If the object cannot be created or mapped.
+         */
+        static shared_memory_region create_anonymous(std::size_t bytes)
+        {
+#if defined(__linux__)
+            int fd = ::memfd_create("apus", MFD_CLOEXEC);
+#else
+            static std::atomic<unsigned> counter{0};
+            std::string name = "/apus-" + std::to_string(::getpid()) + "-" + std::to_string(counter.fetch_add(1));
+            int         fd   = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd >= 0) ::shm_unlink(name.c_str());
+#endif
+            if (fd < 0) {
+                detail::throw_error(std::system_error(errno, std::generic_category(), "shared_memory_region::create_anonymous"));
+            }
+            return initialize(fd, bytes);
+        }
+
+        /**
+         * @brief Maps the region behind a descriptor, such as one from fd() of another process.
+         *
+         * The descriptor is duplicated; the caller keeps ownership of fd.
+         */
+        static shared_memory_region attach(int fd)
+        {
+            int own = ::dup(fd);
+            if (own < 0) {
+                detail::throw_error(std::system_error(errno, std::generic_category(), "shared_memory_region::attach"));
+            }
+            return map_existing(own);
+        }
+
+        /**
+         * @brief Removes a named region. Existing mappings stay valid.
+         *
+         * @return true If the name existed and has been removed.
+         */
+        static bool remove(const std::string& name) noexcept { return ::shm_unlink(name.c_str()) == 0; }
+
+        shared_memory_region(shared_memory_region&& other) noexcept
+            : header_(std::exchange(other.header_, nullptr)), fd_(std::exchange(other.fd_, -1))
+        {
+        }
+
+        shared_memory_region& operator=(shared_memory_region&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                header_ = std::exchange(other.header_, nullptr);
+                fd_     = std::exchange(other.fd_, -1);
+            }
+            return *this;
+        }
+
+        ~shared_memory_region() { release(); }
+
+        // disable copying
+        shared_memory_region(const shared_memory_region&)            = delete;
+        shared_memory_region& operator=(const shared_memory_region&) = delete;
+
+        /**
+         * @brief Allocates memory from the region.
+         *
+         * @throws std::bad_alloc If the region is exhausted (see set_alloc_failure_handler).
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            void* ptr = header_->try_allocate(bytes, alignment);
+            if (ptr == nullptr) {
+                detail::alloc_failure(bytes);
+            }
+            return ptr;
+        }
+
+        /**
+         * @brief Allocates memory from the region, or returns nullptr if it is exhausted.
+         */
+        void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            return header_->try_allocate(bytes, alignment);
+        }
+
+        /**
+         * @brief Constructs an object in the region and registers it under name.
+         *
+         * @tparam T The object type. Must be trivially destructible and hold no raw pointers.
+         * @param name The name other processes pass to find(), shorter than SHARED_MEMORY_MAX_NAME.
+         * @param args Arguments forwarded to the constructor of T.
+         * @return T& The object.
+         * @throws std::bad_alloc If the region is exhausted.
+         * @throws std::length_error If the name is too long or the directory is full.
+         * @throws std::logic_error If an object of that name and size already exists.
+         */
+        template <typename T, typename... Args>
+        T& construct(std::string_view name, Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "objects in shared memory are never destroyed");
+
+            if (name.size() >= SHARED_MEMORY_MAX_NAME) {
+                detail::throw_error(std::length_error("shared_memory_region::construct: name too long"));
+            }
+            if (find<T>(name) != nullptr) {
+                detail::throw_error(std::logic_error("shared_memory_region::construct: name already in use"));
+            }
+
+            T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if (!header_->publish(name, object, sizeof(T))) {
+                detail::throw_error(std::length_error("shared_memory_region::construct: object directory is full"));
+            }
+            return *object;
+        }
+
+        /**
+         * @brief Finds an object constructed in the region by any process.
+         *
+         * @return T* The object, or nullptr if no object of that name and size exists.
+         */
+        template <typename T>
+        T* find(std::string_view name) const noexcept
+        {
+            return static_cast<T*>(header_->find(name, sizeof(T)));
+        }
+
+        // clang-format off
+        shared_memory_header& header()           noexcept { return *header_;              }
+        void*                 data()             noexcept { return header_;               }
+        int                   fd()         const noexcept { return fd_;                   }
+        std::size_t           size()       const noexcept { return header_->size();       }
+        std::size_t           used_bytes() const noexcept { return header_->used_bytes(); }
+        // clang-format on
+
+    private:
+        shared_memory_region(shared_memory_header* header, int fd) noexcept : header_(header), fd_(fd) {}
+
+        // sizes and maps a new object; on failure it is unlinked as well, if it was created under unlink_name
+        static shared_memory_region initialize(int fd, std::size_t bytes, const char* unlink_name = nullptr)
+        {
+            std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            bytes            = (std::max(bytes, sizeof(shared_memory_header)) + page - 1) / page * page;
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+                fail(fd, "shared_memory_region: ftruncate", unlink_name);
+            }
+            void* base = map(fd, bytes, unlink_name);
+            return shared_memory_region(new (base) shared_memory_header(bytes), fd);
+        }
+
+        static shared_memory_region map_existing(int fd)
+        {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                fail(fd, "shared_memory_region: fstat");
+            }
+            std::size_t bytes = static_cast<std::size_t>(st.st_size);
+            if (bytes < sizeof(shared_memory_header)) {
+                ::close(fd);
+                detail::throw_error(std::runtime_error("shared_memory_region: not an apus region"));
+            }
+
+            auto* header = static_cast<shared_memory_header*>(map(fd, bytes));
+            if (!header->valid() || header->size() != bytes) {
+                ::munmap(header, bytes);
+                ::close(fd);
+                detail::throw_error(std::runtime_error("shared_memory_region: not an apus region or not initialized yet"));
+            }
+            return shared_memory_region(header, fd);
+        }
+
+        static void* map(int fd, std::size_t bytes, const char* unlink_name = nullptr)
+        {
+            void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED) {
+                fail(fd, "shared_memory_region: mmap", unlink_name);
+            }
+            return base;
+        }
+
+        // closes fd, unlinks unlink_name if given, and reports errno
+        [[noreturn]] static void fail(int fd, const char* what, const char* unlink_name = nullptr)
+        {
+            int error = errno;
+            ::close(fd);
+            if (unlink_name != nullptr) ::shm_unlink(unlink_name);
+            detail::throw_error(std::system_error(error, std::generic_category(), what));
+        }
+
+        void release() noexcept
+        {
+            if (header_ != nullptr) ::munmap(header_, header_->size());
+            if (fd_ >= 0) ::close(fd_);
+            header_ = nullptr;
+            fd_     = -1;
+        }
+
+        shared_memory_header* header_;
+        int                   fd_;
+    };
+
+} // namespace apus
+
+#endif // APUS_SHARED_MEMORY_HPP
@@ -0,0 +1,134 @@
+#ifndef APUS_SHARED_RING_BUFFER_HPP
+#define APUS_SHARED_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace apus
+{
+
+    /**
+     * @brief A single-producer single-consumer queue that can live in shared memory.
+     *
+     * Unlike ring_buffer, the slots are stored inline and the capacity is fixed at
+     * compile time, so the queue holds no pointers and works at any address. Construct
+     * it in a shared_memory_region and let one process push and another pop; elements
+     * are copied once into the region and can be read in place with front(), without
+     * a socket round trip.
+     *
+     * head and tail are unbounded 64-bit counters masked into the slots, on separate
+     * cache lines. Each side keeps a cached copy of the other side's counter, so it
+     * only touches the other side's cache line when the queue looks full or empty.
+     *
+     * @tparam T The element type. Must be default constructible, trivially copyable and hold no raw pointers.
+     * @tparam Capacity The number of slots, a power of two.
+     */
+    template <typename T, std::size_t Capacity>
+    class shared_ring_buffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "shared_ring_buffer requires a trivially copyable T");
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+        // keeps the producer's and the consumer's counters on separate cache lines
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+        static constexpr std::size_t MASK            = Capacity - 1;
+
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        shared_ring_buffer() noexcept = default;
+
+        // disable copying and moving
+        shared_ring_buffer(const shared_ring_buffer&)            = delete;
+        shared_ring_buffer& operator=(const shared_ring_buffer&) = delete;
+        shared_ring_buffer(shared_ring_buffer&&)                 = delete;
+        shared_ring_buffer& operator=(shared_ring_buffer&&)      = delete;
+
+        /**
+         * @brief Appends an element. Producer only.
+         *
+         * @return true If the element was appended; false if the queue is full.
+         */
+        bool try_push(const T& value) noexcept
+        {
+            std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == Capacity) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == Capacity) {
+                    return false;
+                }
+            }
+            slots_[tail & MASK] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest element into out. Consumer only.
+         *
+         * @return true If an element was removed; false if the queue is empty.
+         */
+        bool try_pop(T& out) noexcept
+        {
+            const T* value = front();
+            if (value == nullptr) {
+                return false;
+            }
+            out = *value;
+            pop();
+            return true;
+        }
+
+        /**
+         * @brief Returns the oldest element in place, or nullptr if the queue is empty. Consumer only.
+         *
+         * The element stays valid until pop().
+         */
+        const T* front() noexcept
+        {
+            std::uint64_t head = head_.load(std::memory_order_relaxed);
+            if (head == cached_tail_) {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (head == cached_tail_) {
+                    return nullptr;
+                }
+            }
+            return &slots_[head & MASK];
+        }
+
+        /**
+         * @brief Removes the oldest element. Consumer only; the queue must not be empty.
+         */
+        void pop() noexcept
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Returns the number of elements; exact only when neither side is active.
+         */
+        size_type size() const noexcept
+        {
+            std::uint64_t head = head_.load(std::memory_order_acquire);
+            return static_cast<size_type>(tail_.load(std::memory_order_acquire) - head);
+        }
+
+        // clang-format off
+        bool                      empty()    const noexcept { return size() == 0; }
+        static constexpr size_type capacity()      noexcept { return Capacity;    }
+        // clang-format on
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head_{0}; // next slot to pop, written by the consumer
+        std::uint64_t cached_tail_ = 0;                               // the consumer's last view of tail_
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail_{0}; // next slot to push, written by the producer
+        std::uint64_t cached_head_ = 0;                               // the producer's last view of head_
+        alignas(CACHE_LINE_SIZE) T slots_[Capacity];
+    };
+
+} // namespace apus
+
+#endif // APUS_SHARED_RING_BUFFER_HPP
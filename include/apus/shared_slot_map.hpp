@@ -0,0 +1,273 @@
+#ifndef APUS_SHARED_SLOT_MAP_HPP
+#define APUS_SHARED_SLOT_MAP_HPP
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <apus/config.hpp>
+#include <apus/slot_map.hpp>
+#include <apus/shared_memory.hpp>
+
+namespace apus
+{
+
+    // default number of elements per page of a shared_slot_map
+    static constexpr std::size_t DEFAULT_SHARED_SLOT_MAP_PAGE_SIZE = 256;
+
+    // default number of entries in the page directory of a shared_slot_map
+    static constexpr std::size_t DEFAULT_SHARED_SLOT_MAP_MAX_PAGES = 256;
+
+    /**
+     * @brief A read-mostly slot map that can live in shared memory.
+     *
+     * One process at a time writes (add, update, remove) and any number of processes
+     * read concurrently through handles. Like slot_map, elements are stored in pages
+     * and addressed by {index, version} handles. The pages come from the bump allocator
+     * of the shared_memory_region the map is constructed in. They are listed in a fixed
+     * directory of MaxPages offset_ptrs, so every process can resolve them wherever it
+     * maps the region.
+     *
+     * Readers never block the writer. Each slot has a version word: bit 0 is set while
+     * the writer changes the value, bit 1 while the slot is live, and the rest is the
+     * generation. read() copies the value and then checks that the word did not change
+     * meanwhile, like a seqlock, and retries if it did.
+     *
+     * @tparam T The element type. Must be trivially copyable and hold no raw pointers.
+     * @tparam PageSize The number of elements per page.
+     * @tparam MaxPages The number of pages the directory can hold.
+     */
+    template <typename T, std::size_t PageSize = DEFAULT_SHARED_SLOT_MAP_PAGE_SIZE,
+              std::size_t MaxPages = DEFAULT_SHARED_SLOT_MAP_MAX_PAGES>
+    class shared_slot_map
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "shared_slot_map requires a trivially copyable T");
+        static_assert(PageSize > 0 && MaxPages > 0, "PageSize and MaxPages must be greater than 0");
+        static_assert(PageSize * MaxPages <= UINT32_MAX, "indices must fit in 32 bits");
+
+        static constexpr std::uint32_t BUSY_BIT        = 1u;
+        static constexpr std::uint32_t LIVE_BIT        = 2u;
+        static constexpr std::uint32_t GENERATION_STEP = 4u;
+        static constexpr std::uint32_t NIL             = UINT32_MAX;
+
+        struct page
+        {
+            std::atomic<std::uint32_t> versions[PageSize];
+            std::uint32_t              next_free[PageSize]; // free list links, writer only
+            T                          values[PageSize];
+        };
+
+    public:
+        using handle     = slot_map_handle<T>;
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Construct a new map whose pages are allocated from region.
+         *
+         * The map itself must be constructed in region too, see shared_memory_region::construct.
+         */
+        explicit shared_slot_map(shared_memory_region& region) noexcept : header_(&region.header()) {}
+
+        // disable copying and moving
+        shared_slot_map(const shared_slot_map&)            = delete;
+        shared_slot_map& operator=(const shared_slot_map&) = delete;
+        shared_slot_map(shared_slot_map&&)                 = delete;
+        shared_slot_map& operator=(shared_slot_map&&)      = delete;
+
+        /**
+         * @brief Adds an element. Writer only.
+         *
+         * @return handle A stable handle to the element.
+         * @throws std::bad_alloc If the region or the page directory is exhausted.
+         */
+        handle add(const T& value)
+        {
+            std::optional<handle> h = try_add(value);
+            if (!h) {
+                detail::alloc_failure(sizeof(page));
+            }
+            return *h;
+        }
+
+        /**
+         * @brief Adds an element, or returns nullopt if the region or the page directory is exhausted. Writer only.
+         */
+        std::optional<handle> try_add(const T& value) noexcept
+        {
+            std::uint32_t index = free_head_;
+            if (index != NIL) {
+                free_head_ = page_of(index).next_free[index % PageSize];
+            } else {
+                if (next_index_ == page_count_.load(std::memory_order_relaxed) * PageSize && !add_page()) {
+                    return std::nullopt;
+                }
+                index = next_index_++;
+            }
+
+            std::atomic<std::uint32_t>& version = page_of(index).versions[index % PageSize];
+            std::uint32_t               live    = (version.load(std::memory_order_relaxed) & ~(BUSY_BIT | LIVE_BIT)) + GENERATION_STEP;
+            live |= LIVE_BIT;
+            write(index, live, value);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return handle{index, live};
+        }
+
+        /**
+         * @brief Replaces the value of a live element. Writer only.
+         *
+         * @return true If the handle was valid and the value has been replaced.
+         */
+        bool update(handle h, const T& value) noexcept
+        {
+            if (!contains(h)) {
+                return false;
+            }
+            write(h.index, h.version, value);
+            return true;
+        }
+
+        /**
+         * @brief Removes an element. Writer only.
+         *
+         * @throws std::out_of_range If the handle is invalid or the element is already removed.
+         */
+        void remove(handle h)
+        {
+            if (!try_remove(h)) {
+                detail::throw_error(std::out_of_range("shared_slot_map::remove: invalid handle or object already removed"));
+            }
+        }
+
+        /**
+         * @brief Removes an element if the handle refers to a live one. Writer only.
+         *
+         * @return true If the element was live and has been removed.
+         */
+        bool try_remove(handle h) noexcept
+        {
+            if (!contains(h)) {
+                return false;
+            }
+            page& p = page_of(h.index);
+            p.versions[h.index % PageSize].store(h.version & ~LIVE_BIT, std::memory_order_release);
+            p.next_free[h.index % PageSize] = free_head_;
+            free_head_                      = h.index;
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Copies the element behind a handle into out. Safe from any process and thread.
+         *
+         * @return true If the handle was valid; out holds a consistent copy of the value.
+         */
+        bool read(handle h, T& out) const noexcept
+        {
+            if (h.index >= page_count_.load(std::memory_order_acquire) * PageSize) {
+                return false;
+            }
+            const page&                       p       = page_of(h.index);
+            const std::atomic<std::uint32_t>& version = p.versions[h.index % PageSize];
+            for (;;) {
+                std::uint32_t before = version.load(std::memory_order_acquire);
+                if ((before & ~BUSY_BIT) != h.version) {
+                    return false;
+                }
+                if (before == h.version) {
+                    std::memcpy(static_cast<void*>(&out), &p.values[h.index % PageSize], sizeof(T));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (version.load(std::memory_order_relaxed) == before) {
+                        return true;
+                    }
+                }
+                // the writer is updating this element, try again
+            }
+        }
+
+        /**
+         * @brief Returns a copy of the element behind a handle, or nullopt. Safe from any process and thread.
+         */
+        std::optional<T> read(handle h) const noexcept
+        {
+            T value;
+            if (!read(h, value)) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        /**
+         * @brief Returns the element behind a handle for in-place access by the writer, or nullptr.
+         *
+         * Concurrent readers only see changes made through update().
+         */
+        const T* find(handle h) const noexcept
+        {
+            return contains(h) ? &page_of(h.index).values[h.index % PageSize] : nullptr;
+        }
+
+        /**
+         * @brief Checks if the handle refers to a live element.
+         */
+        bool contains(handle h) const noexcept
+        {
+            if (h.index >= page_count_.load(std::memory_order_acquire) * PageSize) {
+                return false;
+            }
+            return (page_of(h.index).versions[h.index % PageSize].load(std::memory_order_acquire) & ~BUSY_BIT) == h.version;
+        }
+
+        // clang-format off
+        size_type                  size()       const noexcept { return size_.load(std::memory_order_relaxed);       }
+        bool                       empty()      const noexcept { return size() == 0;                                 }
+        size_type                  page_count() const noexcept { return page_count_.load(std::memory_order_relaxed); }
+        static constexpr size_type capacity()         noexcept { return PageSize * MaxPages;                         }
+        // clang-format on
+
+    private:
+        page& page_of(std::uint32_t index) noexcept { return *pages_[index / PageSize]; }
+        const page& page_of(std::uint32_t index) const noexcept { return *pages_[index / PageSize]; }
+
+        bool add_page() noexcept
+        {
+            std::uint32_t count = page_count_.load(std::memory_order_relaxed);
+            if (count == MaxPages) {
+                return false;
+            }
+            void* memory = header_->try_allocate(sizeof(page), alignof(page));
+            if (memory == nullptr) {
+                return false;
+            }
+            pages_[count] = new (memory) page();
+            // publishes the directory entry before readers may index into the page
+            page_count_.store(count + 1, std::memory_order_release);
+            return true;
+        }
+
+        void write(std::uint32_t index, std::uint32_t final_version, const T& value) noexcept
+        {
+            page&                       p       = page_of(index);
+            std::atomic<std::uint32_t>& version = p.versions[index % PageSize];
+            version.store(final_version | BUSY_BIT, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(static_cast<void*>(&p.values[index % PageSize]), &value, sizeof(T));
+            version.store(final_version, std::memory_order_release);
+        }
+
+        offset_ptr<shared_memory_header> header_;
+        offset_ptr<page>                 pages_[MaxPages];
+        std::atomic<std::uint32_t>       page_count_{0}; // published pages, read by every process
+        std::atomic<std::uint32_t>       size_{0};       // live elements
+        std::uint32_t                    next_index_ = 0;   // writer only
+        std::uint32_t                    free_head_  = NIL; // writer only
+    };
+
+} // namespace apus
+
+#endif // APUS_SHARED_SLOT_MAP_HPP
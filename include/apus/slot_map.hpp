@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include <apus/config.hpp>
 #include <apus/typed_memory_arena.hpp>
 
 namespace apus
@@ -218,25 +219,28 @@ namespace apus
         void remove(handle h)
         {
             if (h.index >= storage_arena_.size()) {
-                throw std::out_of_range("slot_map::remove: handle index out of bounds");
+                detail::throw_error(std::out_of_range("slot_map::remove: handle index out of bounds"));
             }
-
-            std::uint32_t& version = versions_arena_[h.index];
             // if the version matches exactly, it must be live (because handles don't have dead_bit set)
-            if (version != h.version) {
-                throw std::out_of_range("slot_map::remove: handle version mismatch or object already removed");
+            if (versions_arena_[h.index] != h.version) {
+                detail::throw_error(std::out_of_range("slot_map::remove: handle version mismatch or object already removed"));
             }
+            remove_at(h.index);
+        }
 
-            // invoke deleter
-            Deleter()(storage_arena_.get_address(h.index));
-
-            // set dead bit to invalidate existing handles
-            version |= DEAD_BIT;
-
-            // deallocate from arena
-            storage_arena_.deallocate(h.index);
-
-            current_size_--;
+        /**
+         * @brief Removes an object from the slot_map if the handle refers to a live object.
+         *
+         * @param h The handle of the object to remove.
+         * @return true If the object was live and has been removed.
+         */
+        bool try_remove(handle h)
+        {
+            if (h.index >= storage_arena_.size() || versions_arena_[h.index] != h.version) {
+                return false;
+            }
+            remove_at(h.index);
+            return true;
         }
 
         /**
@@ -249,7 +253,7 @@ namespace apus
         T& at(handle h)
         {
             if (h.index >= storage_arena_.size() || versions_arena_[h.index] != h.version) {
-                throw std::out_of_range("slot_map::at: invalid handle or object removed");
+                detail::throw_error(std::out_of_range("slot_map::at: invalid handle or object removed"));
             }
             return storage_arena_[h.index];
         }
@@ -264,7 +268,7 @@ namespace apus
         const T& at(handle h) const
         {
             if (h.index >= storage_arena_.size() || versions_arena_[h.index] != h.version) {
-                throw std::out_of_range("slot_map::at: invalid handle or object removed");
+                detail::throw_error(std::out_of_range("slot_map::at: invalid handle or object removed"));
             }
             return storage_arena_[h.index];
         }
@@ -351,6 +355,20 @@ namespace apus
         // clang-format on
 
     private:
+        void remove_at(std::uint32_t index)
+        {
+            // invoke deleter
+            Deleter()(storage_arena_.get_address(index));
+
+            // set dead bit to invalidate existing handles
+            versions_arena_[index] |= DEAD_BIT;
+
+            // deallocate from arena
+            storage_arena_.deallocate(index);
+
+            current_size_--;
+        }
+
         template <typename U>
         handle add_impl(U&& obj)
         {
@@ -7,6 +7,9 @@
 #include <algorithm>
 #include <initializer_list>
 
+#include <apus/config.hpp>
+#include <apus/stats_policy.hpp>
+
 namespace apus
 {
 
@@ -18,9 +21,10 @@ namespace apus
      *
      * @tparam T The type of elements to store.
      * @tparam N The number of elements to store inline.
+     * @tparam Stats The stats policy (see stats_policy.hpp); records heap spills and reallocations.
      */
-    template <typename T, std::size_t N>
-    class small_vector
+    template <typename T, std::size_t N, typename Stats = null_stats>
+    class small_vector : private Stats
     {
     public:
         using value_type      = T;
@@ -255,16 +259,30 @@ namespace apus
          * @brief Reserves capacity for at least count elements.
          *
          * @param new_cap Minimum capacity for the vector.
+         * @throws std::bad_alloc If the new buffer cannot be allocated (see set_alloc_failure_handler).
          */
         void reserve(size_type new_cap)
+        {
+            if (!try_reserve(new_cap)) {
+                detail::alloc_failure(new_cap * sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Reserves capacity for at least count elements, leaving the vector untouched if allocation fails.
+         *
+         * @param new_cap Minimum capacity for the vector.
+         * @return true If the capacity is at least new_cap.
+         */
+        bool try_reserve(size_type new_cap)
         {
             if (new_cap <= capacity_) {
-                return;
+                return true;
             }
 
             T* new_data = static_cast<T*>(std::malloc(new_cap * sizeof(T)));
             if (!new_data) {
-                throw std::bad_alloc();
+                return false;
             }
 
             for (size_type i = 0; i < size_; ++i) {
@@ -274,10 +292,14 @@ namespace apus
 
             if (!is_inline()) {
                 std::free(data_);
+            } else {
+                Stats::record(stats_event::heap_spill);
             }
+            Stats::record(stats_event::reallocation);
 
             data_     = new_data;
             capacity_ = new_cap;
+            return true;
         }
 
         /**
@@ -322,7 +344,7 @@ namespace apus
         reference at(size_type index)
         {
             if (index >= size_) {
-                throw std::out_of_range("small_vector::at: index out of range");
+                detail::throw_error(std::out_of_range("small_vector::at: index out of range"));
             }
             return data_[index];
         }
@@ -337,11 +359,27 @@ namespace apus
         const_reference at(size_type index) const
         {
             if (index >= size_) {
-                throw std::out_of_range("small_vector::at: index out of range");
+                detail::throw_error(std::out_of_range("small_vector::at: index out of range"));
             }
             return data_[index];
         }
 
+        /**
+         * @brief Accesses an element at a given index with bounds checking, without failing loudly.
+         *
+         * @param index The index of the element.
+         * @return pointer Pointer to the element, or nullptr if index is out of bounds.
+         */
+        pointer try_at(size_type index) noexcept { return index < size_ ? data_ + index : nullptr; }
+
+        /**
+         * @brief Accesses an element at a given index with bounds checking, without failing loudly (const version).
+         *
+         * @param index The index of the element.
+         * @return const_pointer Pointer to the element, or nullptr if index is out of bounds.
+         */
+        const_pointer try_at(size_type index) const noexcept { return index < size_ ? data_ + index : nullptr; }
+
         /**
          * @brief Accesses an element at a given index.
          *
@@ -486,6 +524,11 @@ namespace apus
             return false;
         }
 
+        /**
+         * @brief Returns the stats policy instance of this small_vector.
+         */
+        const Stats& stats() const noexcept { return *this; }
+
         // iterators
         // clang-format off
         iterator       begin()        noexcept { return data_;         }
@@ -0,0 +1,355 @@
+#ifndef APUS_SPARSE_SET_HPP
+#define APUS_SPARSE_SET_HPP
+
+#include <array>
+#include <tuple>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+#include <apus/config.hpp>
+#include <apus/slot_map.hpp>
+
+namespace apus
+{
+
+    // default number of sparse entries per page for sparse_set
+    static constexpr std::size_t DEFAULT_SPARSE_SET_PAGE_SIZE = 1024;
+
+    /**
+     * @brief A sparse set that attaches optional values to slot_map handles.
+     *
+     * Values are stored packed in a dense array, so iterating over them is a linear
+     * scan of contiguous memory. A paged sparse array indexed by handle index maps
+     * each handle to its position in the dense array. Pages are only allocated for
+     * index ranges that are actually used. The handle of each value is stored next
+     * to it and its version is checked on lookup, so stale handles never resolve.
+     *
+     * Removal swaps the last value into the removed position, so the order of the
+     * dense array is not stable and pointers to values are invalidated.
+     *
+     * @tparam T The type of values to attach.
+     * @tparam Key The value type of the slot_map whose handles are used as keys.
+     * @tparam PageSize The number of sparse entries per page.
+     */
+    template <typename T, typename Key, std::size_t PageSize = DEFAULT_SPARSE_SET_PAGE_SIZE>
+    class sparse_set
+    {
+        static_assert(PageSize > 0, "PageSize must be greater than 0");
+
+        // marks a sparse entry that has no dense counterpart
+        static constexpr std::uint32_t NPOS = std::numeric_limits<std::uint32_t>::max();
+
+        using page_type = std::array<std::uint32_t, PageSize>;
+
+    public:
+        using value_type     = T;
+        using size_type      = std::size_t;
+        using handle         = slot_map_handle<Key>;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        /**
+         * @brief Construct a new, empty sparse_set.
+         */
+        sparse_set() = default;
+
+        /**
+         * @brief Copy constructor.
+         */
+        sparse_set(const sparse_set& other)
+            : values_(other.values_), handles_(other.handles_)
+        {
+            pages_.reserve(other.pages_.size());
+            for (const auto& page : other.pages_) {
+                pages_.emplace_back(page ? std::make_unique<page_type>(*page) : nullptr);
+            }
+        }
+
+        /**
+         * @brief Copy assignment operator.
+         */
+        sparse_set& operator=(const sparse_set& other)
+        {
+            if (this != &other) {
+                sparse_set temp(other);
+                *this = std::move(temp);
+            }
+            return *this;
+        }
+
+        // enable moving
+        sparse_set(sparse_set&&) noexcept            = default;
+        sparse_set& operator=(sparse_set&&) noexcept = default;
+
+        /**
+         * @brief Attaches a value to a handle, replacing any value attached to the same index.
+         *
+         * @param h The handle to attach the value to.
+         * @param value The value to attach.
+         * @return T& Reference to the stored value.
+         */
+        T& insert(handle h, const T& value)
+        {
+            return emplace(h, value);
+        }
+
+        /**
+         * @brief Attaches a value to a handle using move semantics.
+         *
+         * @param h The handle to attach the value to.
+         * @param value The value to attach (rvalue reference).
+         * @return T& Reference to the stored value.
+         */
+        T& insert(handle h, T&& value)
+        {
+            return emplace(h, std::move(value));
+        }
+
+        /**
+         * @brief Constructs a value in-place for a handle.
+         *
+         * If a value is already attached to the handle's index (from this or an older
+         * version of the handle), it is replaced.
+         *
+         * @param h The handle to attach the value to.
+         * @param args Arguments to construct the value with.
+         * @return T& Reference to the stored value.
+         */
+        template <typename... Args>
+        T& emplace(handle h, Args&&... args)
+        {
+            std::uint32_t& slot = sparse_slot(h.index);
+            if (slot != NPOS) {
+                values_[slot]  = T(std::forward<Args>(args)...);
+                handles_[slot] = h;
+                return values_[slot];
+            }
+
+            values_.emplace_back(std::forward<Args>(args)...);
+            handles_.push_back(h);
+            slot = static_cast<std::uint32_t>(values_.size() - 1);
+            return values_.back();
+        }
+
+        /**
+         * @brief Detaches the value of a handle.
+         *
+         * The last value of the dense array is moved into the freed position.
+         *
+         * @param h The handle whose value to remove.
+         * @return true If a value was attached to the handle and has been removed.
+         */
+        bool remove(handle h)
+        {
+            std::uint32_t* slot = find_slot(h);
+            if (!slot) {
+                return false;
+            }
+
+            std::uint32_t pos  = *slot;
+            std::uint32_t last = static_cast<std::uint32_t>(values_.size() - 1);
+            if (pos != last) {
+                values_[pos]  = std::move(values_[last]);
+                handles_[pos] = handles_[last];
+                *sparse_entry(handles_[pos].index) = pos;
+            }
+            values_.pop_back();
+            handles_.pop_back();
+            *slot = NPOS;
+            return true;
+        }
+
+        /**
+         * @brief Finds the value attached to a handle.
+         *
+         * @param h The handle to look up.
+         * @return T* A pointer to the value if attached, nullptr otherwise.
+         */
+        T* find(handle h)
+        {
+            const std::uint32_t* slot = find_slot(h);
+            return slot ? &values_[*slot] : nullptr;
+        }
+
+        /**
+         * @brief Finds the value attached to a handle (const version).
+         *
+         * @param h The handle to look up.
+         * @return const T* A pointer to the value if attached, nullptr otherwise.
+         */
+        const T* find(handle h) const
+        {
+            const std::uint32_t* slot = find_slot(h);
+            return slot ? &values_[*slot] : nullptr;
+        }
+
+        /**
+         * @brief Accesses the value attached to a handle with validation.
+         *
+         * @param h The handle to look up.
+         * @return T& Reference to the value.
+         * @throws std::out_of_range If no value is attached to the handle.
+         */
+        T& at(handle h)
+        {
+            T* value = find(h);
+            if (!value) detail::throw_error(std::out_of_range("sparse_set::at: no value attached to handle"));
+            return *value;
+        }
+
+        /**
+         * @brief Accesses the value attached to a handle with validation (const version).
+         *
+         * @param h The handle to look up.
+         * @return const T& Reference to the value.
+         * @throws std::out_of_range If no value is attached to the handle.
+         */
+        const T& at(handle h) const
+        {
+            const T* value = find(h);
+            if (!value) detail::throw_error(std::out_of_range("sparse_set::at: no value attached to handle"));
+            return *value;
+        }
+
+        /**
+         * @brief Accesses the value attached to a handle (no validation).
+         *
+         * Use with caution. A value must be attached to the handle.
+         */
+        T& operator[](handle h) { return values_[*sparse_entry(h.index)]; }
+
+        /**
+         * @brief Accesses the value attached to a handle (no validation, const version).
+         */
+        const T& operator[](handle h) const { return values_[*sparse_entry(h.index)]; }
+
+        /**
+         * @brief Checks if a value is attached to the handle.
+         */
+        bool contains(handle h) const { return find_slot(h) != nullptr; }
+
+        /**
+         * @brief Removes all values, keeping the allocated sparse pages.
+         */
+        void clear() noexcept
+        {
+            for (const handle& h : handles_) {
+                *sparse_entry(h.index) = NPOS;
+            }
+            values_.clear();
+            handles_.clear();
+        }
+
+        /**
+         * @brief Returns the handle that owns the value at a dense position.
+         *
+         * @param pos Position in the dense array, in [0, size()).
+         * @return handle The owning handle.
+         */
+        handle handle_at(size_type pos) const { return handles_[pos]; }
+
+        /**
+         * @brief Returns the dense array of owning handles, parallel to data().
+         */
+        const handle* handles() const noexcept { return handles_.data(); }
+
+        // clang-format off
+        T*             data()         noexcept { return values_.data();  }
+        const T*       data()   const noexcept { return values_.data();  }
+        size_type      size()   const noexcept { return values_.size();  }
+        bool           empty()  const noexcept { return values_.empty(); }
+
+        iterator       begin()        noexcept { return values_.data();                  }
+        iterator       end()          noexcept { return values_.data() + values_.size(); }
+        const_iterator begin()  const noexcept { return values_.data();                  }
+        const_iterator end()    const noexcept { return values_.data() + values_.size(); }
+        const_iterator cbegin() const noexcept { return values_.data();                  }
+        const_iterator cend()   const noexcept { return values_.data() + values_.size(); }
+        // clang-format on
+
+    private:
+        // sparse entry for an index, or nullptr if its page was never allocated
+        std::uint32_t* sparse_entry(std::uint32_t index) const
+        {
+            std::size_t page_idx = index / PageSize;
+            if (page_idx >= pages_.size() || !pages_[page_idx]) {
+                return nullptr;
+            }
+            return pages_[page_idx]->data() + index % PageSize;
+        }
+
+        // sparse entry for an index, allocating its page on demand
+        std::uint32_t& sparse_slot(std::uint32_t index)
+        {
+            std::size_t page_idx = index / PageSize;
+            if (page_idx >= pages_.size()) {
+                pages_.resize(page_idx + 1);
+            }
+            if (!pages_[page_idx]) {
+                pages_[page_idx] = std::make_unique<page_type>();
+                pages_[page_idx]->fill(NPOS);
+            }
+            return (*pages_[page_idx])[index % PageSize];
+        }
+
+        // sparse entry for a handle if a value is attached to exactly this version
+        std::uint32_t* find_slot(handle h) const
+        {
+            std::uint32_t* slot = sparse_entry(h.index);
+            if (!slot || *slot == NPOS || handles_[*slot].version != h.version) {
+                return nullptr;
+            }
+            return slot;
+        }
+
+        std::vector<std::unique_ptr<page_type>> pages_;   // sparse: handle index -> dense position
+        std::vector<T>                          values_;  // dense values
+        std::vector<handle>                     handles_; // dense owning handles, parallel to values_
+    };
+
+    /**
+     * @brief Invokes fn for every handle that has a value in all of the given sets.
+     *
+     * Only the smallest set is iterated; membership in the others is checked with
+     * O(1) lookups, so a multi-component query costs O(min(size)). The sets must
+     * not be modified during the iteration.
+     *
+     * @param fn Callable invoked as fn(handle, value_in_first, value_in_rest...).
+     * @param first The first set.
+     * @param rest The remaining sets, sharing the handle type of first.
+     */
+    template <typename Fn, typename First, typename... Rest>
+    void for_each_intersection(Fn&& fn, First& first, Rest&... rest)
+    {
+        using handle = typename First::handle;
+
+        // pick the smallest set to drive the iteration
+        const handle* driver = first.handles();
+        std::size_t   count  = first.size();
+        (
+            [&](const auto& set) {
+                if (set.size() < count) {
+                    driver = set.handles();
+                    count  = set.size();
+                }
+            }(rest),
+            ...);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            handle h        = driver[i];
+            auto   pointers = std::make_tuple(first.find(h), rest.find(h)...);
+
+            bool in_all = std::apply([](auto*... p) { return ((p != nullptr) && ...); }, pointers);
+            if (in_all) {
+                std::apply([&](auto*... p) { fn(h, *p...); }, pointers);
+            }
+        }
+    }
+
+} // namespace apus
+
+#endif // APUS_SPARSE_SET_HPP
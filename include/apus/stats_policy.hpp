@@ -0,0 +1,131 @@
+#ifndef APUS_STATS_POLICY_HPP
+#define APUS_STATS_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+namespace apus
+{
+
+    /**
+     * @brief Hot-path events counted by a container's stats policy.
+     */
+    enum class stats_event : std::size_t
+    {
+        heap_spill,      // small_vector moved from its inline buffer to the heap
+        reallocation,    // a container moved its elements into a larger buffer
+        page_allocation, // an arena allocated a new page
+        overwrite,       // ring_buffer::push_back replaced the oldest element
+        allocation,      // an arena served an allocation
+        padding_bytes,   // bytes an arena skipped to align its allocations
+    };
+
+    static constexpr std::size_t STATS_EVENT_COUNT = 6;
+
+    /**
+     * @brief Levels whose high-water mark is tracked by a container's stats policy.
+     */
+    enum class stats_level : std::size_t
+    {
+        free_list_depth, // number of indices on typed_memory_arena's free list
+    };
+
+    static constexpr std::size_t STATS_LEVEL_COUNT = 1;
+
+    // number of power-of-two buckets in an allocation size histogram
+    static constexpr std::size_t STATS_SIZE_BUCKETS = 32;
+
+    /**
+     * @brief Returns the allocation size histogram bucket of a size.
+     *
+     * Bucket 0 holds empty allocations and bucket i holds sizes in [2^(i-1), 2^i);
+     * the last bucket also holds everything larger.
+     */
+    constexpr std::size_t stats_size_bucket(std::size_t bytes) noexcept
+    {
+        std::size_t bucket = 0;
+        while (bytes != 0 && bucket + 1 < STATS_SIZE_BUCKETS) {
+            bytes >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    /**
+     * @brief Returns the name of an event, as used in stats reports.
+     */
+    constexpr const char* to_string(stats_event event) noexcept
+    {
+        switch (event) {
+            case stats_event::heap_spill:      return "heap_spill";
+            case stats_event::reallocation:    return "reallocation";
+            case stats_event::page_allocation: return "page_allocation";
+            case stats_event::overwrite:       return "overwrite";
+            case stats_event::allocation:      return "allocation";
+            case stats_event::padding_bytes:   return "padding_bytes";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Returns the name of a level, as used in stats reports.
+     */
+    constexpr const char* to_string(stats_level level) noexcept
+    {
+        switch (level) {
+            case stats_level::free_list_depth: return "free_list_depth";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief The default stats policy: records nothing and costs nothing.
+     *
+     * Containers take their stats policy as a template parameter and inherit from it
+     * privately, so this empty policy adds no storage (empty base optimization), and
+     * its empty inline functions compile away. See counting_stats in
+     * <apus/stats_registry.hpp> for the policy that actually counts.
+     *
+     * A stats policy provides:
+     *   - void record(stats_event, std::uint64_t count = 1) noexcept
+     *   - void record_level(stats_level, std::size_t) noexcept
+     *   - void record_allocation(std::size_t bytes, std::size_t padding) noexcept
+     */
+    struct null_stats
+    {
+        void record(stats_event, std::uint64_t = 1) noexcept {}
+        void record_level(stats_level, std::size_t) noexcept {}
+        void record_allocation(std::size_t, std::size_t) noexcept {}
+    };
+
+    namespace detail
+    {
+        // true for stats policies that can report counts, such as counting_stats
+        template <typename Stats, typename = void>
+        struct stats_counts : std::false_type
+        {
+        };
+
+        template <typename Stats>
+        struct stats_counts<Stats, std::void_t<decltype(std::declval<const Stats&>().count(stats_event::allocation))>>
+            : std::true_type
+        {
+        };
+
+        // the policy's count of event, or 0 for a policy that does not count
+        template <typename Stats>
+        std::uint64_t stats_count(const Stats& stats, stats_event event) noexcept
+        {
+            if constexpr (stats_counts<Stats>::value) {
+                return stats.count(event);
+            } else {
+                return 0;
+            }
+        }
+    } // namespace detail
+
+} // namespace apus
+
+#endif // APUS_STATS_POLICY_HPP
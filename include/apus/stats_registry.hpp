@@ -0,0 +1,395 @@
+#ifndef APUS_STATS_REGISTRY_HPP
+#define APUS_STATS_REGISTRY_HPP
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <memory>
+#include <iomanip>
+#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include <apus/stats_policy.hpp>
+
+namespace apus
+{
+
+    namespace detail
+    {
+        class stats_counters;
+    } // namespace detail
+
+    /**
+     * @brief Aggregated stats of all container instances sharing a stats name.
+     */
+    struct stats_record
+    {
+        std::string                                   name;
+        std::size_t                                   instances      = 0; // instances ever constructed
+        std::size_t                                   live_instances = 0; // instances still alive
+        std::array<std::uint64_t, STATS_EVENT_COUNT>  events{};           // summed over all instances
+        std::array<std::size_t, STATS_LEVEL_COUNT>    high_water{};       // maximum over all instances
+        std::array<std::uint64_t, STATS_SIZE_BUCKETS> size_histogram{};  // allocation sizes, see stats_size_bucket
+    };
+
+    /**
+     * @brief Process-wide registry of counting_stats instances.
+     *
+     * Live instances are linked into an intrusive list; when an instance is destroyed
+     * its counts are folded into a per-name total, so a report covers both live and
+     * destroyed containers. Registration and reporting take a mutex; recording an
+     * event does not.
+     */
+    class stats_registry
+    {
+    public:
+        /**
+         * @brief Returns the process-wide registry.
+         */
+        static stats_registry& instance()
+        {
+            // intentionally leaked: containers with static storage duration may outlive any static registry
+            static stats_registry* registry = new stats_registry();
+            return *registry;
+        }
+
+        // disable copying and moving
+        stats_registry(const stats_registry&)            = delete;
+        stats_registry& operator=(const stats_registry&) = delete;
+        stats_registry(stats_registry&&)                 = delete;
+        stats_registry& operator=(stats_registry&&)      = delete;
+
+        /**
+         * @brief Aggregates the stats of all live and destroyed instances by name.
+         *
+         * @return std::vector<stats_record> One record per name, sorted by name.
+         */
+        std::vector<stats_record> snapshot() const;
+
+        /**
+         * @brief Zeroes the counts of live instances and forgets destroyed ones.
+         */
+        void reset();
+
+        /**
+         * @brief Formats the current snapshot as a JSON array of records.
+         */
+        std::string to_json() const;
+
+        /**
+         * @brief Formats the current snapshot as a fixed-width text table.
+         */
+        std::string to_table() const;
+
+    private:
+        friend class detail::stats_counters;
+
+        stats_registry() = default;
+
+        void attach(detail::stats_counters* counters);
+        void detach(detail::stats_counters* counters);
+
+        mutable std::mutex                  mutex_;
+        detail::stats_counters*             live_ = nullptr; // intrusive list of live instances
+        std::map<std::string, stats_record> retired_;        // totals of destroyed instances
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief The non-template part of counting_stats: counters plus registry links.
+         *
+         * Counters are written only by the owning container's thread, so increments are
+         * a relaxed load and store rather than a read-modify-write; the atomics only make
+         * concurrent reports race-free.
+         */
+        class stats_counters
+        {
+        public:
+            explicit stats_counters(const char* name)
+                : name_(name)
+            {
+                stats_registry::instance().attach(this);
+            }
+
+            // a copy is a new instance: same name, fresh counts
+            stats_counters(const stats_counters& other)
+                : stats_counters(other.name_)
+            {
+            }
+
+            // counts belong to the instance, so assignment keeps them
+            stats_counters& operator=(const stats_counters&) noexcept { return *this; }
+
+            ~stats_counters()
+            {
+                stats_registry::instance().detach(this);
+            }
+
+            void record(stats_event event, std::uint64_t count = 1) noexcept
+            {
+                auto& counter = events_[static_cast<std::size_t>(event)];
+                counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+            }
+
+            void record_allocation(std::size_t bytes, std::size_t padding) noexcept
+            {
+                record(stats_event::allocation);
+                record(stats_event::padding_bytes, padding);
+                if (size_histogram_) {
+                    auto& bucket = size_histogram_[stats_size_bucket(bytes)];
+                    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+            }
+
+            void record_level(stats_level level, std::size_t value) noexcept
+            {
+                auto& high_water = levels_[static_cast<std::size_t>(level)];
+                if (value > high_water.load(std::memory_order_relaxed)) {
+                    high_water.store(value, std::memory_order_relaxed);
+                }
+            }
+
+            // clang-format off
+            std::uint64_t count(stats_event event)      const noexcept { return events_[static_cast<std::size_t>(event)].load(std::memory_order_relaxed); }
+            std::size_t   high_water(stats_level level) const noexcept { return levels_[static_cast<std::size_t>(level)].load(std::memory_order_relaxed); }
+            const char*   name()                        const noexcept { return name_; }
+            // clang-format on
+
+            /**
+             * @brief Returns the number of allocations in a size bucket (0 unless the histogram is enabled).
+             */
+            std::uint64_t size_histogram(std::size_t bucket) const noexcept
+            {
+                return size_histogram_ ? size_histogram_[bucket].load(std::memory_order_relaxed) : 0;
+            }
+
+        protected:
+            void enable_size_histogram()
+            {
+                size_histogram_ = std::make_unique<std::atomic<std::uint64_t>[]>(STATS_SIZE_BUCKETS);
+            }
+
+        private:
+            friend class apus::stats_registry;
+
+            const char*                                               name_;
+            std::array<std::atomic<std::uint64_t>, STATS_EVENT_COUNT> events_{};
+            std::array<std::atomic<std::size_t>, STATS_LEVEL_COUNT>   levels_{};
+            std::unique_ptr<std::atomic<std::uint64_t>[]>             size_histogram_; // STATS_SIZE_BUCKETS counters, optional
+            stats_counters*                                           prev_ = nullptr; // registry links
+            stats_counters*                                           next_ = nullptr;
+        };
+
+        template <typename Tag, typename = void>
+        struct stats_tag_name
+        {
+            static constexpr const char* value = "unnamed";
+        };
+
+        template <typename Tag>
+        struct stats_tag_name<Tag, std::void_t<decltype(Tag::name)>>
+        {
+            static constexpr const char* value = Tag::name;
+        };
+    } // namespace detail
+
+    /**
+     * @brief A stats policy that counts events per instance and reports them to stats_registry.
+     *
+     * Instances are aggregated by name, taken from Tag::name when Tag declares one:
+     *
+     *   struct request_tags { static constexpr const char* name = "request_tags"; };
+     *   apus::small_vector<int, 8, apus::counting_stats<request_tags>> tags;
+     *
+     * Constructing and destroying an instance locks the registry, so this policy is
+     * meant for diagnostic builds; the default null_stats policy costs nothing.
+     *
+     * @tparam Tag A type naming the instances, or void for "unnamed".
+     * @tparam SizeHistogram Whether arenas also record a power-of-two histogram of allocation sizes.
+     */
+    template <typename Tag = void, bool SizeHistogram = false>
+    class counting_stats : public detail::stats_counters
+    {
+    public:
+        counting_stats()
+            : detail::stats_counters(detail::stats_tag_name<Tag>::value)
+        {
+            if constexpr (SizeHistogram) enable_size_histogram();
+        }
+
+        counting_stats(const counting_stats& other)
+            : detail::stats_counters(other)
+        {
+            if constexpr (SizeHistogram) enable_size_histogram();
+        }
+
+        counting_stats& operator=(const counting_stats&) noexcept { return *this; }
+    };
+
+    inline void stats_registry::attach(detail::stats_counters* counters)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters->next_ = live_;
+        if (live_) {
+            live_->prev_ = counters;
+        }
+        live_ = counters;
+
+        stats_record& totals = retired_[counters->name_];
+        totals.instances++;
+    }
+
+    inline void stats_registry::detach(detail::stats_counters* counters)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (counters->prev_) {
+            counters->prev_->next_ = counters->next_;
+        } else {
+            live_ = counters->next_;
+        }
+        if (counters->next_) {
+            counters->next_->prev_ = counters->prev_;
+        }
+
+        stats_record& totals = retired_[counters->name_];
+        for (std::size_t i = 0; i < STATS_EVENT_COUNT; ++i) {
+            totals.events[i] += counters->events_[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < STATS_LEVEL_COUNT; ++i) {
+            totals.high_water[i] = std::max(totals.high_water[i], counters->levels_[i].load(std::memory_order_relaxed));
+        }
+        for (std::size_t i = 0; i < STATS_SIZE_BUCKETS; ++i) {
+            totals.size_histogram[i] += counters->size_histogram(i);
+        }
+    }
+
+    inline std::vector<stats_record> stats_registry::snapshot() const
+    {
+        std::lock_guard<std::mutex>         lock(mutex_);
+        std::map<std::string, stats_record> merged = retired_;
+
+        for (auto* counters = live_; counters; counters = counters->next_) {
+            stats_record& record = merged[counters->name_];
+            record.live_instances++;
+            for (std::size_t i = 0; i < STATS_EVENT_COUNT; ++i) {
+                record.events[i] += counters->events_[i].load(std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i < STATS_LEVEL_COUNT; ++i) {
+                record.high_water[i] = std::max(record.high_water[i], counters->levels_[i].load(std::memory_order_relaxed));
+            }
+            for (std::size_t i = 0; i < STATS_SIZE_BUCKETS; ++i) {
+                record.size_histogram[i] += counters->size_histogram(i);
+            }
+        }
+
+        std::vector<stats_record> records;
+        records.reserve(merged.size());
+        for (auto& [name, record] : merged) {
+            record.name = name;
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+    inline void stats_registry::reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.clear();
+
+        // live instances stay counted as instances, with their counts zeroed
+        for (auto* counters = live_; counters; counters = counters->next_) {
+            for (auto& counter : counters->events_) counter.store(0, std::memory_order_relaxed);
+            for (auto& level : counters->levels_) level.store(0, std::memory_order_relaxed);
+            if (counters->size_histogram_) {
+                for (std::size_t i = 0; i < STATS_SIZE_BUCKETS; ++i) {
+                    counters->size_histogram_[i].store(0, std::memory_order_relaxed);
+                }
+            }
+            retired_[counters->name_].instances++;
+        }
+    }
+
+    inline std::string stats_registry::to_json() const
+    {
+        std::ostringstream out;
+        out << "[";
+        bool first = true;
+        for (const auto& record : snapshot()) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+
+            out << "  {\"name\": \"";
+            for (char c : record.name) {
+                if (c == '"' || c == '\\') out << '\\';
+                out << c;
+            }
+            out << "\", \"instances\": " << record.instances << ", \"live_instances\": " << record.live_instances;
+            for (std::size_t i = 0; i < STATS_EVENT_COUNT; ++i) {
+                out << ", \"" << to_string(static_cast<stats_event>(i)) << "\": " << record.events[i];
+            }
+            for (std::size_t i = 0; i < STATS_LEVEL_COUNT; ++i) {
+                out << ", \"" << to_string(static_cast<stats_level>(i)) << "_max\": " << record.high_water[i];
+            }
+
+            // the histogram is trimmed after its last non-empty bucket and omitted when empty
+            std::size_t buckets = STATS_SIZE_BUCKETS;
+            while (buckets > 0 && record.size_histogram[buckets - 1] == 0) {
+                --buckets;
+            }
+            if (buckets > 0) {
+                out << ", \"size_histogram\": [";
+                for (std::size_t i = 0; i < buckets; ++i) {
+                    out << (i ? ", " : "") << record.size_histogram[i];
+                }
+                out << "]";
+            }
+            out << "}";
+        }
+        out << (first ? "]" : "\n]") << "\n";
+        return out.str();
+    }
+
+    inline std::string stats_registry::to_table() const
+    {
+        auto records = snapshot();
+
+        std::size_t name_width = 4;
+        for (const auto& record : records) {
+            name_width = std::max(name_width, record.name.size());
+        }
+
+        std::ostringstream out;
+        out << std::left << std::setw(static_cast<int>(name_width)) << "name" << std::right;
+        out << "  " << std::setw(10) << "instances" << "  " << std::setw(10) << "live";
+        for (std::size_t i = 0; i < STATS_EVENT_COUNT; ++i) {
+            out << "  " << std::setw(16) << to_string(static_cast<stats_event>(i));
+        }
+        for (std::size_t i = 0; i < STATS_LEVEL_COUNT; ++i) {
+            out << "  " << std::setw(16) << std::string(to_string(static_cast<stats_level>(i))) + "_max";
+        }
+        out << "\n";
+
+        for (const auto& record : records) {
+            out << std::left << std::setw(static_cast<int>(name_width)) << record.name << std::right;
+            out << "  " << std::setw(10) << record.instances << "  " << std::setw(10) << record.live_instances;
+            for (auto count : record.events) {
+                out << "  " << std::setw(16) << count;
+            }
+            for (auto level : record.high_water) {
+                out << "  " << std::setw(16) << level;
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+
+} // namespace apus
+
+#endif // APUS_STATS_REGISTRY_HPP
@@ -0,0 +1,283 @@
+#ifndef APUS_STRING_INTERNER_HPP
+#define APUS_STRING_INTERNER_HPP
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include <apus/config.hpp>
+#include <apus/paged_memory_arena.hpp>
+
+namespace apus
+{
+
+    // default page size for string_interner's internal paged_memory_arena
+    static constexpr std::size_t DEFAULT_STRING_INTERNER_PAGE_SIZE = 64 * 1024;
+
+    /**
+     * @brief Interns strings into dense 32-bit ids.
+     *
+     * The bytes of each distinct string are copied once into a paged_memory_arena
+     * (strings longer than a page get a dedicated allocation). Ids are assigned
+     * densely in insertion order, so an id-to-string_view table is a plain vector
+     * and two interned strings compare equal exactly when their ids do.
+     *
+     * Lookup goes through an open-addressing index that stores each entry's 32-bit
+     * hash next to its id, so probing only touches string bytes on a hash match
+     * and growing the index never rehashes strings.
+     *
+     * After freeze() the interner is read-only: intern() of an unknown string
+     * throws, and every remaining operation is const, so any number of threads may
+     * look up and resolve ids concurrently without locking.
+     *
+     * @tparam PageSizeInBytes The size of each page of string storage in bytes.
+     */
+    template <std::size_t PageSizeInBytes = DEFAULT_STRING_INTERNER_PAGE_SIZE>
+    class string_interner
+    {
+    public:
+        using id_type   = std::uint32_t;
+        using size_type = std::size_t;
+
+        // returned by find() for strings that have not been interned
+        static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+        /**
+         * @brief Construct an empty string interner.
+         */
+        string_interner() = default;
+
+        // disable copying and moving (the string storage arena is pinned)
+        string_interner(const string_interner&)            = delete;
+        string_interner& operator=(const string_interner&) = delete;
+        string_interner(string_interner&&)                 = delete;
+        string_interner& operator=(string_interner&&)      = delete;
+
+        /**
+         * @brief Interns a string, copying its bytes if it has not been seen before.
+         *
+         * @param str The string to intern.
+         * @return id_type The id of the string.
+         * @throws std::logic_error If the interner is frozen and the string is unknown.
+         */
+        id_type intern(std::string_view str)
+        {
+            id_type id = try_intern(str);
+            if (id == npos) {
+                detail::throw_error(std::logic_error("string_interner::intern: interner is frozen"));
+            }
+            return id;
+        }
+
+        /**
+         * @brief Interns a string, or returns npos if the interner is frozen and the string is unknown.
+         *
+         * @param str The string to intern.
+         * @return id_type The id of the string, or npos.
+         */
+        id_type try_intern(std::string_view str)
+        {
+            std::uint32_t hash = hash_of(str);
+            if (!index_.empty()) {
+                const index_entry& entry = index_[find_slot(str, hash)];
+                if (entry.id != npos) {
+                    return entry.id;
+                }
+            }
+
+            if (frozen_) {
+                return npos;
+            }
+
+            // keep the index at most half full
+            if ((strings_.size() + 1) * 2 > index_.size()) {
+                rehash(index_.empty() ? MIN_INDEX_SIZE : index_.size() * 2);
+            }
+
+            size_type slot = find_slot(str, hash);
+            id_type   id   = static_cast<id_type>(strings_.size());
+            strings_.push_back(store(str));
+            index_[slot] = {hash, id};
+            return id;
+        }
+
+        /**
+         * @brief Interns a range of strings, writing their ids to out.
+         *
+         * For forward ranges, the index is sized once up front.
+         *
+         * @param first Iterator to the first string.
+         * @param last Iterator past the last string.
+         * @param out Output iterator receiving one id per input string.
+         * @return OutputIt Iterator past the last id written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt intern(InputIt first, InputIt last, OutputIt out)
+        {
+            using category = typename std::iterator_traits<InputIt>::iterator_category;
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+                if (!frozen_) {
+                    reserve(strings_.size() + static_cast<size_type>(std::distance(first, last)));
+                }
+            }
+            for (; first != last; ++first) {
+                *out++ = intern(std::string_view(*first));
+            }
+            return out;
+        }
+
+        /**
+         * @brief Looks up the id of a string without interning it.
+         *
+         * @param str The string to look up.
+         * @return id_type The id of the string, or npos if it has not been interned.
+         */
+        id_type find(std::string_view str) const
+        {
+            if (index_.empty()) {
+                return npos;
+            }
+            return index_[find_slot(str, hash_of(str))].id;
+        }
+
+        /**
+         * @brief Checks if a string has been interned.
+         */
+        bool contains(std::string_view str) const { return find(str) != npos; }
+
+        /**
+         * @brief Resolves an id to its string (no bounds checking).
+         *
+         * @param id An id returned by intern().
+         * @return std::string_view The interned string, valid for the lifetime of the interner.
+         */
+        std::string_view operator[](id_type id) const { return strings_[id]; }
+
+        /**
+         * @brief Resolves an id to its string with bounds checking.
+         *
+         * @param id An id returned by intern().
+         * @return std::string_view The interned string, valid for the lifetime of the interner.
+         * @throws std::out_of_range If the id was never issued.
+         */
+        std::string_view at(id_type id) const
+        {
+            if (id >= strings_.size()) detail::throw_error(std::out_of_range("string_interner::at: id out of range"));
+            return strings_[id];
+        }
+
+        /**
+         * @brief Sizes the index and id table for at least count strings.
+         *
+         * @param count The total number of strings expected.
+         */
+        void reserve(size_type count)
+        {
+            strings_.reserve(count);
+            size_type index_size = MIN_INDEX_SIZE;
+            while (index_size < count * 2) {
+                index_size *= 2;
+            }
+            if (index_size > index_.size()) {
+                rehash(index_size);
+            }
+        }
+
+        /**
+         * @brief Makes the interner read-only, enabling lock-free concurrent lookups.
+         */
+        void freeze() noexcept { frozen_ = true; }
+
+        /**
+         * @brief Checks if the interner has been frozen.
+         */
+        bool frozen() const noexcept { return frozen_; }
+
+        /**
+         * @brief Returns the number of distinct strings interned.
+         */
+        size_type size() const noexcept { return strings_.size(); }
+
+        /**
+         * @brief Checks if no strings have been interned.
+         */
+        bool empty() const noexcept { return strings_.empty(); }
+
+    private:
+        static constexpr size_type MIN_INDEX_SIZE = 16;
+
+        struct index_entry
+        {
+            std::uint32_t hash;
+            id_type       id;
+        };
+
+        static std::uint32_t hash_of(std::string_view str)
+        {
+            std::uint64_t hash = static_cast<std::uint64_t>(std::hash<std::string_view>()(str));
+            return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+        }
+
+        // linear probing; returns the slot holding str, or the empty slot where it would go
+        size_type find_slot(std::string_view str, std::uint32_t hash) const
+        {
+            size_type mask = index_.size() - 1;
+            for (size_type slot = hash & mask;; slot = (slot + 1) & mask) {
+                const index_entry& entry = index_[slot];
+                if (entry.id == npos || (entry.hash == hash && strings_[entry.id] == str)) {
+                    return slot;
+                }
+            }
+        }
+
+        void rehash(size_type new_size)
+        {
+            std::vector<index_entry> old_index = std::move(index_);
+            index_.assign(new_size, index_entry{0, npos});
+
+            size_type mask = new_size - 1;
+            for (const index_entry& entry : old_index) {
+                if (entry.id == npos) continue;
+
+                size_type slot = entry.hash & mask;
+                while (index_[slot].id != npos) {
+                    slot = (slot + 1) & mask;
+                }
+                index_[slot] = entry;
+            }
+        }
+
+        // copies the bytes of str into stable storage
+        std::string_view store(std::string_view str)
+        {
+            char* bytes = nullptr;
+            if (str.size() <= PageSizeInBytes) {
+                bytes = arena_.template allocate<char>(str.size());
+            } else {
+                oversized_.emplace_back(new char[str.size()]);
+                bytes = oversized_.back().get();
+            }
+            if (!str.empty()) {
+                std::memcpy(bytes, str.data(), str.size());
+            }
+            return std::string_view(bytes, str.size());
+        }
+
+        paged_memory_arena<PageSizeInBytes>  arena_;          // string bytes
+        std::vector<std::unique_ptr<char[]>> oversized_;      // strings larger than a page
+        std::vector<std::string_view>        strings_;        // id -> string
+        std::vector<index_entry>             index_;          // open-addressing string -> id index
+        bool                                 frozen_ = false; // read-only mode
+    };
+
+} // namespace apus
+
+#endif // APUS_STRING_INTERNER_HPP
@@ -0,0 +1,440 @@
+#ifndef APUS_THREAD_POOL_HPP
+#define APUS_THREAD_POOL_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <exception>
+#include <type_traits>
+#include <condition_variable>
+
+#include <apus/config.hpp>
+#include <apus/ring_buffer.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/work_stealing_deque.hpp>
+
+namespace apus
+{
+
+    // page size of each worker's scratch arena
+    static constexpr std::size_t DEFAULT_THREAD_POOL_SCRATCH_PAGE_SIZE = 64 * 1024;
+
+    namespace detail
+    {
+
+        /**
+         * @brief A type-erased unit of work scheduled on a thread_pool.
+         */
+        struct pool_task
+        {
+            virtual ~pool_task() = default;
+            virtual void run()   = 0;
+        };
+
+        template <typename F>
+        struct pool_task_impl final : pool_task
+        {
+            explicit pool_task_impl(F&& fn) : fn_(std::move(fn)) {}
+            explicit pool_task_impl(const F& fn) : fn_(fn) {}
+
+            void run() override { fn_(); }
+
+            F fn_;
+        };
+
+    } // namespace detail
+
+    class task_group;
+
+    /**
+     * @brief A work-stealing thread pool.
+     *
+     * Each worker owns a work_stealing_deque. Tasks spawned from a worker go to the
+     * bottom of its own deque and are popped LIFO, which keeps recently produced
+     * (cache-hot) work local. Idle workers steal FIFO from the top of other
+     * workers' deques, taking the oldest and usually largest pieces of work. Tasks
+     * submitted from outside the pool go through a shared injection queue.
+     *
+     * Each worker also owns a scratch paged_memory_arena for temporary allocations
+     * made by the task it runs. The arena is reset before the worker starts each
+     * top-level task, so scratch memory lives exactly as long as that task and any
+     * nested work it waits on.
+     */
+    class thread_pool
+    {
+        friend class task_group;
+
+    public:
+        using scratch_arena_type = paged_memory_arena<DEFAULT_THREAD_POOL_SCRATCH_PAGE_SIZE>;
+
+        /**
+         * @brief Construct a new thread pool and start its workers.
+         *
+         * @param thread_count The number of worker threads (0 selects the hardware concurrency).
+         */
+        explicit thread_pool(std::size_t thread_count = 0)
+        {
+            if (thread_count == 0) {
+                thread_count = std::thread::hardware_concurrency();
+            }
+            if (thread_count == 0) {
+                thread_count = 1;
+            }
+
+            // create every worker before starting threads, so thieves see the full set
+            workers_.reserve(thread_count);
+            for (std::size_t i = 0; i < thread_count; ++i) {
+                workers_.emplace_back(std::make_unique<worker>(this, i));
+            }
+            for (auto& w : workers_) {
+                w->thread = std::thread([this, self = w.get()] { worker_loop(*self); });
+            }
+        }
+
+        /**
+         * @brief Destructor. Runs all remaining tasks, then joins the workers.
+         */
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stop_ = true;
+            }
+            wake_cv_.notify_all();
+            for (auto& w : workers_) {
+                w->thread.join();
+            }
+        }
+
+        // disable copying and moving
+        thread_pool(const thread_pool&)            = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        thread_pool(thread_pool&&)                 = delete;
+        thread_pool& operator=(thread_pool&&)      = delete;
+
+        /**
+         * @brief Schedules a fire-and-forget task.
+         *
+         * An exception escaping fn terminates the program; use a task_group to
+         * propagate exceptions to a waiting thread.
+         *
+         * @param fn The callable to run on a worker.
+         */
+        template <typename F>
+        void submit(F&& fn)
+        {
+            push_task(new detail::pool_task_impl<std::decay_t<F>>(std::forward<F>(fn)));
+        }
+
+        /**
+         * @brief Runs fn over [first, last) in parallel, split into chunks of at most grain indices.
+         *
+         * The range is split recursively in halves; each split spawns the upper half
+         * as a task and keeps working on the lower half, so idle workers steal large
+         * ranges first. The calling thread participates and returns once every chunk
+         * has run. The first exception thrown by fn is rethrown here.
+         *
+         * @param first The first index.
+         * @param last One past the last index.
+         * @param grain The largest chunk passed to a single fn call (at least 1).
+         * @param fn Callable invoked as fn(chunk_first, chunk_last).
+         */
+        template <typename F>
+        void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& fn);
+
+        /**
+         * @brief Returns the number of worker threads.
+         */
+        std::size_t size() const noexcept { return workers_.size(); }
+
+        /**
+         * @brief Returns the index of the calling worker thread in this pool.
+         *
+         * @return std::size_t The worker index, or size() if the caller is not a worker of this pool.
+         */
+        std::size_t current_worker_index() const noexcept
+        {
+            worker* self = current_worker();
+            return self ? self->index : workers_.size();
+        }
+
+        /**
+         * @brief Returns the scratch arena of the calling worker thread.
+         *
+         * @return scratch_arena_type* The arena, or nullptr if the caller is not a worker of this pool.
+         */
+        scratch_arena_type* scratch_arena() noexcept
+        {
+            worker* self = current_worker();
+            return self ? &self->scratch : nullptr;
+        }
+
+    private:
+        struct worker
+        {
+            worker(thread_pool* owner, std::size_t idx)
+                : pool(owner), index(idx), rng_state(static_cast<std::uint32_t>(idx) * 2654435761u + 1u) {}
+
+            thread_pool*                            pool;
+            std::size_t                             index;
+            std::uint32_t                           rng_state; // victim selection
+            work_stealing_deque<detail::pool_task*> deque;
+            scratch_arena_type                      scratch;
+            std::thread                             thread;
+        };
+
+        worker* current_worker() const noexcept
+        {
+            return (tls_worker_ && tls_worker_->pool == this) ? tls_worker_ : nullptr;
+        }
+
+        void push_task(detail::pool_task* task)
+        {
+            if (worker* self = current_worker()) {
+                self->deque.push(task);
+            } else {
+                std::lock_guard<std::mutex> lock(injection_mutex_);
+                if (injection_.full()) {
+                    injection_.set_capacity(injection_.capacity() == 0 ? 64 : injection_.capacity() * 2);
+                }
+                injection_.push_back(task);
+                injection_size_.fetch_add(1, std::memory_order_release);
+            }
+
+            // pairs with the sleeping_/queued_ check in worker_loop, so a wakeup is never lost
+            queued_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                wake_cv_.notify_one();
+            }
+        }
+
+        // own deque first, then the injection queue, then steal from a random victim
+        detail::pool_task* acquire_task(worker* self)
+        {
+            detail::pool_task* task = nullptr;
+            if ((self && self->deque.pop(task)) || take_injected(task) || steal_task(self, task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+            return nullptr;
+        }
+
+        bool take_injected(detail::pool_task*& task)
+        {
+            if (injection_size_.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(injection_mutex_);
+            if (injection_.empty()) {
+                return false;
+            }
+            task = injection_.front();
+            injection_.pop_front();
+            injection_size_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool steal_task(worker* self, detail::pool_task*& task)
+        {
+            std::size_t count = workers_.size();
+            std::size_t start = 0;
+            if (self) {
+                // xorshift32
+                self->rng_state ^= self->rng_state << 13;
+                self->rng_state ^= self->rng_state >> 17;
+                self->rng_state ^= self->rng_state << 5;
+                start = self->rng_state % count;
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                worker* victim = workers_[(start + i) % count].get();
+                if (victim != self && victim->deque.steal(task)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void run_task(detail::pool_task* task)
+        {
+            std::unique_ptr<detail::pool_task> owned(task);
+            owned->run();
+        }
+
+        void worker_loop(worker& self)
+        {
+            tls_worker_ = &self;
+            while (true) {
+                if (detail::pool_task* task = acquire_task(&self)) {
+                    self.scratch.reset();
+                    run_task(task);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                sleeping_.fetch_add(1, std::memory_order_seq_cst);
+                wake_cv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_seq_cst) > 0; });
+                sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                if (stop_ && queued_.load(std::memory_order_seq_cst) == 0) {
+                    break;
+                }
+            }
+            tls_worker_ = nullptr;
+        }
+
+        // run one pending task on the calling thread, used by task_group::wait
+        bool help_one()
+        {
+            if (detail::pool_task* task = acquire_task(current_worker())) {
+                run_task(task);
+                return true;
+            }
+            return false;
+        }
+
+        template <typename F>
+        void split_range(task_group& group, std::size_t first, std::size_t last, std::size_t grain, F& fn);
+
+        inline static thread_local worker* tls_worker_ = nullptr;
+
+        std::vector<std::unique_ptr<worker>> workers_;
+
+        std::mutex                      injection_mutex_;
+        ring_buffer<detail::pool_task*> injection_;         // tasks submitted from non-worker threads
+        std::atomic<std::size_t>        injection_size_{0}; // lock-free emptiness check for injection_
+
+        std::mutex               sleep_mutex_;
+        std::condition_variable  wake_cv_;
+        std::atomic<std::size_t> queued_{0};   // tasks pushed but not yet acquired
+        std::atomic<std::size_t> sleeping_{0}; // workers waiting on wake_cv_
+        bool                     stop_ = false;
+    };
+
+    /**
+     * @brief A fork/join group of tasks on a thread_pool.
+     *
+     * run() spawns tasks and wait() blocks until all of them have finished. The
+     * waiting thread does not idle: it runs pending tasks of the pool (its own
+     * first, if it is a worker), so nested groups never deadlock the pool. The
+     * first exception thrown by a task is rethrown from wait(). The destructor
+     * waits for outstanding tasks but discards their exceptions. Without
+     * exceptions (APUS_EXCEPTIONS == 0), wait() only joins.
+     */
+    class task_group
+    {
+    public:
+        /**
+         * @brief Construct a new task group on the given pool.
+         */
+        explicit task_group(thread_pool& pool) : pool_(pool) {}
+
+        /**
+         * @brief Destructor. Waits for all outstanding tasks.
+         */
+        ~task_group()
+        {
+            join();
+        }
+
+        // disable copying and moving
+        task_group(const task_group&)            = delete;
+        task_group& operator=(const task_group&) = delete;
+        task_group(task_group&&)                 = delete;
+        task_group& operator=(task_group&&)      = delete;
+
+        /**
+         * @brief Spawns a task in this group.
+         *
+         * @param fn The callable to run.
+         */
+        template <typename F>
+        void run(F&& fn)
+        {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.submit([this, fn = std::forward<F>(fn)]() mutable {
+#if APUS_EXCEPTIONS
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex_);
+                    if (!error_) error_ = std::current_exception();
+                }
+#else
+                fn();
+#endif
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        /**
+         * @brief Waits for all tasks of the group, running pool tasks in the meantime.
+         *
+         * @throws The first exception thrown by a task of the group, if any.
+         */
+        void wait()
+        {
+            join();
+#if APUS_EXCEPTIONS
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                std::swap(error, error_);
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+#endif
+        }
+
+    private:
+        void join()
+        {
+            while (pending_.load(std::memory_order_acquire) > 0) {
+                if (!pool_.help_one()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        thread_pool&             pool_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex               error_mutex_;
+        std::exception_ptr       error_;
+    };
+
+    template <typename F>
+    void thread_pool::parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& fn)
+    {
+        if (first >= last) {
+            return;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+
+        // if fn throws on this thread, the group destructor still joins the chunks that reference fn
+        task_group group(*this);
+        split_range(group, first, last, grain, fn);
+        group.wait();
+    }
+
+    template <typename F>
+    void thread_pool::split_range(task_group& group, std::size_t first, std::size_t last, std::size_t grain, F& fn)
+    {
+        while (last - first > grain) {
+            std::size_t mid = first + (last - first) / 2;
+            group.run([this, &group, &fn, mid, last, grain] { split_range(group, mid, last, grain, fn); });
+            last = mid;
+        }
+        fn(first, last);
+    }
+
+} // namespace apus
+
+#endif // APUS_THREAD_POOL_HPP
@@ -0,0 +1,447 @@
+#ifndef APUS_TIMER_WHEEL_HPP
+#define APUS_TIMER_WHEEL_HPP
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include <apus/ring_buffer.hpp>
+#include <apus/typed_memory_arena.hpp>
+
+namespace apus
+{
+
+    // default page size for timer_wheel's internal typed_memory_arena
+    static constexpr std::size_t DEFAULT_TIMER_WHEEL_PAGE_SIZE = 1024;
+
+    /**
+     * @brief A handle to a timer scheduled on a timer_wheel.
+     *
+     * Contains an index (into the timer node pool) and a version for validation.
+     */
+    struct timer_handle
+    {
+        std::uint32_t index;   // index into the timer node arena
+        std::uint32_t version; // version for validation
+
+        bool operator==(const timer_handle& other) const
+        {
+            return index == other.index && version == other.version;
+        }
+
+        bool operator!=(const timer_handle& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief A hierarchical timer wheel with O(1) schedule and cancel.
+     *
+     * Time is measured in abstract 64-bit ticks. The wheel has LEVELS levels of
+     * SLOTS buckets each; level L covers deltas of up to SLOTS^(L+1) ticks with a
+     * resolution of SLOTS^L ticks. A timer is placed in the lowest level that can
+     * hold its expiry and is cascaded to lower levels as time approaches it, so
+     * each timer moves at most LEVELS times over its lifetime.
+     *
+     * Timer nodes (expiry, intrusive bucket links and the user payload) are pooled
+     * in a typed_memory_arena and referenced by index, and handles are versioned
+     * like slot_map handles so a cancelled or expired timer is never confused with
+     * a new one in the same node. Per-level occupancy bitmaps let advance() jump
+     * straight to the next non-empty bucket instead of stepping through idle ticks.
+     *
+     * advance() first collects every due timer into a ring_buffer batch, then
+     * invokes the callback for each, so callbacks may freely schedule and cancel
+     * timers (including other timers of the same batch).
+     *
+     * @tparam T The payload stored with each timer.
+     * @tparam PageSize The number of timer nodes per page of the underlying arena.
+     */
+    template <typename T, std::size_t PageSize = DEFAULT_TIMER_WHEEL_PAGE_SIZE>
+    class timer_wheel
+    {
+    public:
+        static constexpr std::size_t SLOT_BITS = 6;
+        static constexpr std::size_t SLOTS     = std::size_t(1) << SLOT_BITS;
+        static constexpr std::size_t LEVELS    = 8;
+
+    private:
+        static constexpr std::uint64_t SLOT_MASK  = SLOTS - 1;
+        static constexpr std::size_t   WHEEL_BITS = SLOT_BITS * LEVELS; // deltas of 2^WHEEL_BITS or more go to the overflow list
+
+        static constexpr std::uint32_t NIL             = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t OVERFLOW_BUCKET = LEVELS * SLOTS;      // pseudo-bucket for far-future timers
+        static constexpr std::uint32_t PENDING         = OVERFLOW_BUCKET + 1; // collected into the current batch
+        static constexpr std::uint32_t CANCELLED       = OVERFLOW_BUCKET + 2; // cancelled while pending
+
+        // top-most bit is the dead bit (same scheme as slot_map)
+        static constexpr std::uint32_t DEAD_BIT     = 0x80000000;
+        static constexpr std::uint32_t VERSION_MASK = 0x7FFFFFFF;
+
+        struct node
+        {
+            std::uint64_t expiry;
+            std::uint32_t prev;
+            std::uint32_t next;
+            std::uint32_t bucket; // level * SLOTS + slot, OVERFLOW_BUCKET, PENDING or CANCELLED
+            T             value;
+        };
+
+    public:
+        using value_type = T;
+        using handle     = timer_handle;
+
+        /**
+         * @brief Construct a new timer wheel.
+         *
+         * @param now The initial current tick.
+         */
+        explicit timer_wheel(std::uint64_t now = 0)
+            : now_(now)
+        {
+            heads_.fill(NIL);
+            occupancy_.fill(0);
+        }
+
+        /**
+         * @brief Destructor. Destroys the payloads of all outstanding timers.
+         */
+        ~timer_wheel()
+        {
+            for (std::size_t i = 0; i < nodes_.size(); ++i) {
+                std::uint32_t version = versions_[i];
+                if (version != 0 && !(version & DEAD_BIT)) {
+                    nodes_[i].~node();
+                }
+            }
+        }
+
+        // disable copying and moving
+        timer_wheel(const timer_wheel&)            = delete;
+        timer_wheel& operator=(const timer_wheel&) = delete;
+        timer_wheel(timer_wheel&&)                 = delete;
+        timer_wheel& operator=(timer_wheel&&)      = delete;
+
+        /**
+         * @brief Schedules a timer.
+         *
+         * A timer whose expiry is not after the current tick fires on the next tick.
+         *
+         * @param expiry The tick at which the timer fires.
+         * @param value The payload passed to the expiry callback.
+         * @return handle A handle to cancel or reschedule the timer.
+         */
+        handle schedule(std::uint64_t expiry, const T& value)
+        {
+            return emplace(expiry, value);
+        }
+
+        /**
+         * @brief Schedules a timer using move semantics for the payload.
+         */
+        handle schedule(std::uint64_t expiry, T&& value)
+        {
+            return emplace(expiry, std::move(value));
+        }
+
+        /**
+         * @brief Schedules a timer, constructing its payload in-place.
+         *
+         * @param expiry The tick at which the timer fires.
+         * @param args Arguments to construct the payload with.
+         * @return handle A handle to cancel or reschedule the timer.
+         */
+        template <typename... Args>
+        handle emplace(std::uint64_t expiry, Args&&... args)
+        {
+            auto          alloc_res = nodes_.allocate();
+            std::uint32_t index     = static_cast<std::uint32_t>(alloc_res.index);
+
+            // sync versions_ with nodes_
+            while (versions_.size() < nodes_.size()) {
+                versions_.allocate();
+                versions_[versions_.size() - 1] = 0;
+            }
+
+            new (alloc_res.ptr) node{expiry, NIL, NIL, NIL, T(std::forward<Args>(args)...)};
+
+            std::uint32_t& version = versions_[index];
+            version                = (version & VERSION_MASK) + 1;
+
+            link(index, placement_tick(expiry));
+            ++size_;
+            return {index, version};
+        }
+
+        /**
+         * @brief Cancels a timer.
+         *
+         * @param h The handle of the timer.
+         * @return true If the timer was outstanding and has been cancelled.
+         */
+        bool cancel(handle h)
+        {
+            if (!valid(h)) {
+                return false;
+            }
+
+            node& n = nodes_[h.index];
+            if (n.bucket == PENDING) {
+                // already collected into the running batch; released when the batch reaches it
+                n.bucket = CANCELLED;
+                --size_;
+                return true;
+            }
+
+            unlink(h.index);
+            release(h.index);
+            --size_;
+            return true;
+        }
+
+        /**
+         * @brief Moves an outstanding timer to a new expiry tick.
+         *
+         * @param h The handle of the timer.
+         * @param expiry The new expiry tick.
+         * @return true If the timer was outstanding and has been rescheduled.
+         */
+        bool reschedule(handle h, std::uint64_t expiry)
+        {
+            if (!valid(h) || nodes_[h.index].bucket == PENDING) {
+                return false;
+            }
+
+            unlink(h.index);
+            nodes_[h.index].expiry = expiry;
+            link(h.index, placement_tick(expiry));
+            return true;
+        }
+
+        /**
+         * @brief Finds the payload of an outstanding timer.
+         *
+         * @param h The handle of the timer.
+         * @return T* A pointer to the payload, or nullptr if the timer has fired or been cancelled.
+         */
+        T* find(handle h)
+        {
+            return valid(h) && nodes_[h.index].bucket != PENDING ? &nodes_[h.index].value : nullptr;
+        }
+
+        /**
+         * @brief Returns the expiry tick of a timer (no validation).
+         */
+        std::uint64_t expiry(handle h) const { return nodes_[h.index].expiry; }
+
+        /**
+         * @brief Advances the current tick to now and fires every timer that expired on the way.
+         *
+         * @param now The new current tick. Moving backwards is a no-op.
+         * @param on_expire Callable invoked as on_expire(T&) for each expired timer, tick by tick.
+         * @return std::size_t The number of timers that fired.
+         */
+        template <typename Fn>
+        std::size_t advance(std::uint64_t now, Fn&& on_expire)
+        {
+            while (now_ < now) {
+                std::uint64_t next = next_event_tick();
+                if (next > now) {
+                    now_ = now;
+                    break;
+                }
+                now_ = next;
+                process_tick();
+            }
+
+            std::size_t fired = 0;
+            while (!expired_.empty()) {
+                std::uint32_t index = expired_.front();
+                expired_.pop_front();
+
+                node& n = nodes_[index];
+                if (n.bucket != CANCELLED) {
+                    // the timer is gone before its callback runs: its handle is already stale
+                    versions_[index] |= DEAD_BIT;
+                    --size_;
+                    ++fired;
+                    on_expire(n.value);
+                }
+                release(index);
+            }
+            return fired;
+        }
+
+        // clang-format off
+        std::uint64_t now()   const noexcept { return now_;       }
+        std::size_t   size()  const noexcept { return size_;      }
+        bool          empty() const noexcept { return size_ == 0; }
+        // clang-format on
+
+    private:
+        bool valid(handle h) const
+        {
+            return h.index < nodes_.size() && versions_[h.index] == h.version && nodes_[h.index].bucket != CANCELLED;
+        }
+
+        // the tick used to place a timer: never the current (already processed) tick
+        std::uint64_t placement_tick(std::uint64_t expiry) const noexcept
+        {
+            return expiry > now_ ? expiry : now_ + 1;
+        }
+
+        // puts a node into the bucket responsible for tick, relative to now_
+        void link(std::uint32_t index, std::uint64_t tick)
+        {
+            std::uint64_t diff = tick ^ now_;
+            std::uint32_t bucket;
+            if (diff >> WHEEL_BITS) {
+                bucket = OVERFLOW_BUCKET;
+            } else {
+                // the level is the highest SLOT_BITS group in which tick and now_ differ
+                std::size_t level = 0;
+                while (diff >> (SLOT_BITS * (level + 1))) {
+                    ++level;
+                }
+                std::size_t slot = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+                bucket           = static_cast<std::uint32_t>(level * SLOTS + slot);
+                occupancy_[level] |= std::uint64_t(1) << slot;
+            }
+
+            std::uint32_t& head = bucket == OVERFLOW_BUCKET ? overflow_head_ : heads_[bucket];
+            node&          n    = nodes_[index];
+            n.bucket            = bucket;
+            n.prev              = NIL;
+            n.next              = head;
+            if (head != NIL) {
+                nodes_[head].prev = index;
+            }
+            head = index;
+        }
+
+        void unlink(std::uint32_t index)
+        {
+            node&          n    = nodes_[index];
+            std::uint32_t& head = n.bucket == OVERFLOW_BUCKET ? overflow_head_ : heads_[n.bucket];
+
+            if (n.prev != NIL) {
+                nodes_[n.prev].next = n.next;
+            } else {
+                head = n.next;
+            }
+            if (n.next != NIL) {
+                nodes_[n.next].prev = n.prev;
+            }
+
+            if (n.bucket != OVERFLOW_BUCKET && head == NIL) {
+                occupancy_[n.bucket / SLOTS] &= ~(std::uint64_t(1) << (n.bucket % SLOTS));
+            }
+            n.bucket = NIL;
+        }
+
+        // detaches a whole bucket and returns its first node
+        std::uint32_t take_bucket(std::size_t level, std::size_t slot)
+        {
+            std::uint32_t first          = heads_[level * SLOTS + slot];
+            heads_[level * SLOTS + slot] = NIL;
+            occupancy_[level] &= ~(std::uint64_t(1) << slot);
+            return first;
+        }
+
+        void release(std::uint32_t index)
+        {
+            nodes_[index].~node();
+            versions_[index] |= DEAD_BIT;
+            nodes_.deallocate(index);
+        }
+
+        // earliest tick after now_ at which a non-empty bucket must be processed
+        std::uint64_t next_event_tick() const noexcept
+        {
+            std::uint64_t next = std::numeric_limits<std::uint64_t>::max();
+            for (std::size_t level = 0; level < LEVELS; ++level) {
+                std::size_t   shift    = SLOT_BITS * level;
+                std::uint64_t position = (now_ >> shift) & SLOT_MASK;
+
+                // buckets are always ahead of the current position within the current revolution
+                std::uint64_t ahead = position == SLOT_MASK ? 0 : occupancy_[level] & (~std::uint64_t(0) << (position + 1));
+                if (ahead != 0) {
+                    std::uint64_t slot  = static_cast<std::uint64_t>(lowest_bit(ahead));
+                    std::uint64_t base  = (now_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+                    std::uint64_t event = base | (slot << shift);
+                    if (event < next) next = event;
+                }
+            }
+            if (overflow_head_ != NIL) {
+                std::uint64_t event = ((now_ >> WHEEL_BITS) + 1) << WHEEL_BITS;
+                if (event < next) next = event;
+            }
+            return next;
+        }
+
+        // cascades the buckets that become current at now_, then collects the due timers
+        void process_tick()
+        {
+            if ((now_ & ((std::uint64_t(1) << WHEEL_BITS) - 1)) == 0) {
+                std::uint32_t index = overflow_head_;
+                overflow_head_      = NIL;
+                relink_list(index);
+            }
+
+            for (std::size_t level = LEVELS - 1; level > 0; --level) {
+                std::size_t shift = SLOT_BITS * level;
+                if ((now_ & ((std::uint64_t(1) << shift) - 1)) == 0) {
+                    relink_list(take_bucket(level, (now_ >> shift) & SLOT_MASK));
+                }
+            }
+
+            for (std::uint32_t index = take_bucket(0, now_ & SLOT_MASK); index != NIL;) {
+                node& n  = nodes_[index];
+                n.bucket = PENDING;
+                if (expired_.full()) {
+                    expired_.set_capacity(expired_.capacity() == 0 ? SLOTS : expired_.capacity() * 2);
+                }
+                expired_.push_back(index);
+                index = n.next;
+            }
+        }
+
+        void relink_list(std::uint32_t index)
+        {
+            while (index != NIL) {
+                std::uint32_t next = nodes_[index].next;
+                link(index, nodes_[index].expiry > now_ ? nodes_[index].expiry : now_);
+                index = next;
+            }
+        }
+
+        static std::uint32_t lowest_bit(std::uint64_t mask) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::uint32_t>(__builtin_ctzll(mask));
+#else
+            std::uint32_t index = 0;
+            while ((mask & 1u) == 0) {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        typed_memory_arena<node, PageSize>          nodes_;            // pooled timer nodes
+        typed_memory_arena<std::uint32_t, PageSize> versions_;         // handle versions, parallel to nodes_
+        std::array<std::uint32_t, LEVELS * SLOTS>   heads_;            // bucket list heads
+        std::array<std::uint64_t, LEVELS>           occupancy_;        // non-empty bucket bitmap per level
+        std::uint32_t                               overflow_head_ = NIL;
+        ring_buffer<std::uint32_t>                  expired_;          // batch of due timers
+        std::uint64_t                               now_;
+        std::size_t                                 size_ = 0;         // outstanding timers
+    };
+
+} // namespace apus
+
+#endif // APUS_TIMER_WHEEL_HPP
@@ -1,10 +1,15 @@
 #ifndef APUS_TYPED_MEMORY_ARENA_HPP
 #define APUS_TYPED_MEMORY_ARENA_HPP
 
+#include <new>
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <utility>
+#include <apus/config.hpp>
 #include <apus/memory_arena.hpp>
+#include <apus/page_source.hpp>
+#include <apus/stats_policy.hpp>
 
 namespace apus
 {
@@ -19,9 +24,11 @@ namespace apus
      *
      * @tparam T The type of objects to store.
      * @tparam PageSizeInElems The number of elements per page.
+     * @tparam Stats The stats policy (see stats_policy.hpp); records page allocations and free list depth.
+     * @tparam PageSource Where pages come from (see page_source.hpp), e.g. numa_page_source to place them on a NUMA node.
      */
-    template <typename T, std::size_t PageSizeInElems>
-    class typed_memory_arena
+    template <typename T, std::size_t PageSizeInElems, typename Stats = null_stats, typename PageSource = heap_page_source>
+    class typed_memory_arena : private Stats
     {
         static_assert(PageSizeInElems > 0, "PageSizeInElems must be greater than 0");
 
@@ -43,6 +50,12 @@ namespace apus
          */
         typed_memory_arena() = default;
 
+        /**
+         * @brief Construct a new typed memory arena that takes its pages from source.
+         */
+        explicit typed_memory_arena(PageSource source)
+            : source_(std::move(source)) {}
+
         // disable copying
         typed_memory_arena(const typed_memory_arena&)            = delete;
         typed_memory_arena& operator=(const typed_memory_arena&) = delete;
@@ -58,8 +71,24 @@ namespace apus
          * a new slot is allocated. A new page is created if necessary.
          *
          * @return allocation_result containing the pointer and the global index.
+         * @throws std::bad_alloc If a new page cannot be allocated (see set_alloc_failure_handler).
          */
         allocation_result allocate()
+        {
+            allocation_result result = try_allocate();
+            if (result.ptr == nullptr) {
+                detail::alloc_failure(sizeof(page_type));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Allocate an element of type T without failing loudly.
+         *
+         * @return allocation_result containing the pointer and the global index, or a
+         *         null pointer if a new page was needed and could not be allocated.
+         */
+        allocation_result try_allocate()
         {
             // try to reuse an index from the freelist
             if (!freelist_.empty()) {
@@ -84,7 +113,12 @@ namespace apus
                 // When we create a new page, it should just be raw memory
                 // We don't want memory_arena to allocate anything from it yet,
                 // just provide the buffer.
-                pages_.emplace_back(std::make_unique<memory_arena<PageSizeInBytes>>());
+                page_ptr page = detail::make_page<page_type>(source_);
+                if (page == nullptr) {
+                    return {nullptr, 0};
+                }
+                pages_.push_back(std::move(page));
+                Stats::record(stats_event::page_allocation);
             }
 
             // Calculate the pointer directly to the indexed slot within the page
@@ -105,6 +139,7 @@ namespace apus
         {
             // we only add to freelist, actual memory reclaim happens on page reset/destruction
             freelist_.push_back(index);
+            Stats::record_level(stats_level::free_list_depth, freelist_.size());
 
             // optionally, we could try to destruct the object if T is not a POD type.
             // for now, we assume simple types or managed destruction by user.
@@ -132,7 +167,7 @@ namespace apus
          */
         T& at(std::size_t index)
         {
-            if (index >= next_global_index_) throw std::out_of_range("typed_memory_arena::at: index out of bounds");
+            if (index >= next_global_index_) detail::throw_error(std::out_of_range("typed_memory_arena::at: index out of bounds"));
             return *get_address(index);
         }
 
@@ -144,10 +179,24 @@ namespace apus
          */
         const T& at(std::size_t index) const
         {
-            if (index >= next_global_index_) throw std::out_of_range("typed_memory_arena::at: index out of bounds");
+            if (index >= next_global_index_) detail::throw_error(std::out_of_range("typed_memory_arena::at: index out of bounds"));
             return *get_address(index);
         }
 
+        /**
+         * @brief Accesses an element by its global index with bounds checking, without failing loudly.
+         * @param index The global index.
+         * @return T* Pointer to the element, or nullptr if index is out of bounds.
+         */
+        T* try_at(std::size_t index) noexcept { return index < next_global_index_ ? get_address(index) : nullptr; }
+
+        /**
+         * @brief Accesses an element by its global index with bounds checking, without failing loudly (const version).
+         * @param index The global index.
+         * @return const T* Pointer to the element, or nullptr if index is out of bounds.
+         */
+        const T* try_at(std::size_t index) const noexcept { return index < next_global_index_ ? get_address(index) : nullptr; }
+
         /**
          * @brief Retrieves the pointer to an element at a specific global index.
          *
@@ -171,8 +220,22 @@ namespace apus
             return next_global_index_;
         }
 
+        /**
+         * @brief Returns the stats policy instance of this arena.
+         */
+        const Stats& stats() const noexcept { return *this; }
+
+        /**
+         * @brief Returns the page source of this arena.
+         */
+        const PageSource& page_source() const noexcept { return source_; }
+
     private:
-        std::vector<std::unique_ptr<memory_arena<PageSizeInBytes>>> pages_;
+        using page_type = memory_arena<PageSizeInBytes>;
+        using page_ptr  = detail::page_ptr<page_type, PageSource>;
+
+        std::vector<page_ptr> pages_;
+        PageSource            source_;
 
         // track the deallocated indices
         std::vector<std::size_t> freelist_;
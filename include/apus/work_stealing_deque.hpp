@@ -0,0 +1,233 @@
+#ifndef APUS_WORK_STEALING_DEQUE_HPP
+#define APUS_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <apus/config.hpp>
+
+namespace apus
+{
+
+    // default initial capacity of a work_stealing_deque (rounded up to a power of two)
+    static constexpr std::size_t DEFAULT_WORK_STEALING_DEQUE_CAPACITY = 256;
+
+    /**
+     * @brief A lock-free Chase-Lev work-stealing deque.
+     *
+     * The owning thread pushes and pops at the bottom (LIFO), while any number of
+     * other threads steal from the top (FIFO). Elements live in a circular array
+     * with a power-of-two capacity, indexed like ring_buffer but with unbounded
+     * 64-bit top/bottom counters masked into the array. When the array is full the
+     * owner copies it into one twice as large; the old array is retired rather than
+     * freed, since a concurrent thief may still be reading from it.
+     *
+     * Based on "Correct and Efficient Work-Stealing for Weak Memory Models"
+     * (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+     *
+     * @tparam T The element type. Must be trivially copyable (typically a pointer).
+     */
+    template <typename T>
+    class work_stealing_deque
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque requires a trivially copyable T");
+
+        // keeps top_ and bottom_ on separate cache lines to avoid false sharing between owner and thieves
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        class circular_array
+        {
+        public:
+            explicit circular_array(std::size_t capacity)
+                : capacity_(capacity), mask_(capacity - 1)
+            {
+                data_ = static_cast<std::atomic<T>*>(std::malloc(capacity_ * sizeof(std::atomic<T>)));
+                if (!data_) detail::alloc_failure(capacity_ * sizeof(std::atomic<T>));
+                for (std::size_t i = 0; i < capacity_; ++i) {
+                    new (data_ + i) std::atomic<T>();
+                }
+            }
+
+            ~circular_array()
+            {
+                std::free(data_);
+            }
+
+            circular_array(const circular_array&)            = delete;
+            circular_array& operator=(const circular_array&) = delete;
+
+            std::size_t capacity() const noexcept { return capacity_; }
+
+            T get(std::int64_t index) const noexcept
+            {
+                return data_[static_cast<std::size_t>(index) & mask_].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t index, T value) noexcept
+            {
+                data_[static_cast<std::size_t>(index) & mask_].store(value, std::memory_order_relaxed);
+            }
+
+            // copies the live range [top, bottom) into a new array of twice the capacity
+            circular_array* grow(std::int64_t bottom, std::int64_t top) const
+            {
+                auto* bigger = new circular_array(capacity_ * 2);
+                for (std::int64_t i = top; i < bottom; ++i) {
+                    bigger->put(i, get(i));
+                }
+                return bigger;
+            }
+
+        private:
+            std::size_t     capacity_;
+            std::size_t     mask_;
+            std::atomic<T>* data_;
+        };
+
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Construct a new work-stealing deque.
+         *
+         * @param capacity The initial capacity, rounded up to a power of two.
+         */
+        explicit work_stealing_deque(size_type capacity = DEFAULT_WORK_STEALING_DEQUE_CAPACITY)
+        {
+            size_type rounded = 1;
+            while (rounded < capacity) {
+                rounded *= 2;
+            }
+            array_.store(new circular_array(rounded), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Destructor. Must not race with any other operation.
+         */
+        ~work_stealing_deque()
+        {
+            delete array_.load(std::memory_order_relaxed);
+        }
+
+        // disable copying and moving
+        work_stealing_deque(const work_stealing_deque&)            = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+        work_stealing_deque(work_stealing_deque&&)                 = delete;
+        work_stealing_deque& operator=(work_stealing_deque&&)      = delete;
+
+        /**
+         * @brief Pushes an element at the bottom. Owner thread only.
+         *
+         * @param value The element to push.
+         */
+        void push(T value)
+        {
+            std::int64_t    b = bottom_.load(std::memory_order_relaxed);
+            std::int64_t    t = top_.load(std::memory_order_acquire);
+            circular_array* a = array_.load(std::memory_order_relaxed);
+
+            if (b - t > static_cast<std::int64_t>(a->capacity()) - 1) {
+                circular_array* bigger = a->grow(b, t);
+                retired_.emplace_back(a);
+                array_.store(bigger, std::memory_order_release);
+                a = bigger;
+            }
+
+            // release publishes the element to thieves that acquire bottom_
+            a->put(b, value);
+            bottom_.store(b + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Pops the most recently pushed element. Owner thread only.
+         *
+         * @param out Receives the element on success.
+         * @return true If an element was popped, false if the deque was empty.
+         */
+        bool pop(T& out)
+        {
+            std::int64_t    b = bottom_.load(std::memory_order_relaxed) - 1;
+            circular_array* a = array_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // deque was empty
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            out = a->get(b);
+            if (t == b) {
+                // last element: race against thieves for it
+                bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Steals the least recently pushed element. Any thread.
+         *
+         * @param out Receives the element on success.
+         * @return true If an element was stolen, false if the deque was empty or another thread won the race.
+         */
+        bool steal(T& out)
+        {
+            std::int64_t t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+            if (t >= b) {
+                return false;
+            }
+
+            circular_array* a     = array_.load(std::memory_order_acquire);
+            T               value = a->get(t);
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
+        /**
+         * @brief Returns an approximate number of elements (exact when called by the owner with no thieves).
+         */
+        size_type size() const noexcept
+        {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_type>(b - t) : 0;
+        }
+
+        /**
+         * @brief Checks if the deque appears empty.
+         */
+        bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Returns the capacity of the current circular array.
+         */
+        size_type capacity() const noexcept { return array_.load(std::memory_order_relaxed)->capacity(); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top_{0};    // next index to steal
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_{0}; // next index to push
+        alignas(CACHE_LINE_SIZE) std::atomic<circular_array*> array_{nullptr};
+
+        // arrays replaced by grow(), kept alive until destruction for in-flight thieves (owner only)
+        std::vector<std::unique_ptr<circular_array>> retired_;
+    };
+
+} // namespace apus
+
+#endif // APUS_WORK_STEALING_DEQUE_HPP
@@ -0,0 +1,180 @@
+#include "alloc_counter.hpp"
+
+#include <new>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+
+#include <apus/config.hpp>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    // plain data, so that touching it from inside malloc never allocates
+    thread_local apus_testing::alloc_counts thread_counts = {0, 0, 0};
+
+    std::atomic<bool>         tracking{false};
+    std::atomic<std::int64_t> live_bytes{0};
+    std::atomic<std::int64_t> peak_bytes{0};
+
+    void add_live(std::int64_t bytes) noexcept
+    {
+        std::int64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void count_allocation(void* p, std::size_t requested, std::size_t usable) noexcept
+    {
+        if (p == nullptr) return;
+        ++thread_counts.allocations;
+        thread_counts.bytes += requested;
+        if (tracking.load(std::memory_order_relaxed)) add_live(static_cast<std::int64_t>(usable));
+    }
+
+    void count_deallocation(void* p, std::size_t usable) noexcept
+    {
+        if (p == nullptr) return;
+        ++thread_counts.deallocations;
+        if (tracking.load(std::memory_order_relaxed)) live_bytes.fetch_sub(static_cast<std::int64_t>(usable), std::memory_order_relaxed);
+    }
+} // namespace
+
+namespace apus_testing
+{
+    alloc_counts thread_alloc_counts() noexcept { return thread_counts; }
+
+    void enable_heap_tracking() noexcept { tracking.store(true, std::memory_order_relaxed); }
+
+    std::int64_t live_heap_bytes() noexcept { return live_bytes.load(std::memory_order_relaxed); }
+    std::int64_t peak_heap_bytes() noexcept { return peak_bytes.load(std::memory_order_relaxed); }
+    void reset_peak_heap_bytes() noexcept { peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+} // namespace apus_testing
+
+#if defined(__GLIBC__)
+
+// Interpose glibc's malloc family; operator new, the std containers and the apus
+// containers that call std::malloc directly all end up here.
+extern "C"
+{
+    void* __libc_malloc(std::size_t);
+    void* __libc_calloc(std::size_t, std::size_t);
+    void* __libc_realloc(void*, std::size_t);
+    void* __libc_memalign(std::size_t, std::size_t);
+    void  __libc_free(void*);
+
+    void* malloc(std::size_t n) noexcept
+    {
+        void* p = __libc_malloc(n);
+        count_allocation(p, n, p != nullptr ? malloc_usable_size(p) : 0);
+        return p;
+    }
+
+    void* calloc(std::size_t n, std::size_t size) noexcept
+    {
+        void* p = __libc_calloc(n, size);
+        count_allocation(p, n * size, p != nullptr ? malloc_usable_size(p) : 0);
+        return p;
+    }
+
+    void* memalign(std::size_t alignment, std::size_t n) noexcept
+    {
+        void* p = __libc_memalign(alignment, n);
+        count_allocation(p, n, p != nullptr ? malloc_usable_size(p) : 0);
+        return p;
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t n) noexcept { return memalign(alignment, n); }
+
+    int posix_memalign(void** out, std::size_t alignment, std::size_t n) noexcept
+    {
+        void* p = memalign(alignment, n);
+        if (p == nullptr) return ENOMEM;
+        *out = p;
+        return 0;
+    }
+
+    void* realloc(void* p, std::size_t n) noexcept
+    {
+        std::size_t old = p != nullptr ? malloc_usable_size(p) : 0;
+        void*       q   = __libc_realloc(p, n);
+        if (q == nullptr && n != 0) return nullptr; // failed, p is untouched
+        count_deallocation(p, old);
+        count_allocation(q, n, q != nullptr ? malloc_usable_size(q) : 0);
+        return q;
+    }
+
+    void free(void* p) noexcept
+    {
+        count_deallocation(p, p != nullptr ? malloc_usable_size(p) : 0);
+        __libc_free(p);
+    }
+}
+
+#else
+
+// Without glibc, count through the replaceable global operator new/delete instead;
+// usable sizes are unknown, so live bytes are not tracked. Direct malloc calls are
+// not counted.
+namespace
+{
+    void* counted_new_nothrow(std::size_t n, std::size_t alignment = 0) noexcept
+    {
+        if (n == 0) n = 1;
+        void* p = nullptr;
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            // aligned_alloc requires a size that is a multiple of the alignment
+            p = std::aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment);
+        } else {
+            p = std::malloc(n);
+        }
+        count_allocation(p, n, 0);
+        return p;
+    }
+
+    void* counted_new(std::size_t n, std::size_t alignment = 0)
+    {
+        void* p = counted_new_nothrow(n, alignment);
+        if (p == nullptr) {
+#if APUS_EXCEPTIONS
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        return p;
+    }
+
+    void counted_delete(void* p) noexcept
+    {
+        count_deallocation(p, 0);
+        std::free(p);
+    }
+} // namespace
+
+void* operator new(std::size_t n) { return counted_new(n); }
+void* operator new[](std::size_t n) { return counted_new(n); }
+void* operator new(std::size_t n, std::align_val_t al) { return counted_new(n, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t n, std::align_val_t al) { return counted_new(n, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return counted_new_nothrow(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return counted_new_nothrow(n); }
+void* operator new(std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_new_nothrow(n, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_new_nothrow(n, static_cast<std::size_t>(al)); }
+void  operator delete(void* p) noexcept { counted_delete(p); }
+void  operator delete[](void* p) noexcept { counted_delete(p); }
+void  operator delete(void* p, std::size_t) noexcept { counted_delete(p); }
+void  operator delete[](void* p, std::size_t) noexcept { counted_delete(p); }
+void  operator delete(void* p, std::align_val_t) noexcept { counted_delete(p); }
+void  operator delete[](void* p, std::align_val_t) noexcept { counted_delete(p); }
+void  operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_delete(p); }
+void  operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_delete(p); }
+void  operator delete(void* p, const std::nothrow_t&) noexcept { counted_delete(p); }
+void  operator delete[](void* p, const std::nothrow_t&) noexcept { counted_delete(p); }
+void  operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_delete(p); }
+void  operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_delete(p); }
+
+#endif
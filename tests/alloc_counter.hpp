@@ -0,0 +1,86 @@
+#ifndef APUS_ALLOC_COUNTER_HPP
+#define APUS_ALLOC_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation counting for tests and benchmarks. Linking alloc_counter.cpp into an
+// executable hooks its malloc family (glibc) or its global operator new/delete
+// (elsewhere), counting every allocation of the calling thread. On glibc operator new
+// reaches malloc, so both are counted either way.
+
+namespace apus_testing
+{
+
+    /**
+     * @brief Heap operations counted on one thread.
+     */
+    struct alloc_counts
+    {
+        std::uint64_t allocations;   // successful malloc/calloc/realloc/aligned allocations
+        std::uint64_t deallocations; // frees of non-null pointers
+        std::uint64_t bytes;         // bytes requested by those allocations
+    };
+
+    /**
+     * @brief Returns the counts of the calling thread since it started.
+     */
+    alloc_counts thread_alloc_counts() noexcept;
+
+    /**
+     * @brief Enables process-wide tracking of live and peak heap bytes.
+     *
+     * Off by default, since it adds a shared atomic to every allocation. Live bytes are
+     * the usable sizes malloc hands out, so size class rounding is included; frees of
+     * blocks allocated before tracking was enabled are subtracted too, so measure
+     * differences.
+     */
+    void enable_heap_tracking() noexcept;
+
+    /**
+     * @brief Returns the heap bytes currently allocated by all threads (with heap tracking).
+     */
+    std::int64_t live_heap_bytes() noexcept;
+
+    /**
+     * @brief Returns the most heap bytes allocated at once since the last reset (with heap tracking).
+     */
+    std::int64_t peak_heap_bytes() noexcept;
+
+    /**
+     * @brief Resets the peak to the current live heap bytes.
+     */
+    void reset_peak_heap_bytes() noexcept;
+
+    /**
+     * @brief Counts the allocations made by the calling thread during its lifetime.
+     */
+    class alloc_scope
+    {
+    public:
+        alloc_scope() noexcept : start_(thread_alloc_counts()) {}
+
+        std::uint64_t allocations() const noexcept { return thread_alloc_counts().allocations - start_.allocations; }
+        std::uint64_t deallocations() const noexcept { return thread_alloc_counts().deallocations - start_.deallocations; }
+        std::uint64_t bytes() const noexcept { return thread_alloc_counts().bytes - start_.bytes; }
+
+    private:
+        alloc_counts start_;
+    };
+
+} // namespace apus_testing
+
+/**
+ * @brief Runs a block and fails the current googletest test if it allocated on this thread.
+ *
+ * Usage: APUS_EXPECT_NO_ALLOC({ v.push_back(1); });
+ */
+#define APUS_EXPECT_NO_ALLOC(...)                                                                                      \
+    do {                                                                                                               \
+        apus_testing::alloc_scope apus_alloc_scope_;                                                                   \
+        __VA_ARGS__;                                                                                                   \
+        std::uint64_t apus_allocations_ = apus_alloc_scope_.allocations();                                             \
+        EXPECT_EQ(apus_allocations_, 0u) << "expected no heap allocation in " #__VA_ARGS__;                            \
+    } while (0)
+
+#endif // APUS_ALLOC_COUNTER_HPP
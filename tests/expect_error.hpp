@@ -0,0 +1,19 @@
+#ifndef APUS_EXPECT_ERROR_HPP
+#define APUS_EXPECT_ERROR_HPP
+
+#include <gtest/gtest.h>
+#include <apus/config.hpp>
+
+/**
+ * @brief Expects a statement to fail with an apus error.
+ *
+ * With exceptions this is EXPECT_THROW(statement, exception). Without them apus
+ * aborts instead of throwing, so the statement has to die (in a death test child).
+ */
+#if APUS_EXCEPTIONS
+#define APUS_EXPECT_ERROR(statement, exception) EXPECT_THROW(statement, exception)
+#else
+#define APUS_EXPECT_ERROR(statement, exception) EXPECT_DEATH(statement, "apus: ")
+#endif
+
+#endif // APUS_EXPECT_ERROR_HPP
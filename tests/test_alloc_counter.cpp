@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "alloc_counter.hpp"
+
+namespace
+{
+
+    // keeps the compiler from eliding an allocation whose result is otherwise unused
+    void escape(const void* p) { asm volatile("" : : "r"(p) : "memory"); }
+
+    TEST(AllocCounterTest, CountsNew)
+    {
+        apus_testing::alloc_scope scope;
+
+        auto p = std::make_unique<int>(1);
+        escape(p.get());
+        EXPECT_EQ(scope.allocations(), 1);
+        EXPECT_GE(scope.bytes(), sizeof(int));
+
+        p.reset();
+        EXPECT_EQ(scope.deallocations(), 1);
+    }
+
+#if defined(__GLIBC__)
+    // without glibc only operator new/delete are hooked
+    TEST(AllocCounterTest, CountsMalloc)
+    {
+        apus_testing::alloc_scope scope;
+
+        void* q = std::malloc(100);
+        escape(q);
+        EXPECT_EQ(scope.allocations(), 1);
+        EXPECT_GE(scope.bytes(), 100);
+
+        std::free(q);
+        EXPECT_EQ(scope.deallocations(), 1);
+    }
+#endif
+
+    TEST(AllocCounterTest, CountsOnlyTheCallingThread)
+    {
+        std::thread worker; // created outside the scope, it allocates its own state
+        apus_testing::alloc_scope scope;
+        std::uint64_t             worker_allocations = 0;
+
+        worker = std::thread([&] {
+            apus_testing::alloc_scope worker_scope;
+            std::vector<int>          v(1000);
+            escape(v.data());
+            worker_allocations = worker_scope.allocations();
+        });
+        std::uint64_t before_join = scope.allocations(); // std::thread allocates its state here
+        worker.join();
+
+        EXPECT_EQ(worker_allocations, 1);
+        EXPECT_EQ(scope.allocations(), before_join);
+    }
+
+    TEST(AllocCounterTest, ExpectNoAllocAcceptsStackOnlyCode)
+    {
+        int values[16] = {};
+        APUS_EXPECT_NO_ALLOC({
+            for (int& v : values) v = 1;
+        });
+        EXPECT_EQ(values[15], 1);
+    }
+
+#if defined(__GLIBC__)
+    TEST(AllocCounterTest, HeapTrackingFollowsLiveBytes)
+    {
+        apus_testing::enable_heap_tracking();
+        std::int64_t before = apus_testing::live_heap_bytes();
+        apus_testing::reset_peak_heap_bytes();
+
+        void* p = std::malloc(1 << 16);
+        escape(p);
+        EXPECT_GE(apus_testing::live_heap_bytes() - before, 1 << 16);
+        std::free(p);
+
+        EXPECT_EQ(apus_testing::live_heap_bytes(), before);
+        EXPECT_GE(apus_testing::peak_heap_bytes() - before, 1 << 16);
+    }
+#endif
+
+} // namespace
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <apus/async_ring_buffer.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "alloc_counter.hpp"
+
+namespace
+{
+
+    apus::detached_task produce(apus::async_ring_buffer<int>& queue, int first, int count, bool close)
+    {
+        for (int i = first; i < first + count; ++i) {
+            EXPECT_TRUE(co_await queue.push(i));
+        }
+        if (close) queue.close();
+    }
+
+    apus::detached_task consume(apus::async_ring_buffer<int>& queue, std::vector<int>& out)
+    {
+        while (std::optional<int> value = co_await queue.pop()) {
+            out.push_back(*value);
+        }
+    }
+
+    TEST(AsyncRingBufferTest, TryPushAndTryPop)
+    {
+        apus::async_ring_buffer<std::string> queue(2);
+        EXPECT_TRUE(queue.try_push("a"));
+        EXPECT_TRUE(queue.try_push("b"));
+        EXPECT_FALSE(queue.try_push("c"));
+        EXPECT_EQ(queue.size(), 2);
+
+        EXPECT_EQ(queue.try_pop(), "a");
+        EXPECT_EQ(queue.try_pop(), "b");
+        EXPECT_EQ(queue.try_pop(), std::nullopt);
+    }
+
+    TEST(AsyncRingBufferTest, ProducerSuspendsWhenFull)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(4);
+        std::vector<int>             out;
+
+        executor.spawn(produce(queue, 0, 100, true));
+        executor.run();
+        // the producer filled the queue and is suspended in push
+        EXPECT_EQ(queue.size(), 4);
+        EXPECT_FALSE(queue.closed());
+
+        executor.spawn(consume(queue, out));
+        executor.run();
+        EXPECT_TRUE(queue.closed());
+        ASSERT_EQ(out.size(), 100);
+        for (int i = 0; i < 100; ++i) EXPECT_EQ(out[i], i);
+    }
+
+    TEST(AsyncRingBufferTest, ConsumerSuspendsWhenEmpty)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(4);
+        std::vector<int>             out;
+
+        executor.spawn(consume(queue, out));
+        executor.run();
+        EXPECT_TRUE(out.empty());
+
+        // a pushed value is handed straight to the waiting consumer
+        EXPECT_TRUE(queue.try_push(7));
+        EXPECT_EQ(out, std::vector<int>{7});
+        EXPECT_TRUE(queue.empty());
+
+        queue.close();
+        EXPECT_FALSE(queue.try_push(8));
+    }
+
+    TEST(AsyncRingBufferTest, RendezvousWithZeroCapacity)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(0);
+        std::vector<int>             out;
+
+        executor.spawn(produce(queue, 0, 10, true));
+        executor.spawn(consume(queue, out));
+        executor.run();
+        EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    TEST(AsyncRingBufferTest, ManyProducersKeepPerProducerOrder)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(3);
+        std::vector<int>             out;
+
+        for (int p = 0; p < 8; ++p) executor.spawn(produce(queue, p * 1000, 50, false));
+        executor.spawn(consume(queue, out));
+        executor.run();
+        queue.close();
+
+        ASSERT_EQ(out.size(), 8 * 50);
+        std::vector<int> last(8, -1);
+        for (int value : out) {
+            EXPECT_GT(value % 1000, last[value / 1000]);
+            last[value / 1000] = value % 1000;
+        }
+    }
+
+    TEST(AsyncRingBufferTest, CloseWakesBlockedProducers)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(1);
+        bool                         accepted = true;
+
+        auto blocked = [](apus::async_ring_buffer<int>& q, bool& result) -> apus::detached_task {
+            co_await q.push(1);
+            result = co_await q.push(2);
+        };
+        executor.spawn(blocked(queue, accepted));
+        executor.run();
+        queue.close();
+        EXPECT_FALSE(accepted);
+
+        // pops still drain what was queued before close
+        EXPECT_EQ(queue.try_pop(), 1);
+        EXPECT_EQ(queue.try_pop(), std::nullopt);
+    }
+
+    TEST(AsyncRingBufferTest, MoveOnlyElements)
+    {
+        apus::coroutine_executor                      executor;
+        apus::async_ring_buffer<std::unique_ptr<int>> queue(1);
+        std::vector<int>                              out;
+
+        auto producer = [](apus::async_ring_buffer<std::unique_ptr<int>>& q) -> apus::detached_task {
+            for (int i = 0; i < 5; ++i) co_await q.push(std::make_unique<int>(i));
+            q.close();
+        };
+        auto consumer = [](apus::async_ring_buffer<std::unique_ptr<int>>& q, std::vector<int>& o) -> apus::detached_task {
+            while (auto value = co_await q.pop()) o.push_back(**value);
+        };
+        executor.spawn(producer(queue));
+        executor.spawn(consumer(queue, out));
+        executor.run();
+        EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+    }
+
+    TEST(AsyncRingBufferTest, ExecutorScheduleYields)
+    {
+        apus::coroutine_executor executor(1);
+        std::vector<int>         order;
+
+        auto worker = [](apus::coroutine_executor& e, std::vector<int>& o, int id) -> apus::detached_task {
+            for (int i = 0; i < 3; ++i) {
+                o.push_back(id);
+                co_await e.schedule();
+            }
+        };
+        executor.spawn(worker(executor, order, 1));
+        executor.spawn(worker(executor, order, 2));
+        EXPECT_EQ(executor.pending(), 2);
+        EXPECT_EQ(executor.run(), 8);
+        EXPECT_EQ(order, (std::vector<int>{1, 2, 1, 2, 1, 2}));
+    }
+
+    TEST(AsyncRingBufferTest, WaitingDoesNotAllocate)
+    {
+        apus::coroutine_executor     executor;
+        apus::async_ring_buffer<int> queue(2);
+        std::vector<int>             out;
+        out.reserve(64);
+
+        executor.spawn(consume(queue, out));
+        executor.run();
+        APUS_EXPECT_NO_ALLOC({
+            for (int i = 0; i < 64; ++i) queue.try_push(i);
+        });
+        EXPECT_EQ(out.size(), 64);
+        queue.close();
+    }
+
+} // namespace
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <apus/child_arena.hpp>
+#include <apus/memory_arena.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include <cstdint>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
+
+namespace
+{
+
+    bool within(const apus::child_arena& child, const void* p, std::size_t bytes)
+    {
+        auto base = reinterpret_cast<std::uintptr_t>(child.get_base_address());
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        return addr >= base && addr + bytes <= base + child.capacity();
+    }
+
+    TEST(ChildArenaTest, CarvedFromMemoryArena)
+    {
+        apus::memory_arena<4096> parent;
+        apus::child_arena        child = parent.make_child(1024);
+        EXPECT_EQ(child.capacity(), 1024);
+        EXPECT_EQ(parent.used_bytes(), 1024);
+
+        void* a = child.allocate(100);
+        void* b = child.allocate(200);
+        EXPECT_TRUE(within(child, a, 100));
+        EXPECT_TRUE(within(child, b, 200));
+        EXPECT_EQ(child.used_bytes(), 100 + 12 + 200); // b is padded to max_align_t
+        EXPECT_EQ(parent.used_bytes(), 1024);         // the parent only sees the carve
+
+        // the parent keeps allocating past the child's range
+        void* c = parent.allocate(64);
+        EXPECT_FALSE(within(child, c, 64));
+    }
+
+    TEST(ChildArenaTest, ResetAndRewindAreIndependentOfParent)
+    {
+        apus::memory_arena<4096> parent;
+        apus::child_arena        first  = parent.make_child(512);
+        apus::child_arena        second = parent.make_child(512);
+
+        void* kept = first.allocate(64);
+        auto  mark = first.mark();
+        void* temp = first.allocate(128);
+        first.rewind(mark);
+        EXPECT_EQ(first.allocate(128), temp);
+        EXPECT_EQ(first.used_bytes(), 64 + 128);
+        EXPECT_EQ(first.high_water_mark(), 64 + 128);
+
+        second.allocate(256);
+        first.reset();
+        EXPECT_EQ(first.used_bytes(), 0);
+        EXPECT_EQ(first.allocate(64), kept);
+        EXPECT_EQ(second.used_bytes(), 256);
+        EXPECT_EQ(parent.used_bytes(), 1024);
+    }
+
+    TEST(ChildArenaTest, BudgetOverflowIsReported)
+    {
+        apus::memory_arena<4096> parent;
+        apus::child_arena        child = parent.make_child(256);
+
+        EXPECT_NE(child.try_allocate(200), nullptr);
+        EXPECT_EQ(child.try_allocate(100), nullptr);
+        EXPECT_EQ(child.overflow_count(), 1);
+        APUS_EXPECT_ERROR(child.allocate(100), std::bad_alloc);
+        EXPECT_NE(child.allocate(48), nullptr); // what is left still serves
+        EXPECT_EQ(child.remaining_bytes(), 0);
+
+        // a child larger than what the parent has left is refused
+        EXPECT_FALSE(parent.try_make_child(4096).has_value());
+        APUS_EXPECT_ERROR(parent.make_child(4096), std::bad_alloc);
+    }
+
+    TEST(ChildArenaTest, HierarchicalPartitioning)
+    {
+        apus::memory_arena<8192> request;
+        apus::child_arena        subsystem = request.make_child(4096);
+        apus::child_arena        parsing   = subsystem.make_child(1024);
+        apus::child_arena        scratch   = subsystem.make_child(1024);
+
+        EXPECT_TRUE(within(subsystem, parsing.get_base_address(), parsing.capacity()));
+        EXPECT_TRUE(within(subsystem, scratch.get_base_address(), scratch.capacity()));
+        EXPECT_EQ(subsystem.used_bytes(), 2048);
+        EXPECT_FALSE(subsystem.try_make_child(4096).has_value());
+
+        APUS_EXPECT_NO_ALLOC({
+            for (int i = 0; i < 16; ++i) parsing.allocate(64);
+            scratch.allocate(512);
+            parsing.reset();
+            apus::child_arena nested = scratch.make_child(256);
+            nested.allocate(256);
+        });
+    }
+
+    TEST(ChildArenaTest, MoveLeavesEmptyChild)
+    {
+        apus::memory_arena<1024> parent;
+        apus::child_arena        child = parent.make_child(256);
+        child.allocate(16);
+
+        apus::child_arena moved = std::move(child);
+        EXPECT_EQ(moved.capacity(), 256);
+        EXPECT_EQ(moved.used_bytes(), 16);
+        EXPECT_EQ(child.capacity(), 0);
+        EXPECT_EQ(child.try_allocate(1), nullptr);
+    }
+
+    TEST(ChildArenaTest, CarvedFromPagedArena)
+    {
+        apus::paged_memory_arena<1024> parent;
+        parent.allocate(800);
+
+        // the child does not fit in the rest of the page, so it starts a new one
+        apus::child_arena child = parent.make_child(512);
+        EXPECT_EQ(parent.page_count(), 2);
+        EXPECT_NE(child.allocate(512), nullptr);
+
+        APUS_EXPECT_ERROR(parent.make_child(2048), std::length_error);
+        EXPECT_FALSE(parent.try_make_child(2048).has_value());
+
+        // the parent's reset reclaims the child's page
+        parent.reset();
+        EXPECT_EQ(parent.page_count(), 1);
+    }
+
+} // namespace
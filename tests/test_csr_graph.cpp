@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <apus/csr_graph.hpp>
+#include <apus/small_vector.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "expect_error.hpp"
+
+namespace
+{
+
+    using adjacency = std::vector<apus::small_vector<std::uint32_t, 4>>;
+
+    adjacency random_adjacency(std::size_t nodes, std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        adjacency    rows(nodes);
+        for (auto& row : rows) {
+            std::size_t degree = rng() % 10; // some rows spill past the inline buffer
+            for (std::size_t e = 0; e < degree; ++e) row.push_back(static_cast<std::uint32_t>(rng() % nodes));
+        }
+        return rows;
+    }
+
+    TEST(CsrGraphTest, FromSmallVectorRows)
+    {
+        adjacency       rows  = random_adjacency(500, 1);
+        apus::csr_graph graph = apus::csr_graph<>::from_rows(rows);
+
+        ASSERT_EQ(graph.size(), rows.size());
+        std::size_t edges = 0;
+        for (std::size_t r = 0; r < rows.size(); ++r) {
+            EXPECT_EQ(graph.degree(r), rows[r].size());
+            EXPECT_TRUE(std::equal(rows[r].begin(), rows[r].end(), graph[r].begin(), graph[r].end()));
+            edges += rows[r].size();
+        }
+        EXPECT_EQ(graph.edge_count(), edges);
+        EXPECT_EQ(graph.offsets().size(), rows.size() + 1);
+        EXPECT_EQ(graph.offsets().back(), edges);
+    }
+
+    TEST(CsrGraphTest, RowViewMatchesSmallVectorReadInterface)
+    {
+        apus::small_vector<std::uint32_t, 4> source{7, 3, 9, 3, 11};
+        apus::csr_graph                      graph = apus::csr_graph<>::from_rows(std::vector{source});
+        auto                                 row   = graph.at(0);
+
+        EXPECT_EQ(row.size(), source.size());
+        EXPECT_FALSE(row.empty());
+        EXPECT_EQ(row.front(), source.front());
+        EXPECT_EQ(row.back(), source.back());
+        EXPECT_EQ(row[2], source[2]);
+        EXPECT_EQ(row.at(4), source.at(4));
+        EXPECT_EQ(row.find(3) - row.begin(), source.find(3) - source.begin());
+        EXPECT_TRUE(row.contains(9));
+        EXPECT_FALSE(row.contains(8));
+        EXPECT_EQ(row.data(), &row[0]);
+        EXPECT_EQ(row.cend() - row.cbegin(), 5);
+        APUS_EXPECT_ERROR(row.at(5), std::out_of_range);
+        APUS_EXPECT_ERROR(graph.at(1), std::out_of_range);
+    }
+
+    TEST(CsrGraphTest, BuilderSortsOutOfOrderEdgesStably)
+    {
+        apus::csr_builder<> builder;
+        builder.add_edge(2, 20);
+        builder.add_edge(0, 1);
+        builder.add_edge(2, 21);
+        builder.add_edge(0, 2);
+        builder.add_edge(4, 40);
+        builder.add_edge(2, 22);
+        EXPECT_EQ(builder.row_count(), 5);
+        EXPECT_EQ(builder.edge_count(), 6);
+
+        apus::csr_graph<> graph = builder.freeze();
+        ASSERT_EQ(graph.size(), 5);
+        EXPECT_EQ(std::vector<std::uint32_t>(graph[0].begin(), graph[0].end()), (std::vector<std::uint32_t>{1, 2}));
+        EXPECT_TRUE(graph[1].empty());
+        EXPECT_EQ(std::vector<std::uint32_t>(graph[2].begin(), graph[2].end()), (std::vector<std::uint32_t>{20, 21, 22}));
+        EXPECT_TRUE(graph[3].empty());
+        EXPECT_EQ(std::vector<std::uint32_t>(graph[4].begin(), graph[4].end()), (std::vector<std::uint32_t>{40}));
+
+        // freeze leaves the builder empty
+        EXPECT_EQ(builder.row_count(), 0);
+        EXPECT_EQ(builder.freeze().size(), 0);
+    }
+
+    TEST(CsrGraphTest, MixedRowsAndEdges)
+    {
+        apus::csr_builder<> builder;
+        EXPECT_EQ(builder.add_row(std::vector<std::uint32_t>{1, 2}), 0);
+        EXPECT_EQ(builder.add_row(std::vector<std::uint32_t>{}), 1);
+        builder.add_edge(0, 3); // back into row 0, out of order
+        EXPECT_EQ(builder.add_row(std::vector<std::uint32_t>{4}), 2);
+        builder.resize_rows(6);
+
+        apus::csr_graph<> graph = builder.freeze();
+        ASSERT_EQ(graph.size(), 6);
+        EXPECT_EQ(std::vector<std::uint32_t>(graph[0].begin(), graph[0].end()), (std::vector<std::uint32_t>{1, 2, 3}));
+        EXPECT_EQ(graph.degree(1), 0);
+        EXPECT_EQ(graph[2].front(), 4);
+        EXPECT_EQ(graph.degree(5), 0);
+    }
+
+    TEST(CsrGraphTest, EmptyGraph)
+    {
+        apus::csr_graph<> graph;
+        EXPECT_TRUE(graph.empty());
+        EXPECT_EQ(graph.edge_count(), 0);
+        EXPECT_EQ(graph.offsets().size(), 1);
+    }
+
+    TEST(CsrGraphTest, OffsetTypeOverflow)
+    {
+        apus::csr_builder<std::uint32_t, std::uint8_t> builder;
+        for (std::uint32_t i = 0; i < 255; ++i) builder.add_edge(i % 3, i);
+        EXPECT_EQ(builder.freeze().edge_count(), 255);
+
+        for (std::uint32_t i = 0; i < 256; ++i) builder.add_edge(0, i);
+        APUS_EXPECT_ERROR(builder.freeze(), std::length_error);
+    }
+
+    TEST(CsrGraphTest, SmallerThanSmallVectorRows)
+    {
+        adjacency       rows  = random_adjacency(10000, 2);
+        apus::csr_graph graph = apus::csr_graph<>::from_rows(rows);
+
+        std::size_t nested_bytes = rows.capacity() * sizeof(rows[0]);
+        for (const auto& row : rows) {
+            if (row.capacity() > 4) nested_bytes += row.capacity() * sizeof(std::uint32_t); // spilled to the heap
+        }
+        EXPECT_LT(graph.memory_bytes() * 2, nested_bytes);
+    }
+
+} // namespace
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <apus/flat_hash_map.hpp>
+#include <apus/memory_arena.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
+
+namespace
+{
+
+    struct string_hash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+    };
+
+    struct string_equal
+    {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const { return a == b; }
+    };
+
+    TEST(FlatHashMapTest, DefaultConstructor)
+    {
+        apus::flat_hash_map<int, int> m;
+        EXPECT_TRUE(m.empty());
+        EXPECT_EQ(m.size(), 0);
+        EXPECT_EQ(m.capacity(), 0);
+        EXPECT_EQ(m.find(1), m.end());
+        EXPECT_EQ(m.begin(), m.end());
+    }
+
+    TEST(FlatHashMapTest, InsertAndFind)
+    {
+        apus::flat_hash_map<int, int> m;
+        auto [it, inserted] = m.insert({1, 10});
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(it->first, 1);
+        EXPECT_EQ(it->second, 10);
+
+        auto [it2, inserted2] = m.insert({1, 20});
+        EXPECT_FALSE(inserted2);
+        EXPECT_EQ(it2->second, 10);
+
+        m[2] = 20;
+        EXPECT_EQ(m.size(), 2);
+        EXPECT_EQ(m.at(2), 20);
+        EXPECT_TRUE(m.contains(1));
+        EXPECT_FALSE(m.contains(3));
+        EXPECT_EQ(m.count(2), 1);
+        APUS_EXPECT_ERROR(m.at(3), std::out_of_range);
+
+        m.insert_or_assign(1, 11);
+        EXPECT_EQ(m.at(1), 11);
+    }
+
+    TEST(FlatHashMapTest, GrowthKeepsAllElements)
+    {
+        apus::flat_hash_map<int, int> m;
+        for (int i = 0; i < 10000; ++i) {
+            m[i] = i * 2;
+        }
+        EXPECT_EQ(m.size(), 10000);
+        EXPECT_LE(m.load_factor(), m.max_load_factor());
+        for (int i = 0; i < 10000; ++i) {
+            ASSERT_EQ(m.at(i), i * 2);
+        }
+        EXPECT_FALSE(m.contains(10000));
+    }
+
+    TEST(FlatHashMapTest, EraseAndReinsert)
+    {
+        apus::flat_hash_map<int, int> m;
+        for (int i = 0; i < 1000; ++i) {
+            m[i] = i;
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            EXPECT_EQ(m.erase(i), 1);
+        }
+        EXPECT_EQ(m.erase(0), 0);
+        EXPECT_EQ(m.size(), 500);
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(m.contains(i), i % 2 == 1);
+        }
+
+        // churn through many erase/insert cycles without growing unboundedly
+        std::size_t capacity = m.capacity();
+        for (int round = 0; round < 50; ++round) {
+            for (int i = 0; i < 1000; i += 2) m[i + 1000 * (round + 1)] = i;
+            for (int i = 0; i < 1000; i += 2) m.erase(i + 1000 * (round + 1));
+        }
+        EXPECT_EQ(m.size(), 500);
+        EXPECT_EQ(m.capacity(), capacity);
+    }
+
+    TEST(FlatHashMapTest, EraseByIterator)
+    {
+        apus::flat_hash_map<int, int> m;
+        for (int i = 0; i < 100; ++i) m[i] = i;
+
+        for (auto it = m.begin(); it != m.end();) {
+            if (it->first % 3 == 0) {
+                it = m.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        EXPECT_EQ(m.size(), 66);
+        for (const auto& [k, v] : m) {
+            EXPECT_NE(k % 3, 0);
+            EXPECT_EQ(k, v);
+        }
+    }
+
+    TEST(FlatHashMapTest, NonTrivialTypes)
+    {
+        apus::flat_hash_map<std::string, std::unique_ptr<int>> m;
+        for (int i = 0; i < 100; ++i) {
+            m.try_emplace(std::to_string(i), std::make_unique<int>(i));
+        }
+        EXPECT_EQ(*m.at("42"), 42);
+        m.erase("42");
+        EXPECT_FALSE(m.contains("42"));
+
+        auto m2 = std::move(m);
+        EXPECT_EQ(m2.size(), 99);
+        EXPECT_EQ(m.size(), 0);
+        EXPECT_EQ(*m2.at("7"), 7);
+    }
+
+    TEST(FlatHashMapTest, CopySupport)
+    {
+        apus::flat_hash_map<std::string, int> m;
+        m["a"] = 1;
+        m["b"] = 2;
+
+        apus::flat_hash_map<std::string, int> m2 = m;
+        m2["c"] = 3;
+        EXPECT_EQ(m.size(), 2);
+        EXPECT_EQ(m2.size(), 3);
+        EXPECT_EQ(m2.at("a"), 1);
+
+        apus::flat_hash_map<std::string, int> m3;
+        m3 = m2;
+        EXPECT_EQ(m3.size(), 3);
+        EXPECT_EQ(m3.at("c"), 3);
+    }
+
+    TEST(FlatHashMapTest, HeterogeneousLookup)
+    {
+        apus::flat_hash_map<std::string, int, string_hash, string_equal> m;
+        m["alpha"] = 1;
+        m["beta"]  = 2;
+
+        std::string_view key = "beta";
+        auto             it  = m.find(key);
+        ASSERT_NE(it, m.end());
+        EXPECT_EQ(it->second, 2);
+        EXPECT_TRUE(m.contains(std::string_view("alpha")));
+        EXPECT_FALSE(m.contains(std::string_view("gamma")));
+    }
+
+    TEST(FlatHashMapTest, BulkReserveAndInsert)
+    {
+        std::vector<std::pair<int, int>> items;
+        for (int i = 0; i < 500; ++i) items.emplace_back(i, -i);
+
+        apus::flat_hash_map<int, int> m;
+        m.reserve(500);
+        std::size_t capacity = m.capacity();
+        EXPECT_GE(capacity * 7 / 8, 500);
+
+        m.insert(items.begin(), items.end());
+        EXPECT_EQ(m.size(), 500);
+        EXPECT_EQ(m.capacity(), capacity);
+        EXPECT_EQ(m.at(499), -499);
+
+        m.clear();
+        EXPECT_TRUE(m.empty());
+        EXPECT_EQ(m.capacity(), capacity);
+        EXPECT_FALSE(m.contains(1));
+    }
+
+    TEST(FlatHashMapTest, CacheAlignedArenaStorage)
+    {
+        apus::memory_arena<64 * 1024> arena;
+        apus::flat_hash_map<int, int> m(arena.resource());
+        for (int i = 0; i < 100; ++i) m[i] = i;
+
+        const auto& first = *m.begin();
+        auto*       base  = arena.get_base_address<char>();
+        EXPECT_GE(reinterpret_cast<const char*>(&first), base);
+        EXPECT_LT(reinterpret_cast<const char*>(&first), base + 64 * 1024);
+        EXPECT_EQ(m.resource(), arena.resource());
+        EXPECT_EQ(m.at(99), 99);
+    }
+
+    TEST(FlatHashMapTest, NoAllocationAfterReserve)
+    {
+        apus::flat_hash_map<int, int> m;
+        m.reserve(100);
+        APUS_EXPECT_NO_ALLOC({
+            for (int i = 0; i < 100; ++i) m.insert({i, i});
+            for (int i = 0; i < 100; ++i) EXPECT_NE(m.find(i), m.end());
+            m.erase(5);
+        });
+        EXPECT_EQ(m.size(), 99);
+    }
+
+} // namespace
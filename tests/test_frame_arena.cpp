@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <apus/frame_arena.hpp>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
+
+namespace
+{
+
+    TEST(FrameArenaTest, FrameReusesTheArenaOfFramesAgo)
+    {
+        apus::frame_arena<3, 1024> arena;
+        int*                       data[3];
+        for (std::uint64_t n = 0; n < 3; ++n) {
+            arena.begin_frame(n);
+            data[n]  = arena.allocate<int>();
+            *data[n] = static_cast<int>(n);
+        }
+        EXPECT_EQ(arena.current_frame(), 2);
+
+        // frame 3 takes over frame 0's arena; frames 1 and 2 are untouched
+        arena.begin_frame(3);
+        EXPECT_EQ(arena.allocate<int>(), data[0]);
+        EXPECT_EQ(*data[1], 1);
+        EXPECT_EQ(*data[2], 2);
+        EXPECT_EQ(&arena.arena_of(3), &arena.arena_of(0));
+        EXPECT_EQ(&arena.current_arena(), &arena.arena_of(3));
+    }
+
+    TEST(FrameArenaTest, ResetTrimsFramesToOnePage)
+    {
+        apus::frame_arena<2, 1024> arena;
+        arena.begin_frame(0);
+        for (int i = 0; i < 10; ++i) arena.allocate(512);
+        arena.begin_frame(1);
+        arena.allocate(64);
+        EXPECT_EQ(arena.page_count(), 5 + 1);
+        EXPECT_EQ(arena.used_bytes(), 10 * 512 + 64);
+
+        arena.begin_frame(2);
+        EXPECT_EQ(arena.page_count(), 1 + 1);
+        EXPECT_EQ(arena.used_bytes(), 64);
+        EXPECT_EQ(arena.allocate(2048), nullptr); // larger than a page
+    }
+
+    TEST(FrameArenaTest, FramesMustIncrease)
+    {
+        apus::frame_arena<2, 1024> arena;
+        arena.begin_frame(5);
+        APUS_EXPECT_ERROR(arena.begin_frame(5), std::logic_error);
+        APUS_EXPECT_ERROR(arena.begin_frame(4), std::logic_error);
+        arena.begin_frame(9); // skipping frames is fine
+        EXPECT_EQ(arena.current_frame(), 9);
+    }
+
+    TEST(FrameArenaTest, TryBeginFrameWaitsForRetirement)
+    {
+        apus::frame_arena<2, 1024> arena;
+        EXPECT_TRUE(arena.try_begin_frame(0));
+        EXPECT_TRUE(arena.try_begin_frame(1));
+        EXPECT_FALSE(arena.try_begin_frame(2)); // frame 0 still in use
+        EXPECT_EQ(arena.current_frame(), 1);
+
+        arena.retire(0);
+        EXPECT_TRUE(arena.try_begin_frame(2));
+        EXPECT_FALSE(arena.try_begin_frame(3));
+        arena.retire(1);
+        EXPECT_TRUE(arena.try_begin_frame(3));
+    }
+
+    TEST(FrameArenaTest, SteadyStateDoesNotAllocate)
+    {
+        apus::frame_arena<3, 4096> arena;
+        for (std::uint64_t n = 0; n < 3; ++n) {
+            arena.begin_frame(n);
+            arena.allocate(1024);
+        }
+        APUS_EXPECT_NO_ALLOC({
+            for (std::uint64_t n = 3; n < 100; ++n) {
+                arena.begin_frame(n);
+                for (int i = 0; i < 4; ++i) arena.allocate(1000);
+            }
+        });
+    }
+
+    TEST(FrameArenaTest, CrossThreadPipeline)
+    {
+        constexpr std::uint64_t frames = 2000;
+        constexpr int           values = 64;
+
+        apus::frame_arena<3, 1024> arena;
+        std::mutex                 mutex;
+        std::deque<std::uint64_t*> handed; // frames in flight, oldest first
+        std::atomic<bool>          corrupted{false};
+
+        std::thread consumer([&] {
+            for (std::uint64_t n = 0; n < frames; ++n) {
+                std::uint64_t* data = nullptr;
+                while (data == nullptr) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!handed.empty()) {
+                        data = handed.front();
+                        handed.pop_front();
+                    }
+                }
+                for (int i = 0; i < values; ++i) {
+                    if (data[i] != n * values + i) corrupted = true;
+                }
+                arena.retire(n);
+            }
+        });
+
+        for (std::uint64_t n = 0; n < frames; ++n) {
+            while (!arena.try_begin_frame(n)) std::this_thread::yield();
+            std::uint64_t* data = arena.allocate<std::uint64_t>(values);
+            for (int i = 0; i < values; ++i) data[i] = n * values + i;
+            std::lock_guard<std::mutex> lock(mutex);
+            handed.push_back(data);
+        }
+        consumer.join();
+        EXPECT_FALSE(corrupted.load());
+    }
+
+} // namespace
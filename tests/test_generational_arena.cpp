@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <apus/generational_arena.hpp>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include "alloc_counter.hpp"
+
+namespace
+{
+
+    struct point
+    {
+        int x;
+        int y;
+    };
+
+    // a message whose text lives in the nursery next to it
+    struct message
+    {
+        const char* text;
+        std::size_t length;
+    };
+
+    using arena_type = apus::generational_arena<1024>;
+
+    message* make_message(arena_type& arena, const char* text)
+    {
+        std::size_t length = std::strlen(text);
+        char*       copy   = static_cast<char*>(arena.allocate(length, 1));
+        std::memcpy(copy, text, length);
+        return arena.construct<message>(message{copy, length});
+    }
+
+    TEST(GenerationalArenaTest, PromotedObjectsSurviveReset)
+    {
+        arena_type arena;
+        point*     kept = arena.construct<point>(point{1, 2});
+        point*     temp = arena.construct<point>(point{3, 4});
+        point*     also = arena.construct<point>(point{5, 6});
+        arena.promote(kept);
+        arena.promote(also);
+        EXPECT_EQ(arena.survivor_count(), 2);
+
+        point* before = kept;
+        arena.reset();
+        EXPECT_NE(kept, before);
+        EXPECT_EQ(kept->x, 1);
+        EXPECT_EQ(kept->y, 2);
+        EXPECT_EQ(also->x, 5);
+        EXPECT_EQ(arena.old_generation().used_bytes(), 2 * sizeof(point));
+        EXPECT_EQ(arena.survivor_count(), 0);
+        EXPECT_EQ(arena.promoted_count(), 2);
+
+        // the nursery is reused from the start; temp's memory is handed out again
+        EXPECT_EQ(arena.construct<point>(point{7, 8}), before);
+        (void)temp;
+    }
+
+    TEST(GenerationalArenaTest, NurseryIsResetWholesale)
+    {
+        arena_type arena;
+        for (int i = 0; i < 200; ++i) arena.construct<point>(point{i, i});
+        EXPECT_GT(arena.nursery().page_count(), 1);
+
+        arena.reset();
+        EXPECT_EQ(arena.nursery().page_count(), 1);
+        EXPECT_EQ(arena.nursery().used_bytes(), 0);
+        EXPECT_EQ(arena.old_generation().used_bytes(), 0);
+    }
+
+    TEST(GenerationalArenaTest, RelocateHookCopiesNurseryData)
+    {
+        arena_type arena;
+        message*   greeting = make_message(arena, "hello session");
+        make_message(arena, "dropped with the request");
+
+        arena.promote(greeting, [](message& from, arena_type::arena_type& old) {
+            char* text = static_cast<char*>(old.allocate(from.length, 1));
+            std::memcpy(text, from.text, from.length);
+            return new (old.allocate(sizeof(message), alignof(message))) message{text, from.length};
+        });
+        arena.reset();
+
+        // overwrite the old nursery contents
+        std::memset(arena.allocate(512), 0, 512);
+
+        EXPECT_EQ(arena.old_generation().used_bytes(), 13 + 3 + sizeof(message)); // text, padding, message
+        EXPECT_EQ(std::string(greeting->text, greeting->length), "hello session");
+    }
+
+    TEST(GenerationalArenaTest, ForwardingIsReportedInPromotionOrder)
+    {
+        arena_type arena;
+        point*     a = arena.construct<point>(point{1, 1});
+        point*     b = arena.construct<point>(point{2, 2});
+        arena.promote(b);
+        arena.promote(a);
+
+        const void* old_a = a;
+        const void* old_b = b;
+
+        std::vector<std::pair<const void*, void*>> forwarded;
+        arena.reset([&](const void* from, void* to) { forwarded.emplace_back(from, to); });
+
+        ASSERT_EQ(forwarded.size(), 2);
+        EXPECT_EQ(forwarded[0].first, old_b);
+        EXPECT_EQ(forwarded[0].second, b);
+        EXPECT_EQ(forwarded[1].first, old_a);
+        EXPECT_EQ(forwarded[1].second, a);
+    }
+
+#if APUS_EXCEPTIONS
+    TEST(GenerationalArenaTest, ThrowingHookLeavesRemainingSurvivorsRegistered)
+    {
+        arena_type arena;
+        point*     first          = arena.construct<point>(point{1, 1});
+        point*     second         = arena.construct<point>(point{2, 2});
+        point*     third          = arena.construct<point>(point{3, 3});
+        point*     nursery_second = second;
+        arena.promote(first);
+        arena.promote(second, [](point&, arena_type::arena_type&) -> point* { throw std::runtime_error("relocate"); });
+        arena.promote(third);
+
+        EXPECT_THROW(arena.reset(), std::runtime_error);
+        EXPECT_EQ(arena.promoted_count(), 1);
+        EXPECT_EQ(arena.survivor_count(), 1);
+        EXPECT_EQ(second, nursery_second); // dropped, still in the untouched nursery
+        EXPECT_EQ(second->x, 2);
+
+        // the next reset relocates only the survivor that was not reached
+        arena.reset();
+        EXPECT_EQ(arena.promoted_count(), 2);
+        EXPECT_EQ(arena.old_generation().used_bytes(), 2 * sizeof(point));
+        EXPECT_EQ(first->x, 1);
+        EXPECT_EQ(third->x, 3);
+    }
+#endif
+
+    TEST(GenerationalArenaTest, ClearDropsBothGenerations)
+    {
+        arena_type arena;
+        point*     kept = arena.construct<point>(point{1, 2});
+        arena.promote(kept);
+        arena.reset();
+        EXPECT_GT(arena.old_generation().used_bytes(), 0);
+
+        point* pending = arena.construct<point>(point{3, 4});
+        arena.promote(pending);
+        arena.clear();
+        EXPECT_EQ(arena.survivor_count(), 0);
+        EXPECT_EQ(arena.promoted_count(), 1);
+        EXPECT_EQ(arena.nursery().used_bytes(), 0);
+        EXPECT_EQ(arena.old_generation().used_bytes(), 0);
+    }
+
+    TEST(GenerationalArenaTest, RequestsDoNotAllocate)
+    {
+        apus::generational_arena<4096> arena;
+        std::vector<point*>            session(50);
+
+        APUS_EXPECT_NO_ALLOC({
+            for (std::size_t request = 0; request < session.size(); ++request) {
+                for (int i = 0; i < 100; ++i) arena.construct<point>(point{i, i});
+                session[request] = arena.construct<point>(point{static_cast<int>(request), 0});
+                arena.promote(session[request]);
+                arena.reset();
+            }
+        });
+        for (std::size_t request = 0; request < session.size(); ++request) {
+            EXPECT_EQ(session[request]->x, static_cast<int>(request));
+        }
+    }
+
+} // namespace
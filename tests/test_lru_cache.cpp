@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <apus/lru_cache.hpp>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
+
+namespace
+{
+
+    std::vector<int> keys_by_recency(apus::lru_cache<int, int>& cache)
+    {
+        std::vector<int> keys;
+        cache.for_each([&](const int& key, int&) { keys.push_back(key); });
+        return keys;
+    }
+
+    TEST(LruCacheTest, GetAndPut)
+    {
+        apus::lru_cache<std::string, int> cache(2);
+        EXPECT_EQ(cache.get("a"), nullptr);
+
+        cache.put("a", 1);
+        cache.put("b", 2);
+        ASSERT_NE(cache.get("a"), nullptr);
+        EXPECT_EQ(*cache.get("a"), 1);
+
+        // b is the least recently used
+        cache.put("c", 3);
+        EXPECT_FALSE(cache.contains("b"));
+        EXPECT_TRUE(cache.contains("a"));
+        EXPECT_TRUE(cache.contains("c"));
+        EXPECT_EQ(cache.size(), 2);
+    }
+
+    TEST(LruCacheTest, PutReplacesValue)
+    {
+        apus::lru_cache<int, int> cache(2);
+        cache.put(1, 10);
+        cache.put(2, 20);
+        cache.put(1, 11);
+        EXPECT_EQ(cache.size(), 2);
+        EXPECT_EQ(*cache.peek(1), 11);
+
+        // replacing made 1 the most recent
+        cache.put(3, 30);
+        EXPECT_FALSE(cache.contains(2));
+        EXPECT_EQ(keys_by_recency(cache), (std::vector<int>{3, 1}));
+    }
+
+    TEST(LruCacheTest, PeekDoesNotPromote)
+    {
+        apus::lru_cache<int, int> cache(2);
+        cache.put(1, 10);
+        cache.put(2, 20);
+        EXPECT_EQ(*cache.peek(1), 10);
+        cache.put(3, 30);
+        EXPECT_FALSE(cache.contains(1));
+    }
+
+    TEST(LruCacheTest, EraseAndClear)
+    {
+        apus::lru_cache<int, int> cache(4);
+        for (int i = 0; i < 4; ++i) cache.put(i, i);
+        cache.get(2);
+
+        EXPECT_TRUE(cache.erase(2));
+        EXPECT_FALSE(cache.erase(2));
+        EXPECT_EQ(keys_by_recency(cache), (std::vector<int>{3, 1, 0}));
+
+        cache.clear();
+        EXPECT_TRUE(cache.empty());
+        EXPECT_EQ(cache.weight(), 0);
+        cache.put(7, 7);
+        EXPECT_EQ(keys_by_recency(cache), (std::vector<int>{7}));
+    }
+
+    TEST(LruCacheTest, WeightedEviction)
+    {
+        apus::lru_cache<int, std::string> cache(10);
+        cache.put(1, "a", 4);
+        cache.put(2, "b", 4);
+        EXPECT_EQ(cache.weight(), 8);
+
+        cache.put(3, "c", 5);
+        EXPECT_FALSE(cache.contains(1));
+        EXPECT_EQ(cache.weight(), 9);
+
+        cache.put(4, "d", 10);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_EQ(cache.weight(), 10);
+
+        APUS_EXPECT_ERROR(cache.put(5, "e", 11), std::length_error);
+
+        cache.set_capacity(5);
+        EXPECT_TRUE(cache.empty());
+    }
+
+    TEST(LruCacheTest, TryPut)
+    {
+        apus::lru_cache<int, std::string> cache(10);
+        cache.put(1, "a", 4);
+
+        EXPECT_EQ(cache.try_put(2, "b", 11), nullptr);
+        EXPECT_FALSE(cache.contains(2));
+        EXPECT_EQ(cache.weight(), 4);
+
+        ASSERT_NE(cache.try_put(2, "b", 6), nullptr);
+        EXPECT_EQ(*cache.try_put(2, "c", 6), "c");
+        EXPECT_EQ(cache.weight(), 10);
+    }
+
+    TEST(LruCacheTest, MatchesReferenceLru)
+    {
+        // std::list + std::unordered_map reference; hits cross many promotion batches
+        apus::lru_cache<int, int>                               cache(64);
+        std::list<int>                                          order;
+        std::unordered_map<int, std::list<int>::iterator>       where;
+        std::mt19937                                            rng(3);
+
+        for (int step = 0; step < 100000; ++step) {
+            int key = static_cast<int>(rng() % 128);
+            if (rng() % 2) {
+                int* value = cache.get(key);
+                auto it    = where.find(key);
+                ASSERT_EQ(value != nullptr, it != where.end());
+                if (value) {
+                    EXPECT_EQ(*value, key);
+                    order.splice(order.begin(), order, it->second);
+                }
+            } else {
+                cache.put(key, key);
+                auto it = where.find(key);
+                if (it != where.end()) {
+                    order.splice(order.begin(), order, it->second);
+                } else {
+                    if (order.size() == 64) {
+                        where.erase(order.back());
+                        order.pop_back();
+                    }
+                    order.push_front(key);
+                    where[key] = order.begin();
+                }
+            }
+        }
+        EXPECT_EQ(keys_by_recency(cache), std::vector<int>(order.begin(), order.end()));
+    }
+
+    TEST(LruCacheTest, ClockGivesSecondChance)
+    {
+        apus::lru_cache<int, int> cache(3, apus::lru_cache_policy::clock);
+        cache.put(1, 1);
+        cache.put(2, 2);
+        cache.put(3, 3);
+
+        // 1 is the oldest but referenced, so 2 is evicted instead
+        cache.get(1);
+        cache.put(4, 4);
+        EXPECT_TRUE(cache.contains(1));
+        EXPECT_FALSE(cache.contains(2));
+
+        // the reference bit was consumed: 1 is next in line behind 3
+        cache.put(5, 5);
+        EXPECT_FALSE(cache.contains(3));
+        cache.put(6, 6);
+        EXPECT_FALSE(cache.contains(1));
+    }
+
+    TEST(LruCacheTest, KeysAreStoredOnce)
+    {
+        auto key = [](int i) { return std::string(64, 'k') + std::to_string(i); };
+
+        apus::lru_cache<std::string, int> cache(32);
+        for (int i = 0; i < 32; ++i) cache.put(key(i), i);
+        cache.clear();
+
+        // with the slots and the index already sized, each new entry copies its key once
+        std::vector<std::string> keys;
+        for (int i = 0; i < 32; ++i) keys.push_back(key(i));
+        apus_testing::alloc_scope scope;
+        for (int i = 0; i < 32; ++i) cache.put(keys[i], i);
+        EXPECT_EQ(scope.allocations(), 32);
+
+        for (int i = 0; i < 32; ++i) EXPECT_EQ(*cache.peek(keys[i]), i);
+    }
+
+    TEST(LruCacheTest, HitsDoNotAllocate)
+    {
+        apus::lru_cache<int, int> cache(64);
+        for (int i = 0; i < 64; ++i) cache.put(i, i);
+        APUS_EXPECT_NO_ALLOC({
+            for (int round = 0; round < 4; ++round) {
+                for (int i = 0; i < 64; ++i) EXPECT_NE(cache.get(i), nullptr);
+            }
+        });
+    }
+
+} // namespace
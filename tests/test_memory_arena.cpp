@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include <apus/memory_arena.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/stats_registry.hpp>
+#include <vector>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
 
 TEST(MemoryArenaTest, Allocation) {
     constexpr std::size_t arena_size = 1024;
@@ -50,3 +55,109 @@ TEST(MemoryArenaTest, TypedAllocation) {
     EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p_large) % 64, 0);
     arena.deallocate(p_large);
 }
+
+TEST(MemoryArenaTest, UsageCounters) {
+    apus::memory_arena<1024> arena;
+    EXPECT_EQ(arena.used_bytes(), 0);
+    EXPECT_EQ(arena.remaining_bytes(), 1024);
+
+    arena.allocate(100, 1);
+    EXPECT_EQ(arena.used_bytes(), 100);
+    EXPECT_EQ(arena.remaining_bytes(), 924);
+
+    // 100 -> next multiple of 16 is 112 (the buffer is max_align_t aligned)
+    arena.allocate(8, 16);
+    EXPECT_EQ(arena.used_bytes(), 120);
+
+    APUS_EXPECT_ERROR(arena.allocate(1000), std::bad_alloc);
+    EXPECT_EQ(arena.used_bytes(), 120);
+
+    arena.reset();
+    EXPECT_EQ(arena.used_bytes(), 0);
+    arena.allocate(10, 1);
+    EXPECT_EQ(arena.high_water_mark(), 120);
+}
+
+TEST(MemoryArenaTest, TryAllocate) {
+    apus::memory_arena<128> arena;
+
+    EXPECT_NE(arena.try_allocate(100), nullptr);
+    EXPECT_EQ(arena.try_allocate(100), nullptr);
+    EXPECT_EQ(arena.used_bytes(), 100);
+    EXPECT_NE(arena.try_allocate(28, 1), nullptr);
+    EXPECT_EQ(arena.remaining_bytes(), 0);
+}
+
+static std::size_t failed_allocation_bytes = 0;
+
+static void record_failed_allocation(std::size_t bytes) {
+    failed_allocation_bytes = bytes;
+}
+
+TEST(MemoryArenaTest, AllocFailureHandler) {
+    apus::memory_arena<64> arena;
+    apus::alloc_failure_handler previous = apus::set_alloc_failure_handler(record_failed_allocation);
+    EXPECT_EQ(apus::get_alloc_failure_handler(), &record_failed_allocation);
+
+    // try_allocate reports failure itself and leaves the handler alone
+    failed_allocation_bytes = 0;
+    EXPECT_EQ(arena.try_allocate(100), nullptr);
+    EXPECT_EQ(failed_allocation_bytes, 0);
+
+#if APUS_EXCEPTIONS
+    EXPECT_THROW(arena.allocate(100), std::bad_alloc);
+    EXPECT_EQ(failed_allocation_bytes, 100);
+#else
+    EXPECT_DEATH(arena.allocate(100), "apus: failed to allocate 100 bytes");
+#endif
+
+    apus::set_alloc_failure_handler(previous);
+}
+
+TEST(MemoryArenaTest, PaddingAndSizeHistogram) {
+    apus::memory_arena<1024, apus::counting_stats<void, true>> arena;
+
+    arena.allocate(1, 1);
+    arena.allocate(3, 1);
+    arena.allocate(8, 8);    // 4 bytes of padding after offset 4
+    arena.allocate(100, 64); // padding up to the next 64-byte boundary
+
+    EXPECT_EQ(arena.stats().count(apus::stats_event::allocation), 4);
+    EXPECT_EQ(arena.alignment_padding_bytes(), arena.used_bytes() - 112);
+    EXPECT_GE(arena.alignment_padding_bytes(), 4);
+
+    EXPECT_EQ(arena.stats().size_histogram(apus::stats_size_bucket(1)), 1);
+    EXPECT_EQ(arena.stats().size_histogram(apus::stats_size_bucket(3)), 1);
+    EXPECT_EQ(arena.stats().size_histogram(apus::stats_size_bucket(100)), 1);
+    EXPECT_EQ(apus::stats_size_bucket(0), 0);
+    EXPECT_EQ(apus::stats_size_bucket(1), 1);
+    EXPECT_EQ(apus::stats_size_bucket(8), 4);
+}
+
+TEST(MemoryArenaTest, PaddingIsZeroWithoutCountingStats) {
+    apus::memory_arena<1024> arena;
+    arena.allocate(1, 1);
+    arena.allocate(8, 8);
+    EXPECT_EQ(arena.alignment_padding_bytes(), 0);
+
+    apus::paged_memory_arena<1024> paged;
+    paged.allocate(1, 1);
+    paged.allocate(8, 8);
+    EXPECT_EQ(paged.alignment_padding_bytes(), 0);
+}
+
+TEST(MemoryArenaTest, ResourceAllocationsAreAccounted) {
+    apus::memory_arena<1024> arena;
+    std::pmr::vector<int>    values(arena.resource());
+    values.reserve(16);
+    EXPECT_GE(arena.used_bytes(), 16 * sizeof(int));
+}
+
+TEST(MemoryArenaTest, AllocationDoesNotTouchTheHeap) {
+    apus::memory_arena<4096> arena;
+    APUS_EXPECT_NO_ALLOC({
+        for (int i = 0; i < 32; ++i) EXPECT_NE(arena.allocate(64), nullptr);
+        arena.reset();
+        EXPECT_NE(arena.allocate(64), nullptr);
+    });
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <apus/numa_page_source.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/typed_memory_arena.hpp>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+
+    constexpr std::size_t page_size = 16 * 1024;
+
+    using numa_paged_arena = apus::paged_memory_arena<page_size, apus::null_stats, apus::numa_page_source>;
+    using numa_typed_arena = apus::typed_memory_arena<std::uint64_t, 2048, apus::null_stats, apus::numa_page_source>;
+
+    TEST(NumaPageSourceTest, NodeQueries)
+    {
+        const int nodes = apus::numa_page_source::node_count();
+        EXPECT_GE(nodes, 1);
+        EXPECT_LE(nodes, apus::NUMA_MAX_NODES);
+
+        const int current = apus::numa_page_source::current_node();
+        EXPECT_GE(current, 0);
+        EXPECT_LT(current, nodes);
+        EXPECT_EQ(apus::numa_page_source().node(), current);
+
+        // nodes the machine does not have fall back to node 0
+        EXPECT_EQ(apus::numa_page_source(nodes - 1).node(), nodes - 1);
+        EXPECT_EQ(apus::numa_page_source(nodes).node(), 0);
+        EXPECT_EQ(apus::numa_page_source(-1).node(), 0);
+    }
+
+    TEST(NumaPageSourceTest, PagedArenaPlacesPagesOnNode)
+    {
+        const int        node = apus::numa_page_source::node_count() - 1;
+        numa_paged_arena arena(apus::numa_page_source{node});
+        EXPECT_EQ(arena.page_source().node(), node);
+
+        for (int i = 0; i < 8; ++i) {
+            void* p = arena.allocate(page_size / 2);
+            ASSERT_NE(p, nullptr);
+            std::memset(p, i, page_size / 2);
+
+            // -1 when the kernel does not report placement, e.g. under a seccomp filter
+            const int placed = apus::numa_page_source::node_of(p);
+            if (placed != -1) {
+                EXPECT_EQ(placed, node);
+            }
+        }
+        EXPECT_EQ(arena.page_count(), 4);
+    }
+
+    TEST(NumaPageSourceTest, FreedPagesArePooledPerNode)
+    {
+        apus::numa_page_source::trim();
+        const int node = apus::numa_page_source::node_count() - 1;
+        {
+            numa_typed_arena arena(apus::numa_page_source{node});
+            for (int i = 0; i < 3 * 2048; ++i) *arena.allocate().ptr = static_cast<std::uint64_t>(i);
+        }
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(node), 3);
+
+        // a new arena on the same node takes its pages from the pool
+        numa_typed_arena reuse(apus::numa_page_source{node});
+        for (int i = 0; i < 2 * 2048; ++i) reuse.allocate();
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(node), 1);
+
+        // pages follow a moved arena and still go back to their node
+        numa_typed_arena moved(std::move(reuse));
+        moved.allocate();
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(node), 0);
+        moved = numa_typed_arena(apus::numa_page_source{node});
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(node), 3);
+
+        EXPECT_EQ(apus::numa_page_source::trim(), 3);
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(node), 0);
+    }
+
+    TEST(NumaPageSourceTest, ResetReturnsPagesToThePool)
+    {
+        apus::numa_page_source::trim();
+        numa_paged_arena arena(apus::numa_page_source{0});
+        for (int i = 0; i < 4; ++i) arena.allocate(page_size);
+        EXPECT_EQ(arena.page_count(), 4);
+
+        arena.reset();
+        EXPECT_EQ(arena.page_count(), 1);
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(0), 3);
+
+        // refilling the arena does not map new pages
+        for (int i = 0; i < 3; ++i) arena.allocate(page_size);
+        EXPECT_EQ(apus::numa_page_source::pooled_pages(0), 1);
+        apus::numa_page_source::trim();
+    }
+
+} // namespace
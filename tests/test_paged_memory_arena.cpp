@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <apus/paged_memory_arena.hpp>
+#include <apus/stats_registry.hpp>
 #include <cmath>
+#include "alloc_counter.hpp"
 
 TEST(PagedMemoryArenaTest, SimpleAllocation) {
     constexpr std::size_t page_size = 1024;
@@ -34,6 +36,17 @@ TEST(PagedMemoryArenaTest, OversizedAllocation) {
     EXPECT_EQ(p, nullptr);
 }
 
+TEST(PagedMemoryArenaTest, TryAllocate) {
+    constexpr std::size_t page_size = 1024;
+    apus::paged_memory_arena<page_size> arena;
+
+    EXPECT_EQ(arena.try_allocate(page_size + 1), nullptr);
+    EXPECT_NE(arena.try_allocate(800), nullptr);
+    EXPECT_NE(arena.try_allocate(800), nullptr); // opens a second page
+    EXPECT_EQ(arena.page_count(), 2);
+    EXPECT_EQ(arena.used_bytes(), 1600);
+}
+
 TEST(PagedMemoryArenaTest, TypedAllocationAndReset) {
     constexpr std::size_t page_size = 1024;
     apus::paged_memory_arena<page_size> arena;
@@ -46,3 +59,38 @@ TEST(PagedMemoryArenaTest, TypedAllocationAndReset) {
     int* p_int2 = arena.allocate<int>(100);
     EXPECT_NE(p_int2, nullptr);
 }
+
+TEST(PagedMemoryArenaTest, UsageCounters) {
+    constexpr std::size_t page_size = 1024;
+    apus::paged_memory_arena<page_size, apus::counting_stats<>> arena;
+    EXPECT_EQ(arena.page_count(), 1);
+    EXPECT_EQ(arena.used_bytes(), 0);
+
+    for (int i = 0; i < 5; ++i) {
+        arena.allocate(300, 1);
+    }
+    // three allocations fit a page, so two pages hold 900 + 600 bytes
+    EXPECT_EQ(arena.page_count(), 2);
+    EXPECT_EQ(arena.used_bytes(), 1500);
+    EXPECT_EQ(arena.remaining_bytes(), 424);
+    EXPECT_EQ(arena.alignment_padding_bytes(), 0);
+    EXPECT_EQ(arena.stats().count(apus::stats_event::page_allocation), 2);
+
+    arena.allocate(4, 1);
+    arena.allocate(8, 8);
+    EXPECT_EQ(arena.alignment_padding_bytes(), 4);
+
+    arena.reset();
+    EXPECT_EQ(arena.page_count(), 1);
+    EXPECT_EQ(arena.used_bytes(), 0);
+    EXPECT_EQ(arena.high_water_mark(), 1516);
+}
+
+TEST(PagedMemoryArenaTest, NoAllocationWithinAPage) {
+    apus::paged_memory_arena<4096> arena;
+    APUS_EXPECT_NO_ALLOC({
+        for (int i = 0; i < 32; ++i) EXPECT_NE(arena.allocate(64), nullptr);
+        arena.reset();
+        for (int i = 0; i < 32; ++i) EXPECT_NE(arena.allocate(64), nullptr);
+    });
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <apus/per_thread.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    TEST(PerThreadTest, EachThreadGetsItsOwnValue)
+    {
+        apus::per_thread<int> values;
+        EXPECT_TRUE(values.empty());
+
+        values.local() = 1;
+        std::atomic<int>         arrived{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            // threads stay alive until all have a value, so none reuses another's index
+            threads.emplace_back([&] {
+                int& mine = values.local();
+                EXPECT_EQ(mine, 0);
+                mine += 10;
+                EXPECT_EQ(&values.local(), &mine);
+                arrived.fetch_add(1);
+                while (arrived.load() < 4) std::this_thread::yield();
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        EXPECT_EQ(values.size(), 5);
+        EXPECT_EQ(values.local(), 1);
+        EXPECT_EQ(values.combine(std::plus<>()), 41);
+    }
+
+    TEST(PerThreadTest, ValuesAreConstructedLazilyByFactory)
+    {
+        std::atomic<int>                   calls{0};
+        apus::per_thread<std::vector<int>> caches([&calls] {
+            calls.fetch_add(1);
+            return std::vector<int>(3, 7);
+        });
+        EXPECT_EQ(calls.load(), 0);
+
+        EXPECT_EQ(caches.local().size(), 3);
+        caches.local().push_back(8);
+        EXPECT_EQ(calls.load(), 1);
+
+        std::thread([&caches] { caches.local().clear(); }).join();
+        EXPECT_EQ(calls.load(), 2);
+
+        std::size_t total = caches.reduce(std::size_t(0), [](std::size_t n, const std::vector<int>& v) { return n + v.size(); });
+        EXPECT_EQ(total, 4);
+    }
+
+    TEST(PerThreadTest, SlotsDoNotShareCacheLines)
+    {
+        apus::per_thread<std::uint64_t> counters;
+        std::vector<std::uintptr_t>     addresses(8);
+        std::atomic<std::size_t>        arrived{0};
+        std::vector<std::thread>        threads;
+        for (std::size_t t = 0; t < addresses.size(); ++t) {
+            threads.emplace_back([&, t] {
+                addresses[t] = reinterpret_cast<std::uintptr_t>(&counters.local());
+                arrived.fetch_add(1);
+                while (arrived.load() < addresses.size()) std::this_thread::yield();
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        for (std::size_t i = 0; i < addresses.size(); ++i) {
+            EXPECT_EQ(addresses[i] % 64, 0);
+            for (std::size_t j = 0; j < i; ++j) EXPECT_NE(addresses[i] / 64, addresses[j] / 64);
+        }
+    }
+
+    TEST(PerThreadTest, AtomicCountersCanBeReadWhileUpdated)
+    {
+        apus::per_thread<std::atomic<std::uint64_t>> counters;
+        std::atomic<bool>                            go{false};
+        std::vector<std::thread>                     threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                auto& counter = counters.local();
+                while (!go.load()) std::this_thread::yield();
+                for (int i = 0; i < 10000; ++i) {
+                    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        auto sum = [&] {
+            return counters.reduce(std::uint64_t(0), [](std::uint64_t n, const std::atomic<std::uint64_t>& c) {
+                return n + c.load(std::memory_order_relaxed);
+            });
+        };
+        go = true;
+        EXPECT_LE(sum(), 40000);
+        for (auto& t : threads) t.join();
+        EXPECT_EQ(sum(), 40000);
+    }
+
+    TEST(PerThreadTest, ExitedThreadIndicesAreReused)
+    {
+        apus::per_thread<int, 2, 8> counts;
+        std::size_t                 first  = 0;
+        std::size_t                 second = 0;
+        std::thread([&] {
+            first = apus::this_thread_index();
+            ++counts.local();
+        }).join();
+        std::thread([&] {
+            second = apus::this_thread_index();
+            ++counts.local();
+        }).join();
+
+        // the second thread took over the first one's index, and its value
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(counts.size(), 1);
+        EXPECT_EQ(counts.combine(std::plus<>()), 2);
+    }
+
+    TEST(PerThreadTest, ManyThreadsSpanPages)
+    {
+        apus::per_thread<int, 2, 8> values;
+        std::atomic<int>            arrived{0};
+        std::vector<std::thread>    threads;
+        for (int t = 0; t < 9; ++t) {
+            threads.emplace_back([&, t] {
+                values.local() = t;
+                arrived.fetch_add(1);
+                while (arrived.load() < 9) std::this_thread::yield();
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        EXPECT_EQ(values.size(), 9);
+        EXPECT_EQ(values.combine(std::plus<>()), 36);
+        EXPECT_EQ(decltype(values)::capacity(), 16);
+    }
+
+    TEST(PerThreadTest, ClearDestroysValues)
+    {
+        struct tracked
+        {
+            int* destroyed;
+            ~tracked() { ++*destroyed; }
+        };
+
+        int destroyed = 0;
+        {
+            apus::per_thread<tracked> values([&destroyed] { return tracked{&destroyed}; });
+            values.local();
+            std::thread([&] { values.local(); }).join();
+            EXPECT_EQ(destroyed, 0);
+
+            values.clear();
+            EXPECT_EQ(destroyed, 2);
+            EXPECT_TRUE(values.empty());
+
+            values.local();
+            EXPECT_EQ(values.size(), 1);
+        }
+        EXPECT_EQ(destroyed, 3);
+    }
+
+#if APUS_EXCEPTIONS
+    TEST(PerThreadTest, ThreadIndexBeyondCapacity)
+    {
+        apus::per_thread<int, 1, 1> tiny;
+        const std::size_t           main_index = apus::this_thread_index();
+
+        // while this thread lives, another thread holds a different index
+        std::thread([&] {
+            if (main_index == 0) {
+                EXPECT_THROW(tiny.local(), std::length_error);
+            } else {
+                EXPECT_NO_THROW(tiny.local());
+            }
+        }).join();
+        EXPECT_EQ(tiny.size(), main_index == 0 ? 0 : 1);
+    }
+#endif
+
+} // namespace
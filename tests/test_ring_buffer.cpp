@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <apus/ring_buffer.hpp>
 #include <numeric>
+#include "alloc_counter.hpp"
 
 namespace
 {
@@ -96,6 +97,21 @@ namespace
         EXPECT_EQ(*(it + 3), 4);
     }
 
+    TEST(RingBufferTest, TryAt)
+    {
+        apus::ring_buffer<int> rb(3);
+        for (int i = 0; i < 4; ++i) rb.push_back(i); // [1, 2, 3]
+
+        ASSERT_NE(rb.try_at(0), nullptr);
+        EXPECT_EQ(*rb.try_at(0), 1);
+        EXPECT_EQ(*rb.try_at(2), 3);
+        EXPECT_EQ(rb.try_at(3), nullptr);
+
+        const auto& crb = rb;
+        EXPECT_EQ(crb.try_at(1), &crb[1]);
+        EXPECT_EQ(crb.try_at(100), nullptr);
+    }
+
     TEST(RingBufferTest, Resize)
     {
         apus::ring_buffer<int> rb(2);
@@ -129,4 +145,30 @@ namespace
         EXPECT_EQ(rb[0], 2);
     }
 
+    TEST(RingBufferTest, TrySetCapacity)
+    {
+        apus::ring_buffer<int> rb(4);
+        for (int i = 0; i < 4; ++i) rb.push_back(i);
+
+        EXPECT_TRUE(rb.try_set_capacity(8));
+        EXPECT_EQ(rb.capacity(), 8);
+
+        // far more than any machine can provide: fails and leaves the buffer untouched
+        EXPECT_FALSE(rb.try_set_capacity(std::size_t(1) << 58));
+        EXPECT_EQ(rb.capacity(), 8);
+        EXPECT_EQ(rb.size(), 4);
+        EXPECT_EQ(rb[3], 3);
+    }
+
+    TEST(RingBufferTest, PushAndPopDoNotAllocate)
+    {
+        apus::ring_buffer<int> rb(16);
+        APUS_EXPECT_NO_ALLOC({
+            for (int i = 0; i < 100; ++i) rb.push_back(i); // overwrites once full
+            rb.pop_front();
+            rb.push_back(100);
+        });
+        EXPECT_EQ(rb.back(), 100);
+    }
+
 } // namespace
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <apus/shared_memory.hpp>
+#include <apus/shared_ring_buffer.hpp>
+#include <apus/shared_slot_map.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include "expect_error.hpp"
+
+namespace
+{
+
+    std::string unique_name(const char* what)
+    {
+        return "/apus-test-" + std::string(what) + "-" + std::to_string(::getpid());
+    }
+
+    struct message
+    {
+        std::uint64_t sequence;
+        double        payload[3];
+    };
+
+    struct node
+    {
+        int                    value;
+        apus::offset_ptr<node> next;
+    };
+
+    TEST(SharedMemoryTest, OffsetPtr)
+    {
+        apus::offset_ptr<int> null;
+        EXPECT_FALSE(null);
+        EXPECT_EQ(null.get(), nullptr);
+
+        int                   x = 42;
+        apus::offset_ptr<int> p = &x;
+        EXPECT_TRUE(p);
+        EXPECT_EQ(*p, 42);
+
+        // a copy at another address still points at the same target
+        apus::offset_ptr<int> copy = p;
+        EXPECT_EQ(copy.get(), &x);
+        EXPECT_EQ(copy, p);
+    }
+
+    TEST(SharedMemoryTest, CreateOpenAndFind)
+    {
+        std::string name = unique_name("region");
+        apus::shared_memory_region::remove(name);
+
+        auto creator = apus::shared_memory_region::create(name, 64 * 1024);
+        EXPECT_GE(creator.size(), 64 * 1024);
+        APUS_EXPECT_ERROR(apus::shared_memory_region::create(name, 4096), std::system_error);
+
+        node& first  = creator.construct<node>("first", node{1, nullptr});
+        node& second = creator.construct<node>("second", node{2, nullptr});
+        first.next   = &second;
+        APUS_EXPECT_ERROR(creator.construct<node>("first"), std::logic_error);
+
+        // a second mapping of the same object lands at a different address
+        auto attached = apus::shared_memory_region::open(name);
+        EXPECT_NE(attached.data(), creator.data());
+        EXPECT_EQ(attached.size(), creator.size());
+
+        node* head = attached.find<node>("first");
+        ASSERT_NE(head, nullptr);
+        EXPECT_NE(head, &first);
+        EXPECT_EQ(head->value, 1);
+        ASSERT_TRUE(head->next);
+        EXPECT_EQ(head->next->value, 2);
+        EXPECT_EQ(head->next.get(), attached.find<node>("second"));
+        EXPECT_EQ(attached.find<node>("missing"), nullptr);
+        EXPECT_EQ(attached.find<message>("first"), nullptr); // size mismatch
+
+        EXPECT_TRUE(apus::shared_memory_region::remove(name));
+        EXPECT_FALSE(apus::shared_memory_region::remove(name));
+        APUS_EXPECT_ERROR(apus::shared_memory_region::open(name), std::system_error);
+    }
+
+    TEST(SharedMemoryTest, FailedCreateReleasesTheName)
+    {
+        std::string name = unique_name("failed");
+        apus::shared_memory_region::remove(name);
+
+        // far more than any machine can map, so sizing or mapping the new object fails
+        APUS_EXPECT_ERROR(apus::shared_memory_region::create(name, std::size_t(1) << 62), std::system_error);
+        EXPECT_FALSE(apus::shared_memory_region::remove(name));
+
+        auto region = apus::shared_memory_region::create(name, 4096);
+        EXPECT_GE(region.size(), 4096);
+        EXPECT_TRUE(apus::shared_memory_region::remove(name));
+    }
+
+    TEST(SharedMemoryTest, AnonymousRegionAttachByDescriptor)
+    {
+        auto region = apus::shared_memory_region::create_anonymous(4096);
+        region.construct<int>("answer", 42);
+
+        auto attached = apus::shared_memory_region::attach(region.fd());
+        ASSERT_NE(attached.find<int>("answer"), nullptr);
+        EXPECT_EQ(*attached.find<int>("answer"), 42);
+
+        EXPECT_EQ(region.try_allocate(1 << 20), nullptr);
+        EXPECT_NE(region.try_allocate(64), nullptr);
+    }
+
+    TEST(SharedMemoryTest, RingBufferAcrossMappings)
+    {
+        auto region   = apus::shared_memory_region::create_anonymous(64 * 1024);
+        auto attached = apus::shared_memory_region::attach(region.fd());
+
+        using queue     = apus::shared_ring_buffer<message, 8>;
+        queue& sender   = region.construct<queue>("queue");
+        queue& receiver = *attached.find<queue>("queue");
+
+        EXPECT_TRUE(receiver.empty());
+        for (std::uint64_t i = 0; i < 8; ++i) EXPECT_TRUE(sender.try_push(message{i, {1.0, 2.0, 3.0}}));
+        EXPECT_FALSE(sender.try_push(message{8, {}}));
+        EXPECT_EQ(receiver.size(), 8);
+
+        const message* front = receiver.front();
+        ASSERT_NE(front, nullptr);
+        EXPECT_EQ(front->sequence, 0);
+        receiver.pop();
+
+        message m;
+        for (std::uint64_t i = 1; i < 8; ++i) {
+            ASSERT_TRUE(receiver.try_pop(m));
+            EXPECT_EQ(m.sequence, i);
+        }
+        EXPECT_FALSE(receiver.try_pop(m));
+        EXPECT_EQ(receiver.front(), nullptr);
+    }
+
+    TEST(SharedMemoryTest, RingBufferBetweenProcesses)
+    {
+        constexpr std::uint64_t count = 100000;
+        using queue                   = apus::shared_ring_buffer<std::uint64_t, 256>;
+
+        auto   region = apus::shared_memory_region::create_anonymous(64 * 1024);
+        queue& q      = region.construct<queue>("queue");
+
+        pid_t child = ::fork();
+        ASSERT_GE(child, 0);
+        if (child == 0) {
+            // the producer maps the region again, at its own address
+            auto   mapping = apus::shared_memory_region::attach(region.fd());
+            queue& out     = *mapping.find<queue>("queue");
+            for (std::uint64_t i = 0; i < count;) {
+                if (out.try_push(i)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            ::_exit(0);
+        }
+
+        std::uint64_t expected = 0;
+        std::uint64_t value;
+        while (expected < count) {
+            if (q.try_pop(value)) {
+                if (value != expected) break;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        EXPECT_EQ(expected, count);
+
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    TEST(SharedMemoryTest, SlotMapAddReadRemove)
+    {
+        auto region   = apus::shared_memory_region::create_anonymous(256 * 1024);
+        auto attached = apus::shared_memory_region::attach(region.fd());
+
+        using table         = apus::shared_slot_map<message, 16, 8>;
+        table&       writer = region.construct<table>("table", region);
+        const table& reader = *attached.find<table>("table");
+
+        std::vector<table::handle> handles;
+        for (std::uint64_t i = 0; i < 40; ++i) handles.push_back(writer.add(message{i, {double(i)}}));
+        EXPECT_EQ(reader.size(), 40);
+        EXPECT_EQ(reader.page_count(), 3);
+
+        message m;
+        ASSERT_TRUE(reader.read(handles[17], m));
+        EXPECT_EQ(m.sequence, 17);
+        EXPECT_EQ(reader.read(handles[39])->payload[0], 39.0);
+
+        EXPECT_TRUE(writer.update(handles[17], message{1017, {}}));
+        EXPECT_EQ(reader.read(handles[17])->sequence, 1017);
+
+        writer.remove(handles[17]);
+        EXPECT_FALSE(reader.contains(handles[17]));
+        EXPECT_FALSE(reader.read(handles[17], m));
+        EXPECT_FALSE(writer.try_remove(handles[17]));
+        EXPECT_FALSE(writer.update(handles[17], m));
+        APUS_EXPECT_ERROR(writer.remove(handles[17]), std::out_of_range);
+
+        // the freed slot is reused with a new version
+        table::handle reused = writer.add(message{2017, {}});
+        EXPECT_EQ(reused.index, handles[17].index);
+        EXPECT_NE(reused.version, handles[17].version);
+        EXPECT_EQ(reader.read(reused)->sequence, 2017);
+        EXPECT_FALSE(reader.read(handles[17]).has_value());
+        EXPECT_FALSE(reader.read(table::handle{1000, 6}).has_value());
+    }
+
+    TEST(SharedMemoryTest, SlotMapDirectoryExhaustion)
+    {
+        auto region = apus::shared_memory_region::create_anonymous(64 * 1024);
+
+        using table  = apus::shared_slot_map<int, 4, 2>;
+        table& small = region.construct<table>("table", region);
+        for (int i = 0; i < 8; ++i) EXPECT_TRUE(small.try_add(i).has_value());
+        EXPECT_FALSE(small.try_add(8).has_value());
+        EXPECT_EQ(small.size(), table::capacity());
+    }
+
+    TEST(SharedMemoryTest, SlotMapConcurrentReadersSeeConsistentValues)
+    {
+        auto region = apus::shared_memory_region::create_anonymous(64 * 1024);
+
+        using table = apus::shared_slot_map<message, 16, 4>;
+        table& map  = region.construct<table>("table", region);
+        auto   h    = map.add(message{0, {0.0, 0.0, 0.0}});
+
+        std::atomic<bool> done{false};
+        std::atomic<int>  torn{0};
+        std::thread       reader([&] {
+            message m;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (map.read(h, m) && (m.payload[0] != double(m.sequence) || m.payload[2] != double(m.sequence))) {
+                    torn.fetch_add(1);
+                }
+            }
+        });
+        for (std::uint64_t i = 1; i < 100000; ++i) {
+            double v = double(i);
+            map.update(h, message{i, {v, v, v}});
+        }
+        done = true;
+        reader.join();
+        EXPECT_EQ(torn.load(), 0);
+    }
+
+} // namespace
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <apus/slot_map.hpp>
+#include "alloc_counter.hpp"
+#include "expect_error.hpp"
 
 struct TestObject
 {
@@ -50,7 +52,7 @@ TEST(SlotMapTest, AddAndBasicAccess)
     EXPECT_EQ(sm.size(), 3);
 
     EXPECT_EQ(sm.find({100, 1}), nullptr); // Invalid handle (index out of bounds)
-    EXPECT_THROW(sm.at({100, 1}), std::out_of_range);
+    APUS_EXPECT_ERROR(sm.at({100, 1}), std::out_of_range);
 }
 
 TEST(SlotMapTest, RemoveAndReuse)
@@ -75,7 +77,7 @@ TEST(SlotMapTest, RemoveAndReuse)
 
     // h2 is now invalid
     EXPECT_EQ(sm.find(h2), nullptr);
-    EXPECT_THROW(sm.at(h2), std::out_of_range);
+    APUS_EXPECT_ERROR(sm.at(h2), std::out_of_range);
 
     // Add a new object, should reuse index 1
     auto h4 = sm.add(TestObject(40)); // index 1, version 2
@@ -86,13 +88,30 @@ TEST(SlotMapTest, RemoveAndReuse)
 
     // h2 (original handle) should still be invalid due to version mismatch
     EXPECT_EQ(sm.find(h2), nullptr);
-    EXPECT_THROW(sm.at(h2), std::out_of_range);
+    APUS_EXPECT_ERROR(sm.at(h2), std::out_of_range);
 
     // h1 and h3 should still be valid
     EXPECT_EQ(sm.find(h1)->value, 10);
     EXPECT_EQ(sm.find(h3)->value, 30);
 }
 
+TEST(SlotMapTest, TryRemove)
+{
+    apus::slot_map<TestObject, TestDeleter, apus::DEFAULT_SLOT_MAP_PAGE_SIZE> sm;
+
+    auto h1 = sm.add(TestObject(10));
+    auto h2 = sm.add(TestObject(20));
+
+    EXPECT_TRUE(sm.try_remove(h1));
+    EXPECT_FALSE(sm.try_remove(h1));
+    EXPECT_FALSE(sm.try_remove({100, 1}));
+    EXPECT_EQ(sm.size(), 1);
+    EXPECT_EQ(sm.find(h2)->value, 20);
+
+    APUS_EXPECT_ERROR(sm.remove(h1), std::out_of_range);
+    APUS_EXPECT_ERROR(sm.remove({100, 1}), std::out_of_range);
+}
+
 TEST(SlotMapTest, IterationOverActiveElements)
 {
     using sm_type = apus::slot_map<TestObject, TestDeleter, apus::DEFAULT_SLOT_MAP_PAGE_SIZE>;
@@ -193,3 +212,16 @@ TEST(SlotMapTest, MoveSupport)
     EXPECT_EQ(sm3.at(h), 42);
     EXPECT_EQ(sm2.size(), 0);
 }
+
+TEST(SlotMapTest, ReusingFreedSlotsDoesNotAllocate)
+{
+    apus::slot_map<int>                      sm;
+    std::vector<apus::slot_map<int>::handle> handles;
+    for (int i = 0; i < 100; ++i) handles.push_back(sm.add(i));
+    for (auto h : handles) sm.remove(h);
+
+    APUS_EXPECT_NO_ALLOC({
+        for (int i = 0; i < 100; ++i) handles[i] = sm.add(i);
+        for (int i = 0; i < 100; ++i) EXPECT_EQ(*sm.find(handles[i]), i);
+    });
+}
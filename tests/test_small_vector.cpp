@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <apus/small_vector.hpp>
 #include <string>
+#include "alloc_counter.hpp"
 
 namespace
 {
@@ -102,6 +103,33 @@ namespace
         EXPECT_EQ(v[0], 10);
     }
 
+    TEST(SmallVectorTest, TryReserve)
+    {
+        apus::small_vector<int, 4> v = {1, 2, 3};
+        EXPECT_TRUE(v.try_reserve(2));
+        EXPECT_TRUE(v.try_reserve(16));
+        EXPECT_GE(v.capacity(), 16);
+
+        // far more than any machine can provide: fails and leaves the vector untouched
+        EXPECT_FALSE(v.try_reserve(std::size_t(1) << 58));
+        EXPECT_GE(v.capacity(), 16);
+        EXPECT_EQ(v.size(), 3);
+        EXPECT_EQ(v[2], 3);
+    }
+
+    TEST(SmallVectorTest, TryAt)
+    {
+        apus::small_vector<int, 2> v = {1, 2, 3};
+        ASSERT_NE(v.try_at(2), nullptr);
+        EXPECT_EQ(*v.try_at(2), 3);
+        EXPECT_EQ(v.try_at(3), nullptr);
+
+        *v.try_at(0) = 10;
+        const auto& cv = v;
+        EXPECT_EQ(*cv.try_at(0), 10);
+        EXPECT_EQ(cv.try_at(3), nullptr);
+    }
+
     TEST(SmallVectorTest, Iterators)
     {
         apus::small_vector<int, 4> v;
@@ -225,4 +253,18 @@ namespace
         EXPECT_EQ(v.size(), 2);
     }
 
+    TEST(SmallVectorTest, NoAllocationWithinInlineCapacity)
+    {
+        apus::small_vector<int, 8> v;
+        APUS_EXPECT_NO_ALLOC({
+            for (int i = 0; i < 8; ++i) v.push_back(i);
+            v.pop_back();
+            v.emplace_back(7);
+        });
+
+        apus_testing::alloc_scope scope;
+        v.push_back(8); // spills
+        EXPECT_EQ(scope.allocations(), 1);
+    }
+
 } // namespace
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <apus/slot_map.hpp>
+#include <apus/sparse_set.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "expect_error.hpp"
+
+namespace
+{
+
+    struct Entity
+    {
+        int id;
+    };
+
+    struct Position
+    {
+        float x, y;
+    };
+
+    using handle = apus::slot_map<Entity>::handle;
+
+    TEST(SparseSetTest, InsertAndFind)
+    {
+        apus::slot_map<Entity>                entities;
+        apus::sparse_set<std::string, Entity> names;
+
+        auto h1 = entities.add({1});
+        auto h2 = entities.add({2});
+
+        names.insert(h1, "first");
+        EXPECT_EQ(names.size(), 1);
+        EXPECT_TRUE(names.contains(h1));
+        EXPECT_FALSE(names.contains(h2));
+        EXPECT_EQ(names.at(h1), "first");
+        EXPECT_EQ(names.find(h2), nullptr);
+        APUS_EXPECT_ERROR(names.at(h2), std::out_of_range);
+
+        names.emplace(h2, 3, 'x');
+        EXPECT_EQ(names[h2], "xxx");
+        EXPECT_EQ(names.size(), 2);
+    }
+
+    TEST(SparseSetTest, VersionCheck)
+    {
+        apus::slot_map<Entity>             entities;
+        apus::sparse_set<Position, Entity> positions;
+
+        auto h1 = entities.add({1});
+        positions.insert(h1, {1.0f, 2.0f});
+
+        // the index is reused by a new entity with a higher version
+        entities.remove(h1);
+        auto h2 = entities.add({2});
+        ASSERT_EQ(h1.index, h2.index);
+
+        EXPECT_TRUE(positions.contains(h1));
+        EXPECT_FALSE(positions.contains(h2));
+
+        // attaching to the new version replaces the stale value
+        positions.insert(h2, {3.0f, 4.0f});
+        EXPECT_EQ(positions.size(), 1);
+        EXPECT_FALSE(positions.contains(h1));
+        EXPECT_FLOAT_EQ(positions.at(h2).x, 3.0f);
+    }
+
+    TEST(SparseSetTest, RemoveKeepsDenseArrayPacked)
+    {
+        apus::slot_map<Entity>        entities;
+        apus::sparse_set<int, Entity> values;
+        std::vector<handle>           handles;
+
+        for (int i = 0; i < 10; ++i) {
+            handles.push_back(entities.add({i}));
+            values.insert(handles.back(), i);
+        }
+
+        EXPECT_TRUE(values.remove(handles[3]));
+        EXPECT_FALSE(values.remove(handles[3]));
+        EXPECT_TRUE(values.remove(handles[0]));
+        EXPECT_EQ(values.size(), 8);
+
+        for (int i = 0; i < 10; ++i) {
+            if (i == 0 || i == 3) {
+                EXPECT_FALSE(values.contains(handles[i]));
+            } else {
+                EXPECT_EQ(values.at(handles[i]), i);
+            }
+        }
+
+        // dense array and handle array stay in sync
+        for (std::size_t pos = 0; pos < values.size(); ++pos) {
+            EXPECT_EQ(values.data()[pos], values.at(values.handle_at(pos)));
+        }
+
+        int sum = 0;
+        for (int v : values) sum += v;
+        EXPECT_EQ(sum, 45 - 3);
+    }
+
+    TEST(SparseSetTest, SparseIndicesAcrossPages)
+    {
+        apus::sparse_set<int, Entity, 16> values;
+        values.insert(handle{1000, 1}, 1);
+        values.insert(handle{5, 1}, 2);
+
+        EXPECT_EQ(values.at(handle{1000, 1}), 1);
+        EXPECT_EQ(values.at(handle{5, 1}), 2);
+        EXPECT_FALSE(values.contains(handle{999, 1}));
+        EXPECT_FALSE(values.contains(handle{100000, 1}));
+
+        values.clear();
+        EXPECT_TRUE(values.empty());
+        EXPECT_FALSE(values.contains(handle{1000, 1}));
+    }
+
+    TEST(SparseSetTest, CopyAndMove)
+    {
+        apus::sparse_set<int, Entity> a;
+        a.insert(handle{1, 1}, 10);
+
+        apus::sparse_set<int, Entity> b = a;
+        b.insert(handle{2, 1}, 20);
+        EXPECT_EQ(a.size(), 1);
+        EXPECT_EQ(b.size(), 2);
+
+        apus::sparse_set<int, Entity> c = std::move(b);
+        EXPECT_EQ(c.at(handle{2, 1}), 20);
+    }
+
+    TEST(SparseSetTest, IntersectionIteratesSmallestSet)
+    {
+        apus::slot_map<Entity>             entities;
+        apus::sparse_set<Position, Entity> positions;
+        apus::sparse_set<int, Entity>      healths;
+        apus::sparse_set<char, Entity>     tags;
+
+        std::vector<handle> handles;
+        for (int i = 0; i < 100; ++i) {
+            handles.push_back(entities.add({i}));
+            positions.insert(handles.back(), {float(i), 0.0f});
+            if (i % 2 == 0) healths.insert(handles.back(), i);
+            if (i % 10 == 0) tags.insert(handles.back(), 't');
+        }
+
+        std::vector<int> visited;
+        apus::for_each_intersection(
+            [&](handle h, Position& p, int& health, char& tag) {
+                EXPECT_TRUE(tags.contains(h));
+                EXPECT_EQ(static_cast<int>(p.x), health);
+                EXPECT_EQ(tag, 't');
+                visited.push_back(health);
+                p.y = 1.0f;
+            },
+            positions, healths, tags);
+
+        std::sort(visited.begin(), visited.end());
+        EXPECT_EQ(visited, (std::vector<int>{0, 10, 20, 30, 40, 50, 60, 70, 80, 90}));
+        EXPECT_FLOAT_EQ(positions.at(handles[10]).y, 1.0f);
+        EXPECT_FLOAT_EQ(positions.at(handles[11]).y, 0.0f);
+    }
+
+} // namespace
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <apus/stats_registry.hpp>
+#include <apus/small_vector.hpp>
+#include <apus/ring_buffer.hpp>
+#include <apus/paged_memory_arena.hpp>
+#include <apus/typed_memory_arena.hpp>
+#include <algorithm>
+#include <string>
+
+namespace
+{
+
+    struct spill_tag
+    {
+        static constexpr const char* name = "test_spill";
+    };
+
+    struct ring_tag
+    {
+        static constexpr const char* name = "test_ring";
+    };
+
+    struct arena_tag
+    {
+        static constexpr const char* name = "test_arena";
+    };
+
+    struct aggregate_tag
+    {
+        static constexpr const char* name = "test_aggregate";
+    };
+
+    const apus::stats_record* find_record(const std::vector<apus::stats_record>& records, const std::string& name)
+    {
+        auto it = std::find_if(records.begin(), records.end(), [&](const auto& r) { return r.name == name; });
+        return it == records.end() ? nullptr : &*it;
+    }
+
+    TEST(StatsRegistryTest, NullStatsIsFree)
+    {
+        EXPECT_TRUE(std::is_empty_v<apus::null_stats>);
+        EXPECT_EQ(sizeof(apus::ring_buffer<int>), 5 * sizeof(std::size_t));
+        EXPECT_EQ(sizeof(apus::small_vector<int, 4>), 2 * sizeof(std::size_t) + sizeof(int*) + 4 * sizeof(int));
+    }
+
+    TEST(StatsRegistryTest, CountsSmallVectorSpills)
+    {
+        using vector_t = apus::small_vector<int, 4, apus::counting_stats<spill_tag>>;
+
+        vector_t vec;
+        for (int i = 0; i < 4; ++i) vec.push_back(i);
+        EXPECT_EQ(vec.stats().count(apus::stats_event::heap_spill), 0);
+
+        for (int i = 0; i < 16; ++i) vec.push_back(i);
+        EXPECT_EQ(vec.stats().count(apus::stats_event::heap_spill), 1);
+        EXPECT_EQ(vec.stats().count(apus::stats_event::reallocation), 3); // 4 -> 8 -> 16 -> 32
+        EXPECT_STREQ(vec.stats().name(), "test_spill");
+    }
+
+    TEST(StatsRegistryTest, CountsRingBufferOverwritesAndArenaEvents)
+    {
+        apus::ring_buffer<int, apus::counting_stats<ring_tag>> ring(4);
+        for (int i = 0; i < 10; ++i) ring.push_back(i);
+        EXPECT_EQ(ring.stats().count(apus::stats_event::overwrite), 6);
+
+        apus::paged_memory_arena<256, apus::counting_stats<arena_tag>> paged;
+        for (int i = 0; i < 16; ++i) paged.allocate(64);
+        EXPECT_GE(paged.stats().count(apus::stats_event::page_allocation), 4);
+
+        apus::typed_memory_arena<int, 8, apus::counting_stats<arena_tag>> typed;
+        for (int i = 0; i < 20; ++i) typed.allocate();
+        for (int i = 0; i < 5; ++i) typed.deallocate(i);
+        typed.allocate();
+        typed.deallocate(0);
+        EXPECT_EQ(typed.stats().count(apus::stats_event::page_allocation), 3);
+        EXPECT_EQ(typed.stats().high_water(apus::stats_level::free_list_depth), 5);
+    }
+
+    TEST(StatsRegistryTest, AggregatesLiveAndDestroyedInstances)
+    {
+        using vector_t = apus::small_vector<int, 2, apus::counting_stats<aggregate_tag>>;
+
+        vector_t kept;
+        kept.resize(3);
+        {
+            vector_t gone;
+            gone.resize(3);
+            vector_t copy = gone; // a copy is a new instance with its own counts
+            EXPECT_EQ(copy.stats().count(apus::stats_event::heap_spill), 1);
+        }
+
+        auto        records = apus::stats_registry::instance().snapshot();
+        const auto* record  = find_record(records, "test_aggregate");
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->instances, 3);
+        EXPECT_EQ(record->live_instances, 1);
+        EXPECT_EQ(record->events[static_cast<std::size_t>(apus::stats_event::heap_spill)], 3);
+
+        std::string json = apus::stats_registry::instance().to_json();
+        EXPECT_NE(json.find("\"name\": \"test_aggregate\", \"instances\": 3, \"live_instances\": 1, \"heap_spill\": 3"),
+                  std::string::npos);
+
+        std::string table = apus::stats_registry::instance().to_table();
+        EXPECT_NE(table.find("test_aggregate"), std::string::npos);
+        EXPECT_NE(table.find("free_list_depth_max"), std::string::npos);
+
+        apus::stats_registry::instance().reset();
+        records = apus::stats_registry::instance().snapshot();
+        record  = find_record(records, "test_aggregate");
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->instances, 1);
+        EXPECT_EQ(record->events[static_cast<std::size_t>(apus::stats_event::heap_spill)], 0);
+    }
+
+} // namespace
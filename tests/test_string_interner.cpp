@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <apus/string_interner.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "expect_error.hpp"
+
+namespace
+{
+
+    TEST(StringInternerTest, InternAssignsDenseIds)
+    {
+        apus::string_interner<> interner;
+        EXPECT_TRUE(interner.empty());
+
+        auto a = interner.intern("alpha");
+        auto b = interner.intern("beta");
+        auto c = interner.intern("alpha");
+
+        EXPECT_EQ(a, 0);
+        EXPECT_EQ(b, 1);
+        EXPECT_EQ(c, a);
+        EXPECT_EQ(interner.size(), 2);
+        EXPECT_EQ(interner[a], "alpha");
+        EXPECT_EQ(interner.at(b), "beta");
+        APUS_EXPECT_ERROR(interner.at(2), std::out_of_range);
+    }
+
+    TEST(StringInternerTest, FindDoesNotIntern)
+    {
+        apus::string_interner<> interner;
+        EXPECT_EQ(interner.find("missing"), interner.npos);
+
+        auto id = interner.intern("present");
+        EXPECT_EQ(interner.find("present"), id);
+        EXPECT_EQ(interner.find("missing"), interner.npos);
+        EXPECT_TRUE(interner.contains("present"));
+        EXPECT_FALSE(interner.contains("missing"));
+        EXPECT_EQ(interner.size(), 1);
+    }
+
+    TEST(StringInternerTest, ViewsAreStableAcrossGrowth)
+    {
+        apus::string_interner<256> interner;
+        auto                       first = interner.intern("first");
+        std::string_view           view  = interner[first];
+
+        for (int i = 0; i < 10000; ++i) {
+            interner.intern("name_" + std::to_string(i));
+        }
+
+        EXPECT_EQ(interner[first].data(), view.data());
+        EXPECT_EQ(view, "first");
+        for (int i = 0; i < 10000; ++i) {
+            ASSERT_EQ(interner[interner.find("name_" + std::to_string(i))], "name_" + std::to_string(i));
+        }
+    }
+
+    TEST(StringInternerTest, EmptyAndOversizedStrings)
+    {
+        apus::string_interner<16> interner;
+        std::string               big(100, 'x');
+
+        auto empty_id = interner.intern("");
+        auto big_id   = interner.intern(big);
+
+        EXPECT_EQ(interner[empty_id], "");
+        EXPECT_EQ(interner[big_id], big);
+        EXPECT_EQ(interner.intern(big), big_id);
+    }
+
+    TEST(StringInternerTest, BulkIntern)
+    {
+        apus::string_interner<>    interner;
+        std::vector<std::string>   names = {"a", "b", "a", "c"};
+        std::vector<std::uint32_t> ids;
+
+        interner.intern(names.begin(), names.end(), std::back_inserter(ids));
+        EXPECT_EQ(ids, (std::vector<std::uint32_t>{0, 1, 0, 2}));
+        EXPECT_EQ(interner.size(), 3);
+    }
+
+    TEST(StringInternerTest, FrozenIsReadOnly)
+    {
+        apus::string_interner<> interner;
+        for (int i = 0; i < 1000; ++i) {
+            interner.intern(std::to_string(i));
+        }
+        interner.freeze();
+        EXPECT_TRUE(interner.frozen());
+
+        EXPECT_EQ(interner.intern("42"), 42);
+        APUS_EXPECT_ERROR(interner.intern("unknown"), std::logic_error);
+        EXPECT_EQ(interner.try_intern("42"), 42);
+        EXPECT_EQ(interner.try_intern("unknown"), interner.npos);
+        EXPECT_EQ(interner.size(), 1000);
+
+        // concurrent readers need no synchronization once frozen
+        const auto&              frozen = interner;
+        std::vector<std::thread> readers;
+        std::vector<int>         mismatches(4, 0);
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&, t] {
+                for (int i = 0; i < 1000; ++i) {
+                    if (frozen[frozen.find(std::to_string(i))] != std::to_string(i)) {
+                        mismatches[t]++;
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        for (int m : mismatches) EXPECT_EQ(m, 0);
+    }
+
+} // namespace
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <apus/thread_pool.hpp>
+#include <atomic>
+#include <numeric>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+    TEST(ThreadPoolTest, SubmitRunsAllTasks)
+    {
+        std::atomic<int> counter{0};
+        {
+            apus::thread_pool pool(4);
+            EXPECT_EQ(pool.size(), 4);
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&] { counter.fetch_add(1); });
+            }
+        } // destructor drains the remaining tasks
+        EXPECT_EQ(counter.load(), 1000);
+    }
+
+    TEST(ThreadPoolTest, ParallelForCoversRangeOnce)
+    {
+        apus::thread_pool pool(4);
+        std::vector<int>  hits(10007, 0);
+        std::atomic<int>  max_chunk{0};
+
+        pool.parallel_for(0, hits.size(), 64, [&](std::size_t first, std::size_t last) {
+            int chunk = static_cast<int>(last - first);
+            int seen  = max_chunk.load();
+            while (chunk > seen && !max_chunk.compare_exchange_weak(seen, chunk)) {}
+            for (std::size_t i = first; i < last; ++i) hits[i]++;
+        });
+
+        for (int h : hits) ASSERT_EQ(h, 1);
+        EXPECT_LE(max_chunk.load(), 64);
+
+        // empty range is a no-op
+        pool.parallel_for(5, 5, 1, [&](std::size_t, std::size_t) { FAIL(); });
+    }
+
+    TEST(ThreadPoolTest, TaskGroupForkJoin)
+    {
+        apus::thread_pool pool(4);
+
+        // recursive fork/join from inside worker threads must not deadlock
+        std::function<long(int)> fib = [&](int n) -> long {
+            if (n < 2) return n;
+            long             a = 0, b = 0;
+            apus::task_group group(pool);
+            group.run([&] { a = fib(n - 1); });
+            b = fib(n - 2);
+            group.wait();
+            return a + b;
+        };
+
+        long result = 0;
+        apus::task_group group(pool);
+        group.run([&] { result = fib(20); });
+        group.wait();
+        EXPECT_EQ(result, 6765);
+    }
+
+#if APUS_EXCEPTIONS
+    TEST(ThreadPoolTest, ExceptionsPropagateToWait)
+    {
+        apus::thread_pool pool(2);
+
+        apus::task_group group(pool);
+        group.run([] { throw std::runtime_error("boom"); });
+        group.run([] {});
+        EXPECT_THROW(group.wait(), std::runtime_error);
+
+        EXPECT_THROW(pool.parallel_for(0, 100, 10,
+                         [](std::size_t first, std::size_t) { if (first >= 50) throw std::logic_error("chunk"); }),
+            std::logic_error);
+    }
+#endif
+
+    TEST(ThreadPoolTest, PerWorkerScratchArena)
+    {
+        apus::thread_pool pool(3);
+        EXPECT_EQ(pool.scratch_arena(), nullptr);
+        EXPECT_EQ(pool.current_worker_index(), pool.size());
+
+        std::vector<std::atomic<int>> per_worker(pool.size());
+        std::atomic<int>              failures{0};
+
+        apus::task_group group(pool);
+        for (int i = 0; i < 100; ++i) {
+            group.run([&] {
+                std::size_t index = pool.current_worker_index();
+                auto*       arena = pool.scratch_arena();
+                if (index >= pool.size() || arena == nullptr) {
+                    // the waiting (non-worker) thread may help run tasks
+                    return;
+                }
+                int* scratch = arena->allocate<int>(16);
+                if (!scratch) failures++;
+                std::iota(scratch, scratch + 16, 0);
+                if (scratch[15] != 15) failures++;
+                per_worker[index]++;
+            });
+        }
+        group.wait();
+        EXPECT_EQ(failures.load(), 0);
+    }
+
+} // namespace
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <apus/timer_wheel.hpp>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    TEST(TimerWheelTest, FiresAtExpiry)
+    {
+        apus::timer_wheel<int> wheel;
+        wheel.schedule(5, 1);
+        wheel.schedule(10, 2);
+        EXPECT_EQ(wheel.size(), 2);
+
+        std::vector<int> fired;
+        auto             collect = [&](int& v) { fired.push_back(v); };
+
+        EXPECT_EQ(wheel.advance(4, collect), 0);
+        EXPECT_TRUE(fired.empty());
+
+        EXPECT_EQ(wheel.advance(5, collect), 1);
+        EXPECT_EQ(fired, (std::vector<int>{1}));
+
+        EXPECT_EQ(wheel.advance(100, collect), 1);
+        EXPECT_EQ(fired, (std::vector<int>{1, 2}));
+        EXPECT_EQ(wheel.now(), 100);
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(TimerWheelTest, PastExpiryFiresOnNextTick)
+    {
+        apus::timer_wheel<int> wheel(50);
+        wheel.schedule(10, 7);
+
+        int fired = 0;
+        wheel.advance(50, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 0);
+        wheel.advance(51, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 1);
+    }
+
+    TEST(TimerWheelTest, CancelAndStaleHandles)
+    {
+        apus::timer_wheel<int> wheel;
+        auto                   a = wheel.schedule(100, 1);
+        auto                   b = wheel.schedule(200, 2);
+
+        EXPECT_TRUE(wheel.cancel(a));
+        EXPECT_FALSE(wheel.cancel(a));
+        EXPECT_EQ(wheel.find(a), nullptr);
+        ASSERT_NE(wheel.find(b), nullptr);
+        EXPECT_EQ(*wheel.find(b), 2);
+
+        // the node of a is reused, but its old handle stays invalid
+        auto c = wheel.schedule(300, 3);
+        EXPECT_EQ(c.index, a.index);
+        EXPECT_NE(c, a);
+        EXPECT_FALSE(wheel.cancel(a));
+
+        std::vector<int> fired;
+        wheel.advance(1000, [&](int& v) { fired.push_back(v); });
+        EXPECT_EQ(fired, (std::vector<int>{2, 3}));
+        EXPECT_FALSE(wheel.cancel(b));
+    }
+
+    TEST(TimerWheelTest, Reschedule)
+    {
+        apus::timer_wheel<int> wheel;
+        auto                   h = wheel.schedule(10, 1);
+        EXPECT_TRUE(wheel.reschedule(h, 100000));
+        EXPECT_EQ(wheel.expiry(h), 100000);
+
+        int fired = 0;
+        wheel.advance(99999, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 0);
+        wheel.advance(100000, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 1);
+    }
+
+    TEST(TimerWheelTest, MatchesReferenceAcrossLevels)
+    {
+        apus::timer_wheel<std::uint64_t, 64> wheel;
+        std::multimap<std::uint64_t, std::uint64_t> reference;
+        std::mt19937_64                            rng(7);
+
+        for (std::uint64_t id = 0; id < 5000; ++id) {
+            // spread deadlines over several levels of the wheel
+            std::uint64_t expiry = rng() % (std::uint64_t(1) << (6 * (1 + id % 5)));
+            wheel.schedule(expiry, expiry);
+            reference.emplace(expiry, id);
+        }
+
+        std::uint64_t now = 0;
+        while (!reference.empty()) {
+            now += 1 + rng() % 5000;
+            std::size_t expected = 0;
+            while (!reference.empty() && reference.begin()->first <= now) {
+                reference.erase(reference.begin());
+                ++expected;
+            }
+
+            std::size_t fired = wheel.advance(now, [&](std::uint64_t& expiry) {
+                // never late past the advanced-to tick, never early
+                EXPECT_LE(expiry, now);
+            });
+            ASSERT_EQ(fired, expected) << "at tick " << now;
+        }
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(TimerWheelTest, FiresOnExactTickAfterCascade)
+    {
+        apus::timer_wheel<std::uint64_t> wheel;
+        std::vector<std::uint64_t>       expiries = {63, 64, 65, 4095, 4096, 4097, 262143, 262145, 1 << 20};
+        for (auto e : expiries) {
+            wheel.schedule(e, e);
+        }
+
+        for (auto e : expiries) {
+            std::vector<std::uint64_t> fired;
+            wheel.advance(e - 1, [&](std::uint64_t& v) { fired.push_back(v); });
+            EXPECT_TRUE(fired.empty()) << e;
+            wheel.advance(e, [&](std::uint64_t& v) { fired.push_back(v); });
+            EXPECT_EQ(fired, (std::vector<std::uint64_t>{e}));
+        }
+    }
+
+    TEST(TimerWheelTest, FarFutureOverflow)
+    {
+        apus::timer_wheel<int> wheel;
+        std::uint64_t          far = (std::uint64_t(1) << 50) + 12345;
+        wheel.schedule(far, 1);
+
+        int fired = 0;
+        wheel.advance(far - 1, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 0);
+        wheel.advance(far, [&](int&) { ++fired; });
+        EXPECT_EQ(fired, 1);
+    }
+
+    TEST(TimerWheelTest, CallbacksMayScheduleAndCancel)
+    {
+        apus::timer_wheel<int> wheel;
+        std::vector<apus::timer_handle> handles;
+        for (int i = 0; i < 4; ++i) {
+            handles.push_back(wheel.schedule(10, i));
+        }
+
+        std::vector<int> fired;
+        wheel.advance(10, [&](int& v) {
+            fired.push_back(v);
+            // the first callback cancels every other timer of the same batch
+            for (auto h : handles) wheel.cancel(h);
+            wheel.schedule(wheel.now() + 5, 100 + v);
+        });
+        EXPECT_EQ(fired.size(), 1);
+        EXPECT_EQ(wheel.size(), 1);
+
+        wheel.advance(15, [&](int& v) { fired.push_back(v); });
+        EXPECT_EQ(fired.size(), 2);
+        EXPECT_EQ(fired.back(), 100 + fired.front());
+    }
+
+    TEST(TimerWheelTest, DestroysPayloads)
+    {
+        auto token = std::make_shared<int>(0);
+        {
+            apus::timer_wheel<std::shared_ptr<int>> wheel;
+            auto                                    h = wheel.schedule(5, token);
+            wheel.schedule(10, token);
+            wheel.schedule(20, token);
+            EXPECT_EQ(token.use_count(), 4);
+
+            wheel.cancel(h);
+            EXPECT_EQ(token.use_count(), 3);
+            wheel.advance(10, [](std::shared_ptr<int>&) {});
+            EXPECT_EQ(token.use_count(), 2);
+        }
+        EXPECT_EQ(token.use_count(), 1);
+    }
+
+} // namespace
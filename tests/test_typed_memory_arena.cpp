@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <apus/typed_memory_arena.hpp>
+#include "alloc_counter.hpp"
 
 TEST(TypedMemoryArenaTest, BasicAllocationAndDeallocation)
 {
@@ -98,3 +99,31 @@ TEST(TypedMemoryArenaTest, ObjectLifecycle)
     // but MyObject's destructor is not automatically called by memory_arena.
     EXPECT_FALSE(destructed2); // Still false as memory_arena does not call destructors
 }
+
+TEST(TypedMemoryArenaTest, ReusingFreedSlotsDoesNotAllocate)
+{
+    apus::typed_memory_arena<int, 4> arena;
+    std::size_t                      indices[8];
+    for (auto& index : indices) index = arena.allocate().index;
+    for (auto index : indices) arena.deallocate(index);
+
+    APUS_EXPECT_NO_ALLOC({
+        for (int i = 0; i < 8; ++i) EXPECT_NE(arena.allocate().ptr, nullptr);
+    });
+    EXPECT_EQ(arena.size(), 8);
+}
+
+TEST(TypedMemoryArenaTest, TryAt)
+{
+    apus::typed_memory_arena<int, 2> arena;
+    for (int i = 0; i < 3; ++i) *arena.allocate().ptr = i;
+
+    ASSERT_NE(arena.try_at(2), nullptr);
+    EXPECT_EQ(*arena.try_at(2), 2);
+    EXPECT_EQ(arena.try_at(2), arena.get_address(2));
+    EXPECT_EQ(arena.try_at(3), nullptr);
+
+    const auto& carena = arena;
+    EXPECT_EQ(*carena.try_at(0), 0);
+    EXPECT_EQ(carena.try_at(3), nullptr);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <apus/work_stealing_deque.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    TEST(WorkStealingDequeTest, OwnerIsLifo)
+    {
+        apus::work_stealing_deque<int> deque(4);
+        EXPECT_TRUE(deque.empty());
+
+        deque.push(1);
+        deque.push(2);
+        deque.push(3);
+        EXPECT_EQ(deque.size(), 3);
+
+        int value = 0;
+        EXPECT_TRUE(deque.pop(value));
+        EXPECT_EQ(value, 3);
+        EXPECT_TRUE(deque.pop(value));
+        EXPECT_EQ(value, 2);
+        EXPECT_TRUE(deque.pop(value));
+        EXPECT_EQ(value, 1);
+        EXPECT_FALSE(deque.pop(value));
+        EXPECT_TRUE(deque.empty());
+    }
+
+    TEST(WorkStealingDequeTest, ThiefIsFifo)
+    {
+        apus::work_stealing_deque<int> deque(4);
+        deque.push(1);
+        deque.push(2);
+        deque.push(3);
+
+        int value = 0;
+        EXPECT_TRUE(deque.steal(value));
+        EXPECT_EQ(value, 1);
+        EXPECT_TRUE(deque.pop(value));
+        EXPECT_EQ(value, 3);
+        EXPECT_TRUE(deque.steal(value));
+        EXPECT_EQ(value, 2);
+        EXPECT_FALSE(deque.steal(value));
+    }
+
+    TEST(WorkStealingDequeTest, GrowsWhenFull)
+    {
+        apus::work_stealing_deque<int> deque(2);
+        for (int i = 0; i < 100; ++i) {
+            deque.push(i);
+        }
+        EXPECT_GE(deque.capacity(), 100);
+        EXPECT_EQ(deque.size(), 100);
+
+        int value = 0;
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(deque.steal(value));
+            EXPECT_EQ(value, i);
+        }
+        for (int i = 99; i >= 50; --i) {
+            ASSERT_TRUE(deque.pop(value));
+            EXPECT_EQ(value, i);
+        }
+    }
+
+    TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachElementOnce)
+    {
+        constexpr int                  count = 100000;
+        apus::work_stealing_deque<int> deque(16);
+        std::vector<std::atomic<int>>  taken(count);
+        std::atomic<bool>              done{false};
+
+        std::vector<std::thread> thieves;
+        for (int t = 0; t < 3; ++t) {
+            thieves.emplace_back([&] {
+                int value = 0;
+                while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                    if (deque.steal(value)) taken[value].fetch_add(1);
+                }
+            });
+        }
+
+        // the owner interleaves pushes and pops while thieves steal
+        int value = 0;
+        for (int i = 0; i < count; ++i) {
+            deque.push(i);
+            if (i % 3 == 0 && deque.pop(value)) taken[value].fetch_add(1);
+        }
+        while (deque.pop(value)) taken[value].fetch_add(1);
+        done.store(true, std::memory_order_release);
+        for (auto& thief : thieves) thief.join();
+
+        for (int i = 0; i < count; ++i) {
+            ASSERT_EQ(taken[i].load(), 1) << "element " << i;
+        }
+    }
+
+} // namespace